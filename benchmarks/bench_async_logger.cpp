@@ -0,0 +1,288 @@
+// End-to-end benchmarks for AsyncLogger::log
+
+#include "bench_common.h"
+#include "speckit/log/async_logger.h"
+#include "speckit/log/sharded_logger.h"
+#include <chrono>
+#include <memory>
+#include <string>
+
+namespace {
+
+// Same tag as bench_cbridge.cpp so the C and C++ paths format identical lines
+const std::string kTag = "Benchmark";
+
+std::unique_ptr<bench::ScratchDir> g_dir;
+std::unique_ptr<AsyncLogger> g_logger;
+std::unique_ptr<ShardedLogger> g_sharded;
+
+void createLogger(const benchmark::State&) {
+    g_dir = std::make_unique<bench::ScratchDir>("async_logger");
+    g_logger = AsyncLogger::create(g_dir->file("e2e"), 1 << 16);
+}
+
+void destroyLogger(const benchmark::State&) {
+    g_logger.reset();  // Joins the writer after draining
+    g_dir.reset();
+}
+
+void BM_AsyncLogger_Log(benchmark::State& state) {
+    if (!g_logger) {
+        state.SkipWithError("AsyncLogger::create failed");
+        return;
+    }
+    const std::string& message = bench::messageStringOfSize(static_cast<size_t>(state.range(0)));
+    for (auto _ : state) {
+        g_logger->log(LogLevel::kLogLevelInfo, kTag, message);
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_AsyncLogger_Log)
+    ->Setup(createLogger)
+    ->Teardown(destroyLogger)
+    ->RangeMultiplier(16)
+    ->Range(bench::kMinMessageSize, bench::kMaxMessageSize)
+    ->ThreadRange(1, bench::kMaxThreads)
+    ->UseRealTime();
+
+// Writer wait strategies at a fixed 64-byte payload. Besides throughput this reports
+// process-wide context switches per entry and CPU cores used (writer included).
+void BM_AsyncLogger_WaitStrategy(benchmark::State& state) {
+    if (!g_logger) {
+        state.SkipWithError("AsyncLogger::create failed");
+        return;
+    }
+    if (state.thread_index() == 0) {
+        g_logger->setWaitStrategy(static_cast<WaitStrategy>(state.range(0)));
+    }
+    const std::string& message = bench::messageStringOfSize(64);
+
+    bench::ResourceUsage start;
+    auto wall_start = std::chrono::steady_clock::now();
+    if (state.thread_index() == 0) {
+        start = bench::ResourceUsage::now();
+    }
+    for (auto _ : state) {
+        g_logger->log(LogLevel::kLogLevelInfo, kTag, message);
+    }
+    state.SetItemsProcessed(state.iterations());
+
+    if (state.thread_index() == 0) {
+        const auto end = bench::ResourceUsage::now();
+        const double wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - wall_start).count();
+        state.counters["ctx_switches"] = benchmark::Counter(
+            static_cast<double>(end.context_switches - start.context_switches),
+            benchmark::Counter::kAvgIterations);
+        state.counters["cpu_cores"] = benchmark::Counter(wall > 0 ? (end.cpu_seconds - start.cpu_seconds) / wall : 0.0);
+    }
+}
+BENCHMARK(BM_AsyncLogger_WaitStrategy)
+    ->Setup(createLogger)
+    ->Teardown(destroyLogger)
+    ->ArgName("strategy")
+    ->DenseRange(static_cast<int>(WaitStrategy::kBusySpin), static_cast<int>(WaitStrategy::kTimedPark))
+    ->ThreadRange(1, bench::kMaxThreads)
+    ->UseRealTime();
+
+void BM_AsyncLogger_FilteredOut(benchmark::State& state) {
+    if (!g_logger) {
+        state.SkipWithError("AsyncLogger::create failed");
+        return;
+    }
+    g_logger->setLogLevel(LogLevel::kLogLevelWarning);
+    const std::string& message = bench::messageStringOfSize(64);
+    for (auto _ : state) {
+        g_logger->log(LogLevel::kLogLevelDebug, kTag, message);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_AsyncLogger_FilteredOut)->Setup(createLogger)->Teardown(destroyLogger);
+
+// A filtered-out debug dump: /0 builds the string and passes it, /1 passes a callable
+void BM_AsyncLogger_FilteredDump(benchmark::State& state) {
+    if (!g_logger) {
+        state.SkipWithError("AsyncLogger::create failed");
+        return;
+    }
+    g_logger->setLogLevel(LogLevel::kLogLevelWarning);
+    const std::string& payload = bench::messageStringOfSize(1024);
+    auto dump = [&]() {
+        std::string out = "state=";
+        out += payload;
+        return out;
+    };
+    for (auto _ : state) {
+        if (state.range(0) == 0) {
+            g_logger->log(LogLevel::kLogLevelDebug, kTag, dump());
+        } else {
+            g_logger->log(LogLevel::kLogLevelDebug, kTag, dump);
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_AsyncLogger_FilteredDump)->Setup(createLogger)->Teardown(destroyLogger)->ArgName("lazy")->Arg(0)->Arg(1);
+
+void createRecorderLogger(const benchmark::State&) {
+    g_dir = std::make_unique<bench::ScratchDir>("flight_recorder");
+    g_logger = AsyncLogger::create(g_dir->file("e2e"), 1 << 16);
+    FlightRecorderOptions options;
+    options.dump_on_level = false;
+    if (g_logger && !g_logger->enableFlightRecorder(options)) {
+        g_logger.reset();
+    }
+}
+
+// Debug lines below the level going into the flight recorder instead of nowhere
+// (compare BM_AsyncLogger_FilteredOut). The ring wraps many times, so this includes eviction.
+void BM_AsyncLogger_FlightRecorder(benchmark::State& state) {
+    if (!g_logger) {
+        state.SkipWithError("AsyncLogger::create failed");
+        return;
+    }
+    g_logger->setLogLevel(LogLevel::kLogLevelWarning);
+    const std::string& message = bench::messageStringOfSize(64);
+    for (auto _ : state) {
+        g_logger->log(LogLevel::kLogLevelDebug, kTag, message);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_AsyncLogger_FlightRecorder)
+    ->Setup(createRecorderLogger)
+    ->Teardown(destroyLogger)
+    ->ThreadRange(1, bench::kMaxThreads)
+    ->UseRealTime();
+
+void createPipelineLogger(const benchmark::State& state) {
+    g_dir = std::make_unique<bench::ScratchDir>("format_pipeline");
+    g_logger = AsyncLogger::create(g_dir->file("e2e"), 1 << 16, static_cast<size_t>(state.range(0)));
+}
+
+// Sustained throughput with 0 (single writer thread) to N parallel formatter threads.
+// Each iteration logs and the loop ends with a flush, so items/s counts entries that
+// reached the file rather than entries queued.
+void BM_AsyncLogger_FormatterThreads(benchmark::State& state) {
+    if (!g_logger) {
+        state.SkipWithError("AsyncLogger::create failed");
+        return;
+    }
+    const std::string& message = bench::messageStringOfSize(256);
+    for (auto _ : state) {
+        g_logger->log(LogLevel::kLogLevelInfo, kTag, message);
+    }
+    g_logger->flush();
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(message.size()));
+}
+BENCHMARK(BM_AsyncLogger_FormatterThreads)
+    ->Setup(createPipelineLogger)
+    ->Teardown(destroyLogger)
+    ->ArgName("formatters")
+    ->Arg(0)->Arg(1)->Arg(2)->Arg(4)->Arg(8)
+    ->ThreadRange(1, 8)
+    ->UseRealTime();
+
+void createSinkLogger(const benchmark::State& state) {
+    g_dir = std::make_unique<bench::ScratchDir>("sinks");
+    g_logger = AsyncLogger::create(g_dir->file("e2e"), 1 << 16);
+    for (int64_t i = 0; i < state.range(0); ++i) {
+        g_logger->addSink(std::make_shared<MemoryRingSink>(1 << 20));
+    }
+}
+
+// Sustained throughput with 0 to N in-memory sinks next to the file. Batches are
+// formatted once and shared, so each extra sink should cost its own thread's time,
+// not the writer's. Ends with a flush, which also waits for the sinks.
+void BM_AsyncLogger_Sinks(benchmark::State& state) {
+    if (!g_logger) {
+        state.SkipWithError("AsyncLogger::create failed");
+        return;
+    }
+    const std::string& message = bench::messageStringOfSize(256);
+    for (auto _ : state) {
+        g_logger->log(LogLevel::kLogLevelInfo, kTag, message);
+    }
+    g_logger->flush();
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_AsyncLogger_Sinks)
+    ->Setup(createSinkLogger)
+    ->Teardown(destroyLogger)
+    ->ArgName("sinks")
+    ->Arg(0)->Arg(1)->Arg(4)
+    ->UseRealTime();
+
+void createRoutedLogger(const benchmark::State& state) {
+    g_dir = std::make_unique<bench::ScratchDir>("routes");
+    g_logger = AsyncLogger::create(g_dir->file("e2e"), 1 << 16);
+    if (g_logger && state.range(0) > 0) {
+        RouteTarget audit;
+        audit.name = "audit";
+        audit.tags = {"Audit", "Security"};
+        RouteTarget errors;
+        errors.name = "error";
+        errors.min_level = LogLevel::kLogLevelError;
+        if (!g_logger->setRoutes({audit, errors})) {
+            g_logger.reset();
+        }
+    }
+}
+
+// Sustained throughput without (/0) and with (/1) an audit and an error route. One
+// line in 8 is an Audit line and one in 64 an ERROR, so most entries only pay for the
+// route lookup. Ends with a flush.
+void BM_AsyncLogger_Routes(benchmark::State& state) {
+    if (!g_logger) {
+        state.SkipWithError("AsyncLogger::create failed");
+        return;
+    }
+    const std::string& message = bench::messageStringOfSize(256);
+    uint64_t i = 0;
+    for (auto _ : state) {
+        const LogLevel level = (i % 64 == 0) ? LogLevel::kLogLevelError : LogLevel::kLogLevelInfo;
+        g_logger->log(level, (i % 8 == 0) ? std::string_view("Audit") : std::string_view(kTag), message);
+        ++i;
+    }
+    g_logger->flush();
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_AsyncLogger_Routes)
+    ->Setup(createRoutedLogger)
+    ->Teardown(destroyLogger)
+    ->ArgName("routes")
+    ->Arg(0)->Arg(1)
+    ->UseRealTime();
+
+void createShardedLogger(const benchmark::State& state) {
+    g_dir = std::make_unique<bench::ScratchDir>("sharded_logger");
+    g_sharded = ShardedLogger::create(g_dir->file("e2e"), static_cast<size_t>(state.range(0)), 1 << 16);
+}
+
+void destroyShardedLogger(const benchmark::State&) {
+    g_sharded.reset();
+    g_dir.reset();
+}
+
+// Sharded multi-writer mode at a fixed 64-byte payload; items/s should grow with
+// the shard count once producers outrun a single writer
+void BM_ShardedLogger_Log(benchmark::State& state) {
+    if (!g_sharded) {
+        state.SkipWithError("ShardedLogger::create failed");
+        return;
+    }
+    const std::string& message = bench::messageStringOfSize(64);
+    for (auto _ : state) {
+        g_sharded->log(LogLevel::kLogLevelInfo, kTag, message);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ShardedLogger_Log)
+    ->Setup(createShardedLogger)
+    ->Teardown(destroyShardedLogger)
+    ->ArgName("shards")
+    ->RangeMultiplier(2)
+    ->Range(1, 16)
+    ->ThreadRange(1, bench::kMaxThreads)
+    ->UseRealTime();
+
+}  // namespace
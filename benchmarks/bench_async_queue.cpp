@@ -0,0 +1,211 @@
+// Benchmarks for AsyncQueue, TunedAsyncQueue, ByteRingQueue and RingBuffer
+
+#include "bench_common.h"
+#include "speckit/log/async_queue.h"
+#include "speckit/log/tuned_async_queue.h"
+#include "speckit/log/byte_ring_queue.h"
+#include "speckit/log/log_buffer.h"
+#include "speckit/log/payload_arena.h"
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <type_traits>
+
+namespace {
+
+constexpr size_t kQueueCapacity = 1 << 16;
+
+// Same memory as TunedAsyncQueue(kQueueCapacity): one 128-byte cell per entry
+constexpr size_t kByteRingBudget = kQueueCapacity * 128;
+
+/// Consume everything currently queued; returns the number of entries
+template <typename Queue>
+size_t consumeAll(Queue& queue) {
+    if constexpr (std::is_same_v<Queue, ByteRingQueue>) {
+        return queue.drainEntries([](const LogEntry& entry) { benchmark::DoNotOptimize(entry.message.data()); });
+    } else {
+        auto entries = queue.popAll();
+        benchmark::DoNotOptimize(entries.data());
+        return entries.size();
+    }
+}
+
+// Shared queue drained by a background consumer while producer threads run.
+// One instance per queue type so all queues are measured identically.
+template <typename Queue>
+struct ConsumerFixture {
+    static inline std::unique_ptr<Queue> queue;
+    static inline std::atomic<bool> stop{false};
+    static inline std::thread consumer;
+
+    static void start(const benchmark::State&) {
+        queue = std::make_unique<Queue>(std::is_same_v<Queue, ByteRingQueue> ? kByteRingBudget : kQueueCapacity);
+        stop.store(false);
+        consumer = std::thread([]() {
+            while (!stop.load(std::memory_order_relaxed)) {
+                if (consumeAll(*queue) == 0) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    static void finish(const benchmark::State&) {
+        stop.store(true);
+        consumer.join();
+        consumeAll(*queue);
+        queue.reset();
+    }
+};
+
+template <typename Queue>
+void runTryPush(benchmark::State& state) {
+    const auto message = bench::messageOfSize(64);
+    int64_t rejected = 0;
+    for (auto _ : state) {
+        auto entry = bench::makeEntry(message);
+        if (!ConsumerFixture<Queue>::queue->tryPush(entry)) {
+            ++rejected;
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.counters["rejected"] = benchmark::Counter(static_cast<double>(rejected));
+}
+
+template <typename Queue>
+void runPopAll(benchmark::State& state) {
+    const size_t batch = static_cast<size_t>(state.range(0));
+    const auto message = bench::messageOfSize(64);
+    Queue queue(batch);
+    for (auto _ : state) {
+        state.PauseTiming();
+        for (size_t i = 0; i < batch; ++i) {
+            queue.tryPush(bench::makeEntry(message));
+        }
+        state.ResumeTiming();
+
+        auto entries = queue.popAll();
+        benchmark::DoNotOptimize(entries.data());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(batch));
+}
+
+void BM_AsyncQueue_TryPush(benchmark::State& state) {
+    runTryPush<AsyncQueue>(state);
+}
+BENCHMARK(BM_AsyncQueue_TryPush)
+    ->Setup(ConsumerFixture<AsyncQueue>::start)
+    ->Teardown(ConsumerFixture<AsyncQueue>::finish)
+    ->ThreadRange(1, bench::kMaxThreads)
+    ->UseRealTime();
+
+// Power-of-two mask, padded cells and a CAS on tail_; compare with BM_AsyncQueue_TryPush
+void BM_TunedAsyncQueue_TryPush(benchmark::State& state) {
+    runTryPush<TunedAsyncQueue>(state);
+}
+BENCHMARK(BM_TunedAsyncQueue_TryPush)
+    ->Setup(ConsumerFixture<TunedAsyncQueue>::start)
+    ->Teardown(ConsumerFixture<TunedAsyncQueue>::finish)
+    ->ThreadRange(1, bench::kMaxThreads)
+    ->UseRealTime();
+
+// Producer cost when each entry must own its payload (as AsyncLogger::log requires):
+// a PayloadArena slab (or, with a zero arena budget, a heap allocation) per entry for
+// the slot queue, an inline copy for the byte ring. The consumer releases payloads.
+// Second arg: arena budget in MiB; 0 measures the plain heap path.
+void BM_TunedAsyncQueue_TryPushOwned(benchmark::State& state) {
+    const auto message = bench::messageOfSize(static_cast<size_t>(state.range(0)));
+    PayloadArena& arena = PayloadArena::global();
+    if (state.thread_index() == 0) {
+        arena.setMemoryBudget(static_cast<size_t>(state.range(1)) * 1024 * 1024);
+    }
+    const uint64_t failures_before = arena.getStats().allocation_failures;
+    int64_t rejected = 0;
+    for (auto _ : state) {
+        auto entry = LogEntry::createOwned(LogLevel::kLogLevelInfo, 1700000000123, static_cast<ProcessIdType>(4242),
+                                           ThreadIdType{}, "Benchmark", message);
+        if (!ConsumerFixture<TunedAsyncQueue>::queue->tryPush(entry)) {
+            ++rejected;
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.counters["rejected"] = benchmark::Counter(static_cast<double>(rejected));
+    if (state.thread_index() == 0) {
+        const PayloadArenaStats stats = arena.getStats();
+        state.counters["chunks_in_use"] = static_cast<double>(stats.chunks_in_use);
+        state.counters["alloc_failures"] = static_cast<double>(stats.allocation_failures - failures_before);
+    }
+}
+BENCHMARK(BM_TunedAsyncQueue_TryPushOwned)
+    ->Setup(ConsumerFixture<TunedAsyncQueue>::start)
+    ->Teardown(ConsumerFixture<TunedAsyncQueue>::finish)
+    ->ArgsProduct({{64, 1024}, {0, 16}})
+    ->ThreadRange(1, bench::kMaxThreads)
+    ->UseRealTime();
+
+void BM_ByteRingQueue_TryPushEntry(benchmark::State& state) {
+    const auto message = bench::messageOfSize(static_cast<size_t>(state.range(0)));
+    int64_t rejected = 0;
+    for (auto _ : state) {
+        if (!ConsumerFixture<ByteRingQueue>::queue->tryPushEntry(bench::makeEntry(message))) {
+            ++rejected;
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.counters["rejected"] = benchmark::Counter(static_cast<double>(rejected));
+}
+BENCHMARK(BM_ByteRingQueue_TryPushEntry)
+    ->Setup(ConsumerFixture<ByteRingQueue>::start)
+    ->Teardown(ConsumerFixture<ByteRingQueue>::finish)
+    ->Arg(64)
+    ->Arg(1024)
+    ->ThreadRange(1, bench::kMaxThreads)
+    ->UseRealTime();
+
+void BM_AsyncQueue_PopAll(benchmark::State& state) {
+    runPopAll<AsyncQueue>(state);
+}
+BENCHMARK(BM_AsyncQueue_PopAll)->RangeMultiplier(8)->Range(64, 8192);
+
+void BM_TunedAsyncQueue_PopAll(benchmark::State& state) {
+    runPopAll<TunedAsyncQueue>(state);
+}
+BENCHMARK(BM_TunedAsyncQueue_PopAll)->RangeMultiplier(8)->Range(64, 8192);
+
+void BM_RingBuffer_TryPush(benchmark::State& state) {
+    const size_t capacity = 1024;
+    const auto message = bench::messageOfSize(64);
+    RingBuffer ring(capacity);
+    size_t pushed = 0;
+    for (auto _ : state) {
+        if (++pushed == capacity) {
+            state.PauseTiming();
+            ring.popAll();
+            pushed = 0;
+            state.ResumeTiming();
+        }
+        benchmark::DoNotOptimize(ring.tryPush(bench::makeEntry(message)));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_RingBuffer_TryPush);
+
+void BM_RingBuffer_PopAll(benchmark::State& state) {
+    const size_t batch = static_cast<size_t>(state.range(0));
+    const auto message = bench::messageOfSize(64);
+    RingBuffer ring(batch);
+    for (auto _ : state) {
+        state.PauseTiming();
+        for (size_t i = 0; i < batch; ++i) {
+            ring.tryPush(bench::makeEntry(message));
+        }
+        state.ResumeTiming();
+
+        auto entries = ring.popAll();
+        benchmark::DoNotOptimize(entries.data());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(batch));
+}
+BENCHMARK(BM_RingBuffer_PopAll)->RangeMultiplier(8)->Range(64, 8192);
+
+}  // namespace
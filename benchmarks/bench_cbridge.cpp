@@ -0,0 +1,127 @@
+// C bridge vs C++ throughput: same payloads and thread sweep as bench_async_logger.cpp
+
+#include "bench_common.h"
+#include "speckit_logger.h"
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <string>
+
+namespace {
+
+constexpr char kTag[] = "Benchmark";
+
+std::unique_ptr<bench::ScratchDir> g_dir;
+SpeckitLogger* g_logger = nullptr;
+
+void createLogger(const benchmark::State&) {
+    g_dir = std::make_unique<bench::ScratchDir>("cbridge");
+    g_logger = speckit_logger_create(g_dir->file("cbridge").c_str());
+}
+
+void destroyLogger(const benchmark::State&) {
+    speckit_logger_destroy(g_logger);  // Drains the queue and joins the writer
+    g_logger = nullptr;
+    g_dir.reset();
+}
+
+// NUL-terminated entry point: pays strlen for tag and message on every call
+void BM_CBridge_Log(benchmark::State& state) {
+    if (!g_logger) {
+        state.SkipWithError("speckit_logger_create failed");
+        return;
+    }
+    const std::string& message = bench::messageStringOfSize(static_cast<size_t>(state.range(0)));
+    for (auto _ : state) {
+        speckit_logger_log(g_logger, SPECKIT_LOG_LEVEL_INFO, kTag, message.c_str());
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_CBridge_Log)
+    ->Setup(createLogger)
+    ->Teardown(destroyLogger)
+    ->RangeMultiplier(16)
+    ->Range(bench::kMinMessageSize, bench::kMaxMessageSize)
+    ->ThreadRange(1, bench::kMaxThreads)
+    ->UseRealTime();
+
+// Pointer + length entry point: directly comparable with BM_AsyncLogger_Log
+void BM_CBridge_LogN(benchmark::State& state) {
+    if (!g_logger) {
+        state.SkipWithError("speckit_logger_create failed");
+        return;
+    }
+    const std::string& message = bench::messageStringOfSize(static_cast<size_t>(state.range(0)));
+    for (auto _ : state) {
+        speckit_logger_log_n(g_logger, SPECKIT_LOG_LEVEL_INFO, kTag, sizeof(kTag) - 1,
+                             message.data(), message.size());
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_CBridge_LogN)
+    ->Setup(createLogger)
+    ->Teardown(destroyLogger)
+    ->RangeMultiplier(16)
+    ->Range(bench::kMinMessageSize, bench::kMaxMessageSize)
+    ->ThreadRange(1, bench::kMaxThreads)
+    ->UseRealTime();
+
+// Formatting on the calling thread, as C clients did before speckit_logger_logf
+void BM_CBridge_SnprintfThenLogN(benchmark::State& state) {
+    if (!g_logger) {
+        state.SkipWithError("speckit_logger_create failed");
+        return;
+    }
+    char buffer[256];
+    int i = 0;
+    for (auto _ : state) {
+        int length = std::snprintf(buffer, sizeof(buffer), "request %d from %s took %.3f ms",
+                                   ++i, "10.0.0.1", 1.25);
+        speckit_logger_log_n(g_logger, SPECKIT_LOG_LEVEL_INFO, kTag, sizeof(kTag) - 1,
+                             buffer, static_cast<size_t>(length));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_CBridge_SnprintfThenLogN)
+    ->Setup(createLogger)
+    ->Teardown(destroyLogger)
+    ->ThreadRange(1, bench::kMaxThreads)
+    ->UseRealTime();
+
+// Same message with formatting deferred to the writer thread
+void BM_CBridge_Logf(benchmark::State& state) {
+    if (!g_logger) {
+        state.SkipWithError("speckit_logger_create failed");
+        return;
+    }
+    int i = 0;
+    for (auto _ : state) {
+        speckit_logger_logf(g_logger, SPECKIT_LOG_LEVEL_INFO, kTag, "request %d from %s took %.3f ms",
+                            ++i, "10.0.0.1", 1.25);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_CBridge_Logf)
+    ->Setup(createLogger)
+    ->Teardown(destroyLogger)
+    ->ThreadRange(1, bench::kMaxThreads)
+    ->UseRealTime();
+
+void BM_CBridge_FilteredOut(benchmark::State& state) {
+    if (!g_logger) {
+        state.SkipWithError("speckit_logger_create failed");
+        return;
+    }
+    speckit_logger_set_log_level(g_logger, SPECKIT_LOG_LEVEL_WARNING);
+    const std::string& message = bench::messageStringOfSize(64);
+    for (auto _ : state) {
+        speckit_logger_log_n(g_logger, SPECKIT_LOG_LEVEL_DEBUG, kTag, sizeof(kTag) - 1,
+                             message.data(), message.size());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_CBridge_FilteredOut)->Setup(createLogger)->Teardown(destroyLogger);
+
+}  // namespace
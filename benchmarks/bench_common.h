@@ -0,0 +1,106 @@
+// Shared helpers for the speckit_benchmarks suite
+
+#pragma once
+
+#include "speckit/log/log_entry.h"
+#include "speckit/log/log_level.h"
+#include "speckit/log/platform.h"
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <string>
+#include <string_view>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/resource.h>
+#endif
+
+namespace bench {
+
+/// Message sizes swept by payload-dependent benchmarks (bytes)
+constexpr int kMinMessageSize = 16;
+constexpr int kMaxMessageSize = 4096;
+
+/// Thread counts swept by contended benchmarks
+constexpr int kMaxThreads = 64;
+
+/// Long-lived message payload of the requested size.
+/// LogEntry only stores views, so payloads must outlive the queued entries.
+inline std::string_view messageOfSize(size_t size) {
+    static const std::string payload(kMaxMessageSize, 'x');
+    return std::string_view(payload.data(), size < payload.size() ? size : payload.size());
+}
+
+/// Long-lived std::string payload for APIs taking const std::string&.
+/// Sizes are rounded up to the next power of two in [kMinMessageSize, kMaxMessageSize].
+inline const std::string& messageStringOfSize(size_t size) {
+    static const std::map<size_t, std::string> payloads = []() {
+        std::map<size_t, std::string> m;
+        for (size_t n = kMinMessageSize; n <= kMaxMessageSize; n *= 2) {
+            m.emplace(n, std::string(n, 'x'));
+        }
+        return m;
+    }();
+    auto it = payloads.lower_bound(size);
+    return it != payloads.end() ? it->second : payloads.rbegin()->second;
+}
+
+/// Build an entry with realistic field values
+inline LogEntry makeEntry(std::string_view message,
+                          LogLevel level = LogLevel::kLogLevelInfo) {
+    return LogEntry(level, 1700000000123, static_cast<ProcessIdType>(4242), ThreadIdType{},
+                    "Benchmark", message);
+}
+
+/// Process-wide CPU time and context switches, like the counters `perf stat` reports
+struct ResourceUsage {
+    double cpu_seconds = 0.0;         ///< User + system time of all threads
+    int64_t context_switches = 0;     ///< Voluntary + involuntary (not available on Windows)
+
+    static ResourceUsage now() {
+        ResourceUsage usage;
+#ifdef _WIN32
+        FILETIME created, exited, kernel, user;
+        if (GetProcessTimes(GetCurrentProcess(), &created, &exited, &kernel, &user)) {
+            auto ticks = [](const FILETIME& t) {
+                return (static_cast<uint64_t>(t.dwHighDateTime) << 32) | t.dwLowDateTime;
+            };
+            usage.cpu_seconds = static_cast<double>(ticks(kernel) + ticks(user)) * 1e-7;
+        }
+#else
+        rusage ru{};
+        if (getrusage(RUSAGE_SELF, &ru) == 0) {
+            usage.cpu_seconds = static_cast<double>(ru.ru_utime.tv_sec + ru.ru_stime.tv_sec) +
+                                static_cast<double>(ru.ru_utime.tv_usec + ru.ru_stime.tv_usec) * 1e-6;
+            usage.context_switches = ru.ru_nvcsw + ru.ru_nivcsw;
+        }
+#endif
+        return usage;
+    }
+};
+
+/// Per-benchmark scratch directory for file output, removed on destruction
+class ScratchDir {
+public:
+    explicit ScratchDir(const std::string& name)
+        : path_(std::filesystem::temp_directory_path() / ("speckit_bench_" + name)) {
+        std::filesystem::remove_all(path_);
+        std::filesystem::create_directories(path_);
+    }
+
+    ~ScratchDir() {
+        std::error_code ec;
+        std::filesystem::remove_all(path_, ec);
+    }
+
+    std::string file(const std::string& base) const { return (path_ / base).string(); }
+
+private:
+    std::filesystem::path path_;
+};
+
+}  // namespace bench
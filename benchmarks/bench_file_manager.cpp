@@ -0,0 +1,29 @@
+// Benchmarks for FileManager writes
+
+#include "bench_common.h"
+#include "speckit/log/file_manager.h"
+#include <string>
+
+namespace {
+
+void BM_FileManager_Write(benchmark::State& state) {
+    bench::ScratchDir dir("file_manager");
+    FileManager file_manager(dir.file("write"));
+    file_manager.SetMaxFileSize(static_cast<size_t>(-1));  // Never rotate during the run
+    if (!file_manager.Initialize(static_cast<ProcessIdType>(4242))) {
+        state.SkipWithError("FileManager::Initialize failed");
+        return;
+    }
+
+    const std::string line(static_cast<size_t>(state.range(0)), 'x');
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(file_manager.Write(line));
+    }
+    file_manager.Flush();
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_FileManager_Write)->RangeMultiplier(4)->Range(bench::kMinMessageSize,
+                                                            bench::kMaxMessageSize);
+
+}  // namespace
@@ -0,0 +1,97 @@
+// Benchmarks for log entry formatting
+
+#include "bench_common.h"
+#include "speckit/log/binary_log_format.h"
+#include "speckit/log/json_format.h"
+#include "speckit/log/line_pattern.h"
+#include "speckit/log/log_fields.h"
+#include <string>
+
+namespace {
+
+void BM_FormatLogEntry(benchmark::State& state) {
+    const auto message = bench::messageOfSize(static_cast<size_t>(state.range(0)));
+    const LogEntry entry = bench::makeEntry(message);
+    for (auto _ : state) {
+        std::string line = formatLogEntry(entry);
+        benchmark::DoNotOptimize(line.data());
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_FormatLogEntry)->RangeMultiplier(4)->Range(bench::kMinMessageSize,
+                                                         bench::kMaxMessageSize);
+
+// Writer-side cost of binary output for the same entries; compare with BM_FormatLogEntry
+void BM_BinaryLogEncoder_Encode(benchmark::State& state) {
+    const auto message = bench::messageOfSize(static_cast<size_t>(state.range(0)));
+    const LogEntry entry = bench::makeEntry(message);
+    BinaryLogEncoder encoder;
+    encoder.reset(BinaryFileHeader::now(entry.process_id));
+    std::string out;
+    for (auto _ : state) {
+        out.clear();
+        encoder.encode(entry, out);
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+    state.counters["record_bytes"] = static_cast<double>(out.size());
+}
+BENCHMARK(BM_BinaryLogEncoder_Encode)->RangeMultiplier(4)->Range(bench::kMinMessageSize,
+                                                                  bench::kMaxMessageSize);
+
+// Compile-time patterns; DefaultLinePattern produces exactly the BM_FormatLogEntry output
+template <typename Pattern>
+void BM_LinePattern(benchmark::State& state) {
+    const auto message = bench::messageOfSize(static_cast<size_t>(state.range(0)));
+    const LogEntry entry = bench::makeEntry(message);
+    for (auto _ : state) {
+        std::string line = Pattern::format(entry);
+        benchmark::DoNotOptimize(line.data());
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_TEMPLATE(BM_LinePattern, DefaultLinePattern)
+    ->RangeMultiplier(4)->Range(bench::kMinMessageSize, bench::kMaxMessageSize);
+BENCHMARK_TEMPLATE(BM_LinePattern, LinePattern<"%L %T{%H:%M:%S.%f} [%t] [%g] %m">)
+    ->RangeMultiplier(4)->Range(bench::kMinMessageSize, bench::kMaxMessageSize);
+
+// JSON Lines counterpart of BM_FormatLogEntry, with three structured fields attached
+void BM_FormatLogEntryJson(benchmark::State& state) {
+    const auto message = bench::messageOfSize(static_cast<size_t>(state.range(0)));
+    const LogEntry base = bench::makeEntry(message);
+    std::string fields;
+    speckit::log::encodeFields({{"user_id", 42}, {"latency_us", 1234.5}, {"path", "/api/v1/items"}}, fields);
+    const LogEntry entry = LogEntry::createOwned(base.level, base.timestamp_ms, base.process_id,
+                                                 base.thread_id, base.tag, base.message, fields);
+    for (auto _ : state) {
+        std::string line = formatLogEntryJson(entry);
+        benchmark::DoNotOptimize(line.data());
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_FormatLogEntryJson)->RangeMultiplier(4)->Range(bench::kMinMessageSize,
+                                                             bench::kMaxMessageSize);
+
+// String escaping alone; arg 1 puts a quote every 64 bytes, arg 0 has nothing to escape
+void BM_JsonEscape(benchmark::State& state) {
+    std::string text(bench::messageOfSize(bench::kMaxMessageSize));
+    if (state.range(0)) {
+        for (size_t i = 63; i < text.size(); i += 64) {
+            text[i] = '"';
+        }
+    }
+    std::string out;
+    for (auto _ : state) {
+        out.clear();
+        speckit::log::appendJsonEscaped(out, text);
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(text.size()));
+}
+BENCHMARK(BM_JsonEscape)->Arg(0)->Arg(1);
+
+}  // namespace
@@ -0,0 +1,97 @@
+// Benchmarks for TagFilter lookups and per-call-site rate limiting
+
+#include "bench_common.h"
+#include "speckit/log/tag_filter.h"
+#include "speckit/log/rate_limiter.h"
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+std::unique_ptr<speckit::log::TagFilter> g_filter;
+std::vector<std::string> g_tags;
+
+void populateFilter(const benchmark::State& state) {
+    g_filter = std::make_unique<speckit::log::TagFilter>();
+    g_tags.clear();
+    for (int64_t i = 0; i < state.range(0); ++i) {
+        g_tags.push_back("Tag" + std::to_string(i));
+        g_filter->setTagEnabled(g_tags.back(), i % 2 == 0);
+        g_filter->setTagLevel(g_tags.back(), LogLevel::kLogLevelInfo);
+    }
+}
+
+void releaseFilter(const benchmark::State&) {
+    g_filter.reset();
+    g_tags.clear();
+}
+
+void BM_TagFilter_Lookup(benchmark::State& state) {
+    size_t index = static_cast<size_t>(state.thread_index());
+    for (auto _ : state) {
+        const std::string& tag = g_tags[index++ % g_tags.size()];
+        bool enabled = g_filter->isTagEnabled(tag);
+        LogLevel level = g_filter->getTagLevel(tag);
+        benchmark::DoNotOptimize(enabled);
+        benchmark::DoNotOptimize(level);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_TagFilter_Lookup)
+    ->Setup(populateFilter)
+    ->Teardown(releaseFilter)
+    ->Arg(8)
+    ->Arg(512)
+    ->ThreadRange(1, bench::kMaxThreads)
+    ->UseRealTime();
+
+void createSampler(const benchmark::State&) {
+    g_filter = std::make_unique<speckit::log::TagFilter>();
+    g_filter->setTagSampleRate("Chatty", 100);
+}
+
+void BM_TagFilter_Sample(benchmark::State& state) {
+    uint64_t kept = 0;
+    for (auto _ : state) {
+        kept += g_filter->sample("Chatty", LogLevel::kLogLevelDebug);
+    }
+    state.counters["kept"] = static_cast<double>(kept);
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_TagFilter_Sample)
+    ->Setup(createSampler)
+    ->Teardown(releaseFilter)
+    ->ThreadRange(1, bench::kMaxThreads)
+    ->UseRealTime();
+
+std::unique_ptr<speckit::log::CallSiteRateLimiter> g_limiter;
+
+void createLimiter(const benchmark::State&) {
+    g_filter = std::make_unique<speckit::log::TagFilter>();
+    g_filter->setTagRateLimit("Hot", speckit::log::RateLimit{100, 10});
+    g_limiter = std::make_unique<speckit::log::CallSiteRateLimiter>();
+}
+
+void releaseLimiter(const benchmark::State&) {
+    g_limiter.reset();
+    g_filter.reset();
+}
+
+// A hot loop that is being throttled: every call after the burst is rejected
+void BM_RateLimiter_Throttled(benchmark::State& state) {
+    const std::source_location site = std::source_location::current();
+    uint64_t allowed = 0;
+    for (auto _ : state) {
+        allowed += g_limiter->tryAcquire(site, "Hot", *g_filter);
+    }
+    state.counters["allowed"] = static_cast<double>(allowed);
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_RateLimiter_Throttled)
+    ->Setup(createLimiter)
+    ->Teardown(releaseLimiter)
+    ->ThreadRange(1, bench::kMaxThreads)
+    ->UseRealTime();
+
+}  // namespace
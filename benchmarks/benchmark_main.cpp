@@ -0,0 +1,33 @@
+// Entry point for speckit_benchmarks
+// Writes JSON results to speckit_benchmarks.json unless --benchmark_out is given
+
+#include <benchmark/benchmark.h>
+#include <string>
+#include <vector>
+
+int main(int argc, char** argv) {
+    std::vector<char*> args(argv, argv + argc);
+
+    bool has_out = false;
+    for (int i = 1; i < argc; ++i) {
+        if (std::string(argv[i]).rfind("--benchmark_out=", 0) == 0) {
+            has_out = true;
+        }
+    }
+
+    std::string out_flag = "--benchmark_out=speckit_benchmarks.json";
+    std::string format_flag = "--benchmark_out_format=json";
+    if (!has_out) {
+        args.push_back(out_flag.data());
+        args.push_back(format_flag.data());
+    }
+
+    int count = static_cast<int>(args.size());
+    benchmark::Initialize(&count, args.data());
+    if (benchmark::ReportUnrecognizedArguments(count, args.data())) {
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
@@ -0,0 +1,78 @@
+#!/usr/bin/env python3
+"""Compare two speckit_benchmarks JSON result files.
+
+Usage:
+    compare.py BASELINE.json CONTENDER.json [--threshold PCT] [--metric real_time|cpu_time]
+
+Prints per-benchmark time deltas and exits with status 1 when any benchmark
+present in both files regressed by more than the threshold (default 10%).
+"""
+
+import argparse
+import json
+import sys
+
+
+def load(path, metric):
+    with open(path, encoding="utf-8") as f:
+        data = json.load(f)
+    results = {}
+    for bench in data.get("benchmarks", []):
+        # Skip mean/median/stddev aggregates; compare raw iterations only
+        if bench.get("run_type") == "aggregate":
+            continue
+        if "error_occurred" in bench and bench["error_occurred"]:
+            continue
+        results[bench["name"]] = (bench[metric], bench.get("time_unit", "ns"))
+    return results
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("baseline")
+    parser.add_argument("contender")
+    parser.add_argument("--threshold", type=float, default=10.0,
+                        help="regression threshold in percent (default: 10)")
+    parser.add_argument("--metric", choices=["real_time", "cpu_time"], default="real_time")
+    args = parser.parse_args()
+
+    baseline = load(args.baseline, args.metric)
+    contender = load(args.contender, args.metric)
+
+    names = [name for name in baseline if name in contender]
+    if not names:
+        print("No common benchmarks to compare")
+        return 0
+
+    width = max(len(name) for name in names)
+    print(f"{'Benchmark':<{width}}  {'Baseline':>14}  {'Contender':>14}  {'Delta':>8}")
+    regressions = []
+    for name in names:
+        old, unit = baseline[name]
+        new, _ = contender[name]
+        delta = (new - old) / old * 100.0 if old else 0.0
+        marker = ""
+        if delta > args.threshold:
+            marker = "  REGRESSION"
+            regressions.append(name)
+        elif delta < -args.threshold:
+            marker = "  improved"
+        print(f"{name:<{width}}  {old:>11.1f} {unit:<2}  {new:>11.1f} {unit:<2}  "
+              f"{delta:>+7.1f}%{marker}")
+
+    only_baseline = sorted(set(baseline) - set(contender))
+    only_contender = sorted(set(contender) - set(baseline))
+    if only_baseline:
+        print(f"\nOnly in baseline: {', '.join(only_baseline)}")
+    if only_contender:
+        print(f"\nOnly in contender: {', '.join(only_contender)}")
+
+    if regressions:
+        print(f"\n{len(regressions)} regression(s) above {args.threshold:.1f}%")
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -1,12 +1,15 @@
 #include "speckit_logger.h"
-#include "speckit/log/file_manager.h"
+#include "speckit/log/async_logger.h"
 #include "speckit/log/tag_filter.h"
 #include "speckit/log/archive.h"
+#include "speckit/log/metrics.h"
 
 #include <memory>
 #include <string>
+#include <string_view>
 #include <chrono>
-#include <sstream>
+#include <cstdarg>
+#include <cstring>
 #include <thread>
 
 #ifdef _WIN32
@@ -16,72 +19,130 @@
 #endif
 
 struct SpeckitLoggerImpl {
-    std::unique_ptr<FileManager> fm;
-    std::unique_ptr<speckit::log::TagFilter> tagFilter;
-    speckit::log::LogLevel level = speckit::log::LogLevel::kLogLevelDebug;
-    std::string baseName;
-    int processId = 0;
+    std::unique_ptr<speckit::log::TagFilter> tagFilter;  // Declared first: outlives the logger
+    std::unique_ptr<AsyncLogger> logger;
 };
 
+namespace {
+
+bool isValidLevel(int level) {
+    return level >= SPECKIT_LOG_LEVEL_DEBUG && level <= SPECKIT_LOG_LEVEL_ERROR;
+}
+
+} // namespace
+
 extern "C" {
 
 SpeckitLogger* speckit_logger_create(const char* config) {
     if (!config) return nullptr;
-    auto impl = new SpeckitLoggerImpl();
-    impl->baseName = std::string(config);
-
-#ifdef _WIN32
-    impl->processId = static_cast<int>(GetCurrentProcessId());
-#else
-    impl->processId = static_cast<int>(getpid());
-#endif
+    auto impl = std::make_unique<SpeckitLoggerImpl>();
 
-    impl->fm = std::make_unique<FileManager>(impl->baseName);
-    impl->fm->Initialize(impl->processId);
+    impl->logger = AsyncLogger::create(std::string(config));
+    if (!impl->logger) return nullptr;
     impl->tagFilter = std::make_unique<speckit::log::TagFilter>();
+    impl->logger->setTagFilter(impl->tagFilter.get());
 
-    return reinterpret_cast<SpeckitLogger*>(impl);
+    return reinterpret_cast<SpeckitLogger*>(impl.release());
 }
 
 SpeckitErrorCode speckit_logger_log(SpeckitLogger* logger, int level,
                                      const char* tag, const char* message) {
     if (!logger || !message) return SPECKIT_ERROR_NULL_POINTER;
+    return speckit_logger_log_n(logger, level, tag, tag ? std::strlen(tag) : 0,
+                                message, std::strlen(message));
+}
+
+SpeckitErrorCode speckit_logger_log_n(SpeckitLogger* logger, int level,
+                                       const char* tag, size_t tag_len,
+                                       const char* message, size_t message_len) {
+    if (!logger) return SPECKIT_ERROR_NULL_POINTER;
+    if ((!message && message_len > 0) || (!tag && tag_len > 0)) return SPECKIT_ERROR_NULL_POINTER;
+    if (!isValidLevel(level)) return SPECKIT_ERROR_INVALID_ARGUMENT;
     auto impl = reinterpret_cast<SpeckitLoggerImpl*>(logger);
 
-    // Tag filtering
-    std::string tagStr = tag ? tag : "";
-    if (!impl->tagFilter->isTagEnabled(tagStr)) return SPECKIT_SUCCESS;
+    // The logger applies the level, tag filter and rate limits; all C callers share
+    // this call site, so rate limits are effectively per tag
+    const auto msgLevel = static_cast<LogLevel>(level);
+    std::string_view tagView(tag ? tag : "", tag_len);
+
+    // Copied once into the queued entry; formatting happens on the writer thread
+    impl->logger->log(msgLevel, tagView, std::string_view(message ? message : "", message_len));
+    return SPECKIT_SUCCESS;
+}
 
-    // Level filtering per tag
-    speckit::log::LogLevel tagLevel = impl->tagFilter->getTagLevel(tagStr);
-    speckit::log::LogLevel msgLevel = static_cast<speckit::log::LogLevel>(level);
-    if (static_cast<int>(msgLevel) < static_cast<int>(tagLevel)) return SPECKIT_SUCCESS;
+SpeckitErrorCode speckit_logger_logf(SpeckitLogger* logger, int level,
+                                     const char* tag, const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    SpeckitErrorCode result = speckit_logger_vlogf(logger, level, tag, format, args);
+    va_end(args);
+    return result;
+}
 
-    // Basic formatting: [LEVEL] message\n
-    std::string out = message;
-    out.push_back('\n');
+SpeckitErrorCode speckit_logger_vlogf(SpeckitLogger* logger, int level,
+                                      const char* tag, const char* format, va_list args) {
+    if (!logger || !format) return SPECKIT_ERROR_NULL_POINTER;
+    if (!isValidLevel(level)) return SPECKIT_ERROR_INVALID_ARGUMENT;
+    auto impl = reinterpret_cast<SpeckitLoggerImpl*>(logger);
 
-    bool ok = impl->fm->Write(out);
-    if (!ok) return SPECKIT_ERROR_FILE_IO;
+    // vlogf filters before touching the arguments
+    const auto msgLevel = static_cast<LogLevel>(level);
+    std::string_view tagView(tag ? tag : "");
 
-    if (impl->fm->NeedsRotation()) {
-        impl->fm->Rotate();
+    if (!impl->logger->vlogf(msgLevel, tagView, format, args)) {
+        return SPECKIT_ERROR_INVALID_ARGUMENT;
     }
-
     return SPECKIT_SUCCESS;
 }
 
 SpeckitErrorCode speckit_logger_set_log_level(SpeckitLogger* logger, int level) {
     if (!logger) return SPECKIT_ERROR_NULL_POINTER;
+    if (!isValidLevel(level)) return SPECKIT_ERROR_INVALID_ARGUMENT;
+    auto impl = reinterpret_cast<SpeckitLoggerImpl*>(logger);
+    impl->logger->setLogLevel(static_cast<LogLevel>(level));
+    return SPECKIT_SUCCESS;
+}
+
+SpeckitErrorCode speckit_logger_get_metrics(SpeckitLogger* logger, SpeckitMetrics* metrics) {
+    if (!logger || !metrics) return SPECKIT_ERROR_NULL_POINTER;
     auto impl = reinterpret_cast<SpeckitLoggerImpl*>(logger);
-    impl->level = static_cast<speckit::log::LogLevel>(level);
+
+    MetricsSnapshot snapshot = impl->logger->getMetrics();
+    metrics->entries_enqueued = snapshot.entries_enqueued;
+    metrics->entries_dropped = snapshot.entries_dropped;
+    metrics->entries_written = snapshot.entries_written;
+    metrics->bytes_written = snapshot.bytes_written;
+    metrics->queue_high_water = snapshot.queue_high_water;
+    metrics->batches = snapshot.batches;
+    metrics->rotations = snapshot.rotations;
+    metrics->flush_latency_p50_ns = snapshot.flush_latency_ns.p50;
+    metrics->flush_latency_p99_ns = snapshot.flush_latency_ns.p99;
+    metrics->flush_latency_max_ns = snapshot.flush_latency_ns.max;
+    metrics->fsync_latency_p50_ns = snapshot.fsync_latency_ns.p50;
+    metrics->fsync_latency_p99_ns = snapshot.fsync_latency_ns.p99;
+    metrics->fsync_latency_max_ns = snapshot.fsync_latency_ns.max;
+    metrics->rotation_max_ns = snapshot.rotation_ns.max;
     return SPECKIT_SUCCESS;
 }
 
+SpeckitErrorCode speckit_logger_set_metrics_dump(SpeckitLogger* logger, const char* path,
+                                                 uint32_t interval_ms) {
+    if (!logger) return SPECKIT_ERROR_NULL_POINTER;
+    auto impl = reinterpret_cast<SpeckitLoggerImpl*>(logger);
+
+    if (interval_ms == 0) {
+        impl->logger->setMetricsDump(std::string(), std::chrono::milliseconds(0));
+        return SPECKIT_SUCCESS;
+    }
+    if (!path || !*path) return SPECKIT_ERROR_INVALID_ARGUMENT;
+    bool ok = impl->logger->setMetricsDump(path, std::chrono::milliseconds(interval_ms));
+    return ok ? SPECKIT_SUCCESS : SPECKIT_ERROR_THREAD;
+}
+
 SpeckitErrorCode speckit_logger_destroy(SpeckitLogger* logger) {
     if (!logger) return SPECKIT_ERROR_NULL_POINTER;
     auto impl = reinterpret_cast<SpeckitLoggerImpl*>(logger);
-    // flush and cleanup handled in FileManager destructor
+    // AsyncLogger drains the queue and joins the writer thread on destruction
     delete impl;
     return SPECKIT_SUCCESS;
 }
@@ -3,6 +3,10 @@
 
 #pragma once
 
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+
 // Export macro for Windows DLL
 #ifdef _WIN32
     #ifdef SPECKITBRIDGE_EXPORTS
@@ -14,6 +18,14 @@
     #define SPECKITBRIDGE_API
 #endif
 
+// Compile-time checking of printf-style arguments (GCC/Clang)
+#if defined(__GNUC__) || defined(__clang__)
+    #define SPECKIT_PRINTF_FORMAT(format_index, first_arg) \
+        __attribute__((format(printf, format_index, first_arg)))
+#else
+    #define SPECKIT_PRINTF_FORMAT(format_index, first_arg)
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -41,12 +53,30 @@ typedef enum {
     SPECKIT_ERROR_THREAD = -7
 } SpeckitErrorCode;
 
+// Snapshot of logger metrics for C API
+typedef struct {
+    uint64_t entries_enqueued;       // Entries accepted by the logger
+    uint64_t entries_dropped;        // Entries discarded because buffers were full or I/O failed
+    uint64_t entries_written;        // Entries written to the log file
+    uint64_t bytes_written;          // Bytes written to the log file
+    uint64_t queue_high_water;       // Largest queue depth seen by the writer
+    uint64_t batches;                // Writer batches
+    uint64_t rotations;              // Log file rotations
+    uint64_t flush_latency_p50_ns;   // Median write + hand-off to OS
+    uint64_t flush_latency_p99_ns;   // 99th percentile write + hand-off to OS
+    uint64_t flush_latency_max_ns;   // Slowest write + hand-off to OS
+    uint64_t fsync_latency_p50_ns;   // Median durable flush
+    uint64_t fsync_latency_p99_ns;   // 99th percentile durable flush
+    uint64_t fsync_latency_max_ns;   // Slowest durable flush
+    uint64_t rotation_max_ns;        // Slowest rotation
+} SpeckitMetrics;
+
 // Create a logger instance
 // @param config Logger configuration (e.g., base filename)
 // @return Logger handle or nullptr on error
 SPECKITBRIDGE_API SpeckitLogger* speckit_logger_create(const char* config);
 
-// Log a message
+// Log a message (NUL-terminated strings); see speckit_logger_log_n
 // @param logger Logger handle
 // @param level Log level (SpeckitLogLevel)
 // @param tag Log category tag
@@ -55,12 +85,64 @@ SPECKITBRIDGE_API SpeckitLogger* speckit_logger_create(const char* config);
 SPECKITBRIDGE_API SpeckitErrorCode speckit_logger_log(SpeckitLogger* logger, int level,
                                      const char* tag, const char* message);
 
+// Log a message given as pointer + length (no strlen, no NUL terminator required)
+// The call only filters and enqueues; formatting and file I/O happen on the writer thread.
+// @param logger Logger handle
+// @param level Log level (SpeckitLogLevel)
+// @param tag Log category tag (may be NULL when tag_len is 0)
+// @param tag_len Tag length in bytes
+// @param message Log message
+// @param message_len Message length in bytes
+// @return SPECKIT_SUCCESS on success (including filtered-out messages), error code otherwise
+SPECKITBRIDGE_API SpeckitErrorCode speckit_logger_log_n(SpeckitLogger* logger, int level,
+                                                        const char* tag, size_t tag_len,
+                                                        const char* message, size_t message_len);
+
+// Log a printf-style message; formatting is deferred to the writer thread
+// The format is validated and the arguments copied (strings deep-copied) on the calling
+// thread. Supported: flags "-+ #0", width/precision (digits or '*'), length modifiers
+// hh h l ll j z t L and conversions d i u o x X c s p f F e E g G a A %.
+// %n, positional arguments and wide characters are rejected.
+// Calls filtered out by level, tag filter, rate limit or sampling return before the
+// format is looked at, so an invalid format is only reported when the call would log.
+// @param logger Logger handle
+// @param level Log level (SpeckitLogLevel)
+// @param tag Log category tag (may be NULL)
+// @param format printf-style format string
+// @return SPECKIT_SUCCESS on success (including filtered-out messages, whatever their format),
+//         SPECKIT_ERROR_INVALID_ARGUMENT for an invalid or unsupported format
+SPECKITBRIDGE_API SpeckitErrorCode speckit_logger_logf(SpeckitLogger* logger, int level,
+                                                       const char* tag, const char* format, ...)
+    SPECKIT_PRINTF_FORMAT(4, 5);
+
+// va_list variant of speckit_logger_logf; @p args is consumed
+SPECKITBRIDGE_API SpeckitErrorCode speckit_logger_vlogf(SpeckitLogger* logger, int level,
+                                                        const char* tag, const char* format,
+                                                        va_list args)
+    SPECKIT_PRINTF_FORMAT(4, 0);
+
 // Set minimum log level
 // @param logger Logger handle
 // @param level Minimum log level
 // @return SPECKIT_SUCCESS on success, error code otherwise
 SPECKITBRIDGE_API SpeckitErrorCode speckit_logger_set_log_level(SpeckitLogger* logger, int level);
 
+// Get a snapshot of logger metrics
+// @param logger Logger handle
+// @param metrics Receives the snapshot
+// @return SPECKIT_SUCCESS on success, error code otherwise
+SPECKITBRIDGE_API SpeckitErrorCode speckit_logger_get_metrics(SpeckitLogger* logger,
+                                                              SpeckitMetrics* metrics);
+
+// Periodically write metrics to a local text file
+// @param logger Logger handle
+// @param path File replaced on every dump
+// @param interval_ms Milliseconds between dumps; 0 stops dumping
+// @return SPECKIT_SUCCESS on success, error code otherwise
+SPECKITBRIDGE_API SpeckitErrorCode speckit_logger_set_metrics_dump(SpeckitLogger* logger,
+                                                                   const char* path,
+                                                                   uint32_t interval_ms);
+
 // Destroy logger instance
 // @param logger Logger handle
 // @return SPECKIT_SUCCESS on success, error code otherwise
@@ -3,37 +3,71 @@
 
 #pragma once
 
+#include <cstdarg>
+#include <array>
+#include <concepts>
+#include <functional>
+#include <source_location>
+#include <span>
 #include <string>
+#include <string_view>
+#include <type_traits>
 #include <memory>
 #include <atomic>
 #include <thread>
 #include <stop_token>
-#include <semaphore>
+#include <mutex>
 #include "log_level.h"
 #include "log_entry.h"
 #include "file_manager.h"
-#include "async_queue.h"
-#include "log_buffer.h"
+#include "flight_recorder.h"
+#include "binary_log_format.h"
+#include "json_format.h"
+#include "log_fields.h"
+#include "line_pattern.h"
+#include "format_pipeline.h"
+#include "log_router.h"
+#include "tuned_async_queue.h"
+#include "lane_merger.h"
+#include "rate_limiter.h"
+#include "repeat_collapser.h"
+#include "sink_fanout.h"
+#include "tag_filter.h"
 #include "crash_handler.h"
+#include "metrics.h"
+#include "wait_strategy.h"
+#include "overflow_policy.h"
 #include "platform.h"
 
 
 
 /// Async logger with background writer thread
 /// Provides <1ms log call latency with non-blocking operations
+///
+/// WARNING and ERROR entries that find the queue full go to a small reserved lane
+/// instead, which the writer drains first, so a flood of lower-level entries cannot
+/// crowd them out. The lanes are merged back into timestamp order within each
+/// written batch.
+///
+/// Besides the log file, formatted lines can be fanned out to extra sinks (see addSink()).
+/// Entries below the log level can be kept in memory for later dumps (see enableFlightRecorder()).
+/// Lines can also be copied to extra files by tag and level (see setRoutes()).
 class AsyncLogger {
 public:
     /// Create async logger instance. Returns nullptr on failure.
     /// @param base_name Base name for log files (supports absolute/relative paths, UTF-8 encoding)
-    /// @param queue_size Size of async queue (default: 10000)
+    /// @param queue_size Size of async queue, rounded up to a power of two (default: 10000)
+    /// @param formatter_threads Threads formatting batches in parallel ahead of a single
+    ///        ordered I/O thread; 0 (default) formats and writes on the writer thread
     static std::unique_ptr<AsyncLogger> create(const std::string& base_name,
-                                               size_t queue_size = 10000);
+                                               size_t queue_size = 10000,
+                                               size_t formatter_threads = 0);
     
     /// Destructor - ensures proper cleanup
     ~AsyncLogger();
 
     /// Initialize logger components. Returns true on success.
-    bool initialize(const std::string& base_name, size_t queue_size);
+    bool initialize(const std::string& base_name, size_t queue_size, size_t formatter_threads = 0);
 
     /// Deinitialize and stop background thread. Safe to call multiple times.
     void deinitialize();
@@ -47,26 +81,325 @@ public:
     LogLevel getLogLevel() const;
     
     /// Log a message asynchronously
+    /// Tag and message are copied, so the caller's buffers may be reused immediately.
     /// @param level Log severity level
     /// @param tag Log category tag
     /// @param message User message to log
-    void log(LogLevel level, const std::string& tag, const std::string& message);
+    /// @param site Call site, for per-call-site rate limits (see setTagFilter())
+    void log(LogLevel level, std::string_view tag, std::string_view message,
+             std::source_location site = std::source_location::current());
+
+    /// Log a message with structured key-value fields
+    /// Fields are copied in binary form; text output appends " key=value" pairs,
+    /// JSON Lines output puts them in a "fields" object.
+    /// Example: log(level, "Auth", "login", {{"user_id", 42}, {"latency_us", 1234}})
+    /// @param level Log severity level
+    /// @param tag Log category tag
+    /// @param message User message to log
+    /// @param fields Typed key-value pairs
+    /// @param site Call site, for per-call-site rate limits (see setTagFilter())
+    void log(LogLevel level, std::string_view tag, std::string_view message,
+             std::initializer_list<LogField> fields,
+             std::source_location site = std::source_location::current());
+
+    /// Log a message built only if the entry passes the level and tag filters
+    /// Example: log(LogLevel::kLogLevelDebug, "Cache", [&] { return cache.dump(); })
+    /// @param level Log severity level
+    /// @param tag Log category tag
+    /// @param make_message Callable returning the message (std::string or anything
+    ///        convertible to std::string_view); never called for filtered entries
+    /// @param site Call site, for per-call-site rate limits (see setTagFilter())
+    template <typename MessageFn>
+        requires std::invocable<MessageFn&> &&
+                 std::convertible_to<std::invoke_result_t<MessageFn&>, std::string_view>
+    void log(LogLevel level, std::string_view tag, MessageFn&& make_message,
+             std::source_location site = std::source_location::current()) {
+        const Admission admission = admit(level, tag, site);
+        if (admission != Admission::kSkip) {
+            auto&& message = std::invoke(make_message);
+            enqueueMessage(admission, level, tag, std::string_view(message));
+        }
+    }
+
+    /// Log a message written into a reused per-thread buffer, only if the entry passes
+    /// the level and tag filters
+    /// The buffer arrives empty and is copied once into the queued entry, so no message
+    /// string is allocated per call. The callable may log itself; each nesting level gets
+    /// its own per-thread buffer, up to kMessageBufferDepth, and a local string beyond.
+    /// Example: log(LogLevel::kLogLevelDebug, "Cache", [&](std::string& out) { cache.dumpTo(out); })
+    /// @param level Log severity level
+    /// @param tag Log category tag
+    /// @param write_message Callable appending the message to its std::string& argument
+    /// @param site Call site, for per-call-site rate limits (see setTagFilter())
+    template <typename WriteFn>
+        requires std::invocable<WriteFn&, std::string&>
+    void log(LogLevel level, std::string_view tag, WriteFn&& write_message,
+             std::source_location site = std::source_location::current()) {
+        const Admission admission = admit(level, tag, site);
+        if (admission != Admission::kSkip) {
+            MessageBuffer buffer;
+            std::invoke(write_message, buffer.get());
+            enqueueMessage(admission, level, tag, buffer.get());
+        }
+    }
+
+    /// Log a printf-style message with formatting deferred to the writer thread
+    /// The format is validated and its arguments (strings deep-copied) are queued;
+    /// see speckit::log::capturePrintf() for the supported conversions.
+    /// @param level Log severity level
+    /// @param tag Log category tag
+    /// @param format printf-style format string
+    /// @param args Arguments for @p format; consumed by this call
+    /// @param site Call site, for per-call-site rate limits (see setTagFilter())
+    /// @return false if the format is invalid or unsupported (nothing is logged);
+    ///         true for filtered-out calls, whose format is not validated
+    bool vlogf(LogLevel level, std::string_view tag, const char* format, va_list args,
+               std::source_location site = std::source_location::current());
 
     /// Flush all buffered logs to disk
+    /// Also waits until every sink has written (or skipped) what was flushed, for at
+    /// most SinkFanout::kDefaultWaitTimeout; a sink still busy then counts a wait
+    /// timeout in getSinkStats().
     void flush();
 
+    /// Also send formatted lines to @p sink, on a thread of its own
+    /// Each batch is formatted once for the file and shared by all sinks; every sink
+    /// applies its own level on top of the logger's. A sink that cannot keep up skips
+    /// batches (see getSinkStats()) rather than slowing the file or the other sinks.
+    /// Binary log files are formatted as text for the sinks. Sinks cannot be removed;
+    /// they are stopped by deinitialize() after writing everything logged. A sink still
+    /// stuck in write() after SinkFanout::kDefaultWaitTimeout is left to finish on its
+    /// own thread (see SinkFanout::getAbandonedSinks()).
+    /// LogSink::write() must not call flush() or deinitialize().
+    /// @param sink FileSink, ConsoleSink, MemoryRingSink, UnixDatagramSink, CallbackSink or custom
+    void addSink(std::shared_ptr<LogSink> sink);
+
+    /// Get delivery counters of the sinks
+    /// @return One entry per sink, in the order they were added
+    std::vector<SinkStats> getSinkStats() const;
+
+    /// Also copy lines to extra files chosen by tag and level
+    /// Example: tags "Audit" and "Security" to "<base>.audit.log", ERROR to "<base>.error.log".
+    /// The main file still gets every line. Routed lines are formatted once, for the
+    /// main file (as text when it is binary), and written by the same thread; each
+    /// target file rotates with its own size and retention limits. Queued entries are
+    /// routed by the old rules first; a target whose name is already routed keeps its
+    /// file. Routed files are not covered by crash recovery.
+    /// @param targets Files and their rules, at most LogRouter::kMaxTargets; empty stops routing
+    /// @return false if not initialized, a rule is invalid or a file cannot be opened;
+    ///         the old routes then stay
+    bool setRoutes(const std::vector<RouteTarget>& targets);
+
+    /// Get the paths of the routed files currently being written
+    /// @return One path per target, in the order given to setRoutes()
+    std::vector<std::string> getRouteFileNames() const;
+
+    /// Keep entries that the log level filters out in an in-memory ring, for dumps
+    /// Log calls below the level then still build their message (lazy messages
+    /// included) and copy it into the ring in binary form; the tag filter's disabled
+    /// tags stay out. Nothing is formatted or written until a dump: dumpFlightRecorder(),
+    /// options.dump_signal, or a log call at options.dump_level (the recorder's own
+    /// thread writes those). Each dump is a new "<base>.flight.<pid>.<n>.log" text file
+    /// holding what was recorded since the previous one, laid out like the log file
+    /// (line formatter or JSON Lines; binary logs dump as text). Call once; the recorder lives
+    /// until the logger is destroyed.
+    /// @param options Ring budget and dump triggers
+    /// @return false if not initialized, already enabled, or the signal handler failed
+    bool enableFlightRecorder(const FlightRecorderOptions& options = {});
+
+    /// Dump the flight recorder now, on the calling thread
+    /// @return Path of the dump file, or empty if there was nothing to dump or no recorder
+    std::string dumpFlightRecorder();
+
+    /// Get the flight recorder's counters
+    /// @return Zeros if no recorder is enabled
+    FlightRecorderStats getFlightRecorderStats() const;
+
+    /// Choose how the writer thread waits for work; takes effect on its next wait
+    /// @param strategy Busy-spin, spin-then-yield, spin-then-park (default) or timed park
+    void setWaitStrategy(WaitStrategy strategy);
+
+    /// Get the writer's wait strategy
+    /// @return Current wait strategy
+    WaitStrategy getWaitStrategy() const;
+
+    /// Apply per-tag rules from @p filter to every log call
+    /// Disabled tags, per-tag levels and sample rates are checked on the calling
+    /// thread (sampled-out lines are counted in entries_sampled_out), as is each
+    /// tag's RateLimit, per call site (source_location + tag); throttled calls
+    /// are counted in entries_rate_limited. Tags that collapse repeats are handled by
+    /// the writer, which replaces identical consecutive lines with
+    /// "last message repeated N times".
+    /// @param filter Rules; must outlive the logger, or nullptr to remove them
+    void setTagFilter(const speckit::log::TagFilter* filter);
+
+    /// Choose what log() does when the queue is full
+    /// No policy writes from the calling thread. Discarded entries are counted per
+    /// level (MetricsSnapshot::dropped_by_level) and reported in the log by the writer
+    /// as a "[kLossMarkerTag]: N entries dropped (...)" warning once it catches up.
+    /// @param policy Drop newest (default), drop oldest, block with timeout, or drop below a level
+    void setOverflowPolicy(const OverflowPolicy& policy);
+
+    /// Get the overflow policy
+    /// @return Current policy
+    OverflowPolicy getOverflowPolicy() const;
+
+    /// Capacity a per-thread message buffer of the lazy log() keeps between calls
+    static constexpr size_t kMaxRetainedMessageBuffer = 64 * 1024;
+
+    /// Per-thread message buffers of the lazy log(), one per nesting level
+    static constexpr size_t kMessageBufferDepth = 4;
+
+    /// Tag of the writer's "N entries dropped" lines
+    static constexpr std::string_view kLossMarkerTag = "SpeckitLog";
+
+    /// Lowest level allowed into the reserved priority lane
+    static constexpr LogLevel kPriorityLaneLevel = LogLevel::kLogLevelWarning;
+
+    /// Priority lane size as a fraction of the queue size, with a floor
+    static constexpr size_t kPriorityLaneDivisor = 8;
+    static constexpr size_t kMinPriorityLaneEntries = 64;
+
+    /// Switch between text, binary and JSON Lines log files
+    /// Queued entries are written in the old format first; the new format starts a
+    /// new file ("<base>.log", "<base>.slog" or "<base>.jsonl"). Binary files skip text formatting
+    /// and are turned back into text by the speckit-decode tool. Binary encoding is
+    /// stateful, so it always runs on the writer thread, even with formatter threads.
+    /// @param format Text (default), binary or JSON Lines
+    /// @return true if successful
+    bool setOutputFormat(LogFileFormat format);
+
+    /// Get the log file format
+    /// @return Current format
+    LogFileFormat getOutputFormat() const;
+
+    /// Choose the line layout of text output
+    /// Queued entries are written with the old layout first. Use a compile-time
+    /// pattern, e.g. setLineFormatter(LinePattern<"%L %T{%H:%M:%S.%f} [%t] [%g] %m">::format).
+    /// @param formatter Text line formatter; formatLogEntry (the default) if null
+    void setLineFormatter(FormatPipeline::EntryFormatter formatter);
+
+    /// Get the text line formatter
+    /// @return Current formatter
+    FormatPipeline::EntryFormatter getLineFormatter() const;
+
+    /// Get the number of parallel formatter threads
+    /// @return 0 if the writer thread formats and writes by itself
+    size_t getFormatterThreads() const;
+
+    /// Get the path of the file currently being written
+    /// @return Full path to the current log file, or empty if not initialized
+    std::string getLogFileName() const;
+
+    /// Get a point-in-time copy of the logger's metrics
+    /// @return Counters, queue high-water mark and latency summaries
+    MetricsSnapshot getMetrics() const;
+
+    /// @return true if bytes being written when the process crashes are replayed into
+    ///         the log file; false if CrashHandler::kMaxEmergencyBuffers other loggers
+    ///         already had replay when this one was created
+    bool hasCrashReplay() const;
+
+    /// Periodically write metrics to a local text file
+    /// @param path File that is replaced on every dump
+    /// @param interval Time between dumps; zero stops dumping
+    /// @return true if dumping was started
+    bool setMetricsDump(const std::string& path, std::chrono::milliseconds interval);
+
 private:
     AsyncLogger();
     
     /// Background writer thread function. The std::stop_token is provided by std::jthread.
     void writerThread(std::stop_token stop_token);
 
-    /// Helper to format and write a collection of log entries.
-    void writeEntries(const std::vector<LogEntry>& entries);
+    /// Move everything queued to the file (or into the format pipeline) without
+    /// waiting for the pipeline to write it.
+    void drainPending();
+
+    /// What a log call does with its entry
+    enum class Admission {
+        kSkip,    ///< Filtered out
+        kQueue,   ///< Queue it for the writer
+        kRecord   ///< Below the log level; only the flight recorder keeps it
+    };
+
+    /// Level, initialization and tag filter checks for one log call.
+    Admission admit(LogLevel level, std::string_view tag, const std::source_location& site);
+
+    /// Copy an admitted message into a new entry and queue it, or into the flight recorder.
+    void enqueueMessage(Admission admission, LogLevel level, std::string_view tag, std::string_view message,
+                        std::string_view fields = {}, bool deferred = false);
+
+    /// An empty message buffer for one lazy log() call: the calling thread's buffer for
+    /// the current nesting level, or a local string when nested deeper than
+    /// kMessageBufferDepth. Gives back memory after an unusually large message.
+    class MessageBuffer {
+    public:
+        MessageBuffer();
+        ~MessageBuffer();
+        MessageBuffer(const MessageBuffer&) = delete;
+        MessageBuffer& operator=(const MessageBuffer&) = delete;
+
+        std::string& get() { return *buffer_; }
+
+    private:
+        std::string* buffer_;
+        std::string overflow_;
+    };
+
+    /// Tag filter checks for a log call that passed the level check; true to log it.
+    bool passesTagFilter(LogLevel level, std::string_view tag, const std::source_location& site);
+
+    /// Push an entry to the queue; when it is full, priority entries try their reserved
+    /// lane and everything else is subject to the overflow policy.
+    void enqueue(LogEntry&& entry);
+
+    /// Overflow handling for drop-oldest and block; true if @p entry was queued.
+    bool pushOnOverflow(LogEntry& entry, OverflowMode mode);
+
+    /// Write a loss marker for entries dropped since the last one (under write_mutex_).
+    void reportDrops();
+
+    /// Pipeline for the current output format, or nullptr to write on this thread.
+    FormatPipeline* activePipeline() const;
+
+    /// Formatter for the current output format (text layout or JSON Lines).
+    FormatPipeline::EntryFormatter activeFormatter() const;
+
+    /// Move queued entries into drain_buffer_ batch by batch and write them,
+    /// or into pipeline batches when formatter threads are configured.
+    /// Stops after the number of entries queued on entry, so producers cannot keep the writer here.
+    template <typename Source>
+    void drainAndWrite(Source& source);
+
+    /// Helper to format (or binary-encode) and write a collection of log entries.
+    void writeEntries(std::span<const LogEntry> entries);
+
+    /// Stage a formatted chunk for crash recovery, write it and hand it to the OS,
+    /// then fan its @p lines out to the sinks.
+    void writeChunk(const std::string& chunk, std::span<const FormattedLine> lines = {});
+
+    /// Publish formatted lines to the sinks (writer or pipeline I/O thread).
+    void fanOut(std::string_view text, std::span<const FormattedLine> lines);
+
+    /// Append routed lines to their target files (writer or pipeline I/O thread).
+    void writeRoutes(std::string_view text, std::span<const FormattedLine> lines);
+
+    /// Formatted bytes accumulated before each write; must fit the crash staging buffer.
+    static constexpr size_t kWriteChunkBytes = 64 * 1024;
+
+    /// Maximum entries taken from a queue per write; bounds the latency of each batch.
+    static constexpr size_t kDrainBatchEntries = 1024;
+
+    /// Evict-and-retry rounds for OverflowMode::kDropOldest before dropping the new entry.
+    static constexpr int kMaxEvictionAttempts = 4;
+
+    /// Sleep between retries of OverflowMode::kBlock once spinning has not helped.
+    static constexpr std::chrono::microseconds kBlockPollInterval{50};
 
     /// Initialize components (extracted from constructor to support testing)
     /// Returns true on success.
-    bool initializeComponents(const std::string& base_name, size_t queue_size);
+    bool initializeComponents(const std::string& base_name, size_t queue_size, size_t formatter_threads);
     
     /// Emergency flush callback for crash handler
     void emergencyFlush();
@@ -81,12 +414,41 @@ private:
     int64_t getTimestamp() const;
 
     std::unique_ptr<FileManager> file_manager_;  ///< File operations manager
-    std::unique_ptr<AsyncQueue> async_queue_;    ///< Lock-free async queue
-    std::unique_ptr<RingBuffer> ring_buffer_;     ///< Crash-safe ring buffer
+    std::unique_ptr<TunedAsyncQueue> async_queue_;  ///< Lock-free async queue (bulk lane)
+    std::unique_ptr<TunedAsyncQueue> priority_queue_;  ///< Reserved lane for kPriorityLaneLevel and above
+    std::unique_ptr<LaneMerger> lanes_;            ///< Drains both lanes (guarded by write_mutex_)
     std::unique_ptr<CrashHandler> crash_handler_; ///< Crash handler
+    std::unique_ptr<FormatPipeline> format_pipeline_;  ///< Parallel format + ordered I/O stages, if enabled
     std::jthread writer_thread_;                   ///< Background writer thread
-    std::counting_semaphore<1> sem_;               ///< Semaphore for thread synchronization (C++20)
-    LogLevel min_level_ = LogLevel::kLogLevelDebug;       ///< Minimum log level
+    WriterWakeup wakeup_;                          ///< Wakes the writer only when it is parked
+    std::atomic<WaitStrategy> wait_strategy_{WaitStrategy::kSpinPark};  ///< How the writer waits
+    std::atomic<FormatPipeline::EntryFormatter> line_formatter_{formatLogEntry};  ///< Text line layout
+    std::atomic<const speckit::log::TagFilter*> tag_filter_{nullptr};  ///< Per-tag rules, if any
+    speckit::log::CallSiteRateLimiter rate_limiter_;  ///< Token buckets for tags with a RateLimit
+    RepeatCollapser repeat_collapser_;             ///< Writer-side repeat state (guarded by write_mutex_)
+    std::atomic<OverflowMode> overflow_mode_{OverflowMode::kDropNewest};  ///< Full-queue behavior
+    std::atomic<int64_t> overflow_timeout_us_{10000};                      ///< kBlock wait limit
+    std::atomic<LogLevel> overflow_min_level_{LogLevel::kLogLevelWarning};  ///< kDropBelowLevel threshold
+    uint64_t reported_drop_total_ = 0;                      ///< Drops covered by loss markers (write_mutex_)
+    std::array<uint64_t, kLogLevelCount> reported_drops_{};  ///< Same, per level (write_mutex_)
+    mutable std::mutex write_mutex_;                       ///< Serializes queue consumers and file writes
+    std::vector<LogEntry> drain_buffer_;           ///< Reused batch of drained entries (guarded by write_mutex_)
+    std::string write_buffer_;                     ///< Reused formatting buffer (guarded by write_mutex_)
+    std::vector<FormattedLine> write_lines_;       ///< Lines of write_buffer_, while sinks exist (write_mutex_)
+    std::string sink_text_;                        ///< Text lines of binary output for sinks (write_mutex_)
+    std::vector<FormattedLine> sink_lines_;        ///< Lines of sink_text_ (write_mutex_)
+    std::unique_ptr<SinkFanout> sinks_;            ///< Extra outputs, each on its own thread
+    std::unique_ptr<LogRouter> router_;            ///< Routing rules, if any (write_mutex_)
+    std::vector<std::unique_ptr<FileManager>> route_files_;  ///< One per router_ target
+    std::vector<std::string> route_buffers_;       ///< Reused output per route file
+    BinaryLogEncoder binary_encoder_;              ///< Per-file binary state (guarded by write_mutex_)
+    uint64_t encoder_generation_ = 0;              ///< File generation binary_encoder_ was reset for
+    LoggerMetrics metrics_;                        ///< Runtime counters and histograms
+    MetricsDumper metrics_dumper_;                 ///< Optional periodic metrics dump
+    std::unique_ptr<FlightRecorder> flight_recorder_owner_;  ///< Set once under write_mutex_; kept until destruction
+    std::atomic<FlightRecorder*> flight_recorder_{nullptr};  ///< Read by log calls
+    std::string base_name_;                        ///< As given to initialize()
+    std::atomic<LogLevel> min_level_{LogLevel::kLogLevelDebug};  ///< Minimum log level
     ProcessIdType process_id_;                 ///< Cached process ID
     bool initialized_ = false;                   ///< Initialization state
     size_t queue_size_;                          ///< Async queue size
@@ -50,6 +50,10 @@ Interface rules & choices
     - Convenience overload that forwards to the lvalue overload (moves on success).
 - popAll():
     - Single-consumer method which drains all available entries and returns them in a vector.
+- drain(fn, max) / drainInto(span):
+    - Single-consumer, allocation-free alternatives to popAll. drain passes each entry to
+      fn in place; drainInto moves entries into a buffer the consumer owns and reuses.
+      Both stop after max (or span size) entries so the consumer can bound its batch.
 - capacity():
     - Fixed capacity set in constructor; queue is non-resizing.
 
@@ -85,8 +89,12 @@ Credit & references
 */
 #pragma once
 
+#include <algorithm>
 #include <atomic>
+#include <limits>
 #include <memory>
+#include <span>
+#include <thread>
 #include <vector>
 #include <optional>
 #include <cstddef>
@@ -112,6 +120,16 @@ public:
     // Single-consumer: pop all available entries
     std::vector<LogEntry> popAll();
 
+    // Single-consumer: pass up to max entries to fn(LogEntry&) in place, oldest first.
+    // The entry is destroyed when fn returns; fn must move from it to keep it, and must not throw.
+    // Returns the number of entries consumed.
+    template <typename F>
+    size_t drain(F&& fn, size_t max = std::numeric_limits<size_t>::max());
+
+    // Single-consumer: move up to out.size() entries into a caller-owned, reusable buffer.
+    // Returns the number of entries written to the front of out.
+    size_t drainInto(std::span<LogEntry> out);
+
     bool isEmpty() const;
     size_t size() const;
     size_t capacity() const;
@@ -133,4 +151,42 @@ private:
     std::atomic<size_t> head_; // consumer increments (consumption)
 
     std::atomic<size_t> size_;
-};
\ No newline at end of file
+};
+
+template <typename F>
+size_t AsyncQueue::drain(F&& fn, size_t max) {
+    const size_t cap = capacity_;
+
+    size_t head = head_.load(std::memory_order_relaxed);
+    size_t tail = tail_.load(std::memory_order_acquire);
+
+    size_t available = (tail >= head) ? (tail - head) : 0;
+    size_t count = std::min(available, max);
+    if (count == 0) {
+        return 0;
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        Cell& cell = buffer_[(head + i) % cap];
+
+        // Wait until producer published slot: seq == head + i + 1
+        size_t expected = head + i + 1;
+        while (cell.seq.load(std::memory_order_acquire) != expected) {
+            std::this_thread::yield();
+        }
+
+        if (cell.storage.has_value()) {
+            fn(*cell.storage);
+            cell.storage.reset();
+        }
+
+        // Mark slot free for future producers: set seq = head + i + cap
+        cell.seq.store(head + i + cap, std::memory_order_release);
+    }
+
+    // Advance head and update size
+    head_.store(head + count, std::memory_order_release);
+    size_.fetch_sub(count, std::memory_order_acq_rel);
+
+    return count;
+}
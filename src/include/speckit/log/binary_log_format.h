@@ -0,0 +1,122 @@
+// Compact binary log file format and its encoder/decoder
+// Lets the writer skip text formatting; speckit-decode renders the text offline
+
+#pragma once
+
+#include <cstdint>
+#include <istream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "log_entry.h"
+#include "log_level.h"
+#include "platform.h"
+
+/// Binary log file layout (all fixed-width integers little-endian)
+///
+///   File header  "SPKBLOG\0" magic, u32 version, u64 pid, i64 wall clock (ms since
+///                epoch) and i64 steady clock (ns) read together when the file opened.
+///   Tag record   kRecordTag, varint id, varint length, bytes
+///   Thread rec.  kRecordThread, varint index, varint length, thread ID text
+///   Entry record kRecordEntry, flags (level | kFlagDeferred | kFlagProcessId |
+///                kFlagFields), zigzag varint timestamp delta (ms), varint tag id,
+///                varint thread index, [varint pid], varint message length, raw
+///                message bytes, [varint fields length, encoded fields]
+///
+/// Tags and threads are defined once per file, before their first entry, and then
+/// referenced by small ids. Timestamps are deltas from the previous entry (the first
+/// one from the header's wall clock). A header may appear again mid-file (e.g. a
+/// process appending to an existing file); it resets all per-file state.
+/// Deferred printf-style messages are stored as captured and rendered on decode.
+struct BinaryFileHeader {
+    static constexpr char kMagic[8] = {'S', 'P', 'K', 'B', 'L', 'O', 'G', '\0'};
+    static constexpr uint32_t kVersion = 1;
+    static constexpr size_t kSize = sizeof(kMagic) + 4 + 8 + 8 + 8;
+
+    uint32_t version = kVersion;
+    uint64_t process_id = 0;
+    int64_t wall_clock_ms = 0;     ///< system_clock at file open
+    int64_t steady_clock_ns = 0;   ///< steady_clock at the same instant, for calibration
+
+    /// Header for a file opened now by @p process_id
+    static BinaryFileHeader now(ProcessIdType process_id);
+
+    /// Append the encoded header to @p out
+    void encode(std::string& out) const;
+};
+
+/// Stateful per-file encoder of LogEntry records
+/// Single-threaded; call reset() whenever a new file (header) starts.
+class BinaryLogEncoder {
+public:
+    enum : uint8_t {
+        kRecordEntry = 0x01,
+        kRecordTag = 0x02,
+        kRecordThread = 0x03,
+        kRecordHeader = static_cast<uint8_t>(BinaryFileHeader::kMagic[0])
+    };
+    enum : uint8_t {
+        kFlagLevelMask = 0x0f,
+        kFlagFields = 0x20,     ///< Structured fields follow the message
+        kFlagProcessId = 0x40,  ///< Entry pid differs from the header's
+        kFlagDeferred = 0x80    ///< Message is a capturePrintf() record
+    };
+
+    /// Forget all tags, threads and the timestamp base
+    /// @param header Header that starts the file being encoded
+    void reset(const BinaryFileHeader& header);
+
+    /// Append @p entry (and any tag/thread definitions it needs) to @p out
+    void encode(const LogEntry& entry, std::string& out);
+
+private:
+    struct StringHash {
+        using is_transparent = void;
+        size_t operator()(std::string_view value) const { return std::hash<std::string_view>{}(value); }
+    };
+
+    std::unordered_map<std::string, uint32_t, StringHash, std::equal_to<>> tags_;
+    std::unordered_map<ThreadIdType, uint32_t> threads_;
+    int64_t last_timestamp_ms_ = 0;
+    uint64_t process_id_ = 0;
+};
+
+/// Streaming decoder that renders binary log records as formatLogEntry text
+class BinaryLogDecoder {
+public:
+    enum class Status {
+        kLine,   ///< A line was decoded
+        kEnd,    ///< Clean end of input
+        kError   ///< Malformed or truncated input; see error()
+    };
+
+    /// @param in Binary log stream, positioned at a file header
+    explicit BinaryLogDecoder(std::istream& in);
+
+    /// Decode the next entry
+    /// @param line Receives the formatted line, including the trailing newline
+    Status next(std::string& line);
+
+    /// @return Description of the last kError
+    const std::string& error() const { return error_; }
+
+    /// @return Most recently read file header
+    const BinaryFileHeader& header() const { return header_; }
+
+private:
+    bool readHeader();
+    bool readVarint(uint64_t& value);
+    bool readBytes(std::string& out, uint64_t length);
+    Status fail(std::string message);
+
+    std::istream& in_;
+    BinaryFileHeader header_;
+    bool have_header_ = false;
+    std::vector<std::string> tags_;
+    std::vector<std::string> threads_;
+    int64_t last_timestamp_ms_ = 0;
+    std::string message_;
+    std::string fields_;
+    std::string error_;
+};
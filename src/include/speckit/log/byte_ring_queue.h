@@ -0,0 +1,167 @@
+// Variable-length byte ring (bip-buffer) MPSC queue for log records
+// Records are stored inline in one contiguous byte ring sized by a memory budget
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <string_view>
+#include "log_entry.h"
+
+/// Lock-free MPSC queue of variable-length records in a single byte ring
+///
+/// Each record is an 8-byte header (commit state + payload length) followed by its
+/// payload, padded to 8 bytes. A record never straddles the end of the ring: when it
+/// would, the producer also reserves the tail of the ring and fills it with a padding
+/// record, and the record itself starts again at offset 0 (bip-buffer style).
+///
+/// Producers reserve space with a CAS on the tail counter, write the payload in place
+/// and commit by publishing the header state. The consumer walks committed records in
+/// place, in reservation order, stopping at the first one that is still being written,
+/// and zeroes the bytes it consumed before handing them back to producers.
+///
+/// The capacity is a memory budget in bytes (rounded up to a power of two) rather
+/// than an entry count, so short lines cost only their own size and long messages are
+/// held inline. Records up to maxRecordBytes() are always accepted by an empty queue.
+class ByteRingQueue {
+public:
+    static constexpr size_t kAlignment = 8;   ///< Record alignment inside the ring
+    static constexpr size_t kHeaderSize = 8;  ///< Bytes of header before each payload
+    static constexpr size_t kMinCapacity = 64;
+
+    /// @param budget_bytes Memory budget; rounded up to a power of two (at least kMinCapacity)
+    explicit ByteRingQueue(size_t budget_bytes);
+    ~ByteRingQueue() = default;
+
+    ByteRingQueue(const ByteRingQueue&) = delete;
+    ByteRingQueue& operator=(const ByteRingQueue&) = delete;
+
+    /// Reserve @p length contiguous payload bytes
+    /// The record is invisible to the consumer until commit() is called.
+    /// @param length Payload size in bytes
+    /// @return Pointer to the payload, or nullptr if there is not enough free space
+    char* reserve(size_t length);
+
+    /// Publish a record obtained from reserve()
+    /// @param payload Pointer returned by reserve()
+    void commit(char* payload);
+
+    /// Copy @p record into the ring as one record
+    /// @return false if there is not enough free space
+    bool tryPush(std::string_view record);
+
+    /// Encode @p entry (fixed fields, tag, message and structured fields) as one record
+    /// @return false if there is not enough free space
+    bool tryPushEntry(const LogEntry& entry);
+
+    /// Single-consumer: pass up to @p max committed records to fn(std::string_view) in place
+    /// The view is valid only during the call.
+    /// @return Number of records consumed
+    template <typename F>
+    size_t drain(F&& fn, size_t max = std::numeric_limits<size_t>::max());
+
+    /// Single-consumer: like drain(), but decodes records written by tryPushEntry()
+    /// and passes a non-owning LogEntry whose tag and message point into the ring.
+    /// @return Number of entries consumed
+    template <typename F>
+    size_t drainEntries(F&& fn, size_t max = std::numeric_limits<size_t>::max());
+
+    /// Rebuild a non-owning entry from a record written by tryPushEntry(), e.g. one
+    /// that drain() handed out and the caller copied
+    /// The entry's tag, message and fields point into @p record.
+    static LogEntry decodeEntry(std::string_view record);
+
+    /// @return true if nothing is reserved or queued
+    bool isEmpty() const;
+
+    /// Bytes reserved and not yet consumed, including headers and padding
+    size_t sizeBytes() const;
+
+    /// @return Power-of-two capacity in bytes
+    size_t capacityBytes() const;
+
+    /// Largest payload that is guaranteed to fit once the queue drains
+    size_t maxRecordBytes() const;
+
+    /// Ring bytes taken by a record with a @p length byte payload
+    static constexpr size_t recordBytes(size_t length) {
+        return (kHeaderSize + length + kAlignment - 1) & ~(kAlignment - 1);
+    }
+
+private:
+    enum : uint32_t {
+        kStateEmpty = 0,      ///< Not committed yet (or never written)
+        kStateCommitted = 1,  ///< Payload is complete
+        kStatePadding = 2     ///< Filler up to the end of the ring
+    };
+
+    /// Fixed-size part of an encoded LogEntry, followed by tag and message bytes
+    struct EntryPrefix {
+        int64_t timestamp_ms;
+        ProcessIdType process_id;
+        ThreadIdType thread_id;
+        uint32_t tag_size;
+        uint32_t message_size;
+        uint32_t fields_size;
+        LogLevel level;
+        bool deferred;
+    };
+
+    /// Read the header at ring offset @p pos
+    /// @param state Receives the commit state (acquire)
+    /// @param length Receives the payload length
+    /// @return Pointer to the payload
+    const char* peek(size_t pos, uint32_t& state, uint32_t& length) const;
+
+    /// Zero @p bytes consumed from @p head and return them to producers
+    void release(size_t head, size_t bytes);
+
+    std::unique_ptr<uint64_t[]> words_;  ///< Ring storage, 8-byte aligned and zero-filled
+    char* bytes_;                        ///< words_ viewed as bytes
+    const size_t capacity_;
+    const size_t mask_;
+
+    alignas(64) std::atomic<size_t> tail_{0};  ///< Next byte to reserve (producers)
+    alignas(64) std::atomic<size_t> head_{0};  ///< Next byte to consume (consumer)
+};
+
+template <typename F>
+size_t ByteRingQueue::drain(F&& fn, size_t max) {
+    const size_t head = head_.load(std::memory_order_relaxed);
+    const size_t tail = tail_.load(std::memory_order_acquire);
+
+    size_t consumed = 0;
+    size_t records = 0;
+    while (head + consumed != tail && records < max) {
+        const size_t pos = (head + consumed) & mask_;
+        uint32_t state = kStateEmpty;
+        uint32_t length = 0;
+        const char* payload = peek(pos, state, length);
+        if (state == kStateEmpty) {
+            break;  // Reserved but not committed yet; keep reservation order
+        }
+        if (state == kStatePadding) {
+            consumed += capacity_ - pos;
+            continue;
+        }
+        fn(std::string_view(payload, length));
+        consumed += recordBytes(length);
+        ++records;
+    }
+
+    if (consumed > 0) {
+        release(head, consumed);
+    }
+    return records;
+}
+
+template <typename F>
+size_t ByteRingQueue::drainEntries(F&& fn, size_t max) {
+    return drain([&fn](std::string_view record) {
+        const LogEntry entry = decodeEntry(record);
+        fn(entry);
+    }, max);
+}
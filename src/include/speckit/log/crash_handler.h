@@ -5,29 +5,58 @@
 
 #include <functional>
 #include <atomic>
+#include <memory>
 #include <string>
 #include <thread>
 #include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include "platform.h"
 
+#ifndef SPECKIT_PLATFORM_WINDOWS
+#include <signal.h>
+#endif
 
 
 /// Crash handler for emergency log flush
 /// Registers signal handlers and triggers callback on crash
+///
+/// On POSIX the signal handler is async-signal-safe: it only replays bytes the
+/// writer thread has staged (already formatted, not yet handed to the OS) into a
+/// pre-opened file descriptor with write(2). No allocation, formatting or locking
+/// happens inside the handler, and the time spent there is bounded.
+/// Replay is idempotent: staged bytes that already reached the file before the
+/// signal arrived are skipped, so a crash in the middle of a write duplicates nothing.
+/// Only signals that end the process are replayed: SIGTERM or SIGABRT with an
+/// application handler installed before ours goes straight to that handler, with
+/// nothing written, and crash replay stays armed afterwards.
 class CrashHandler {
 public:
     /// Type for emergency flush callback
     using FlushCallback = std::function<void()>;
 
+    /// Default size of the pre-allocated emergency staging buffer
+    static constexpr size_t kDefaultEmergencyBufferSize = 256 * 1024;
+
+    /// Upper bound for time spent writing inside the signal handler
+    static constexpr std::chrono::milliseconds kEmergencyWriteBudget{200};
+
+    /// Most instances (loggers) whose staged bytes the signal handler replays at once.
+    /// Further instances get no replay until an earlier one is destroyed; see
+    /// hasEmergencySlot().
+    static constexpr size_t kMaxEmergencyBuffers = 8;
+
     /// Constructor
-    CrashHandler();
-    
+    /// @param emergency_buffer_size Bytes pre-allocated for staged output
+    explicit CrashHandler(size_t emergency_buffer_size = kDefaultEmergencyBufferSize);
+
     /// Destructor - unregisters signal handlers
     ~CrashHandler();
-    
+
     /// Set the emergency flush callback
     /// @param callback Function to call on crash
     void setFlushCallback(FlushCallback callback);
-    
+
     /// Trigger emergency flush manually
     static void emergencyFlush();
 
@@ -37,9 +66,57 @@ public:
     /// Stop background monitor thread.
     void stopMonitor();
 
+    /// Attach the file that receives staged bytes on crash.
+    /// The descriptor is duplicated, so the caller keeps ownership of @p fd.
+    /// Call again after the log file is rotated.
+    /// @param fd Open file descriptor of the current log file
+    /// @return true if the descriptor was duplicated successfully
+    bool attachEmergencyFile(int fd);
+
+    /// Copy formatted bytes into the pre-allocated staging buffer.
+    /// Must be called by a single writer before the bytes are handed to the OS, and
+    /// only the writer may append to the attached file until they are committed;
+    /// the file's size when staging starts is where the replay resumes.
+    /// Bytes beyond the buffer capacity are not recoverable on crash.
+    /// @param data Formatted log output
+    /// @param size Number of bytes
+    /// @return Number of bytes staged; less than @p size if the buffer is full
+    size_t stageEmergencyBytes(const char* data, size_t size);
+
+    /// Mark staged bytes as written; they will not be replayed on crash.
+    void commitEmergencyBytes();
+
+    /// @return true if the signal handler replays this instance's staged bytes;
+    ///         false if kMaxEmergencyBuffers other instances held every slot when it was created
+    bool hasEmergencySlot() const;
+
+    /// Install an alternate signal stack for the calling thread so stack
+    /// overflows can still be handled. The thread that creates the first CrashHandler,
+    /// AsyncLogger's writer thread and FormatPipeline's I/O thread get one automatically;
+    /// any other application thread has to call this itself.
+    /// @return true if the alternate stack is active for this thread
+    static bool installAltStackForCurrentThread();
+
 private:
+    /// Pre-allocated, lock-free staging area read by the signal handler
+    struct EmergencyBuffer {
+        std::unique_ptr<char[]> data;       ///< Pre-allocated bytes
+        size_t capacity = 0;                ///< Size of data
+        std::atomic<size_t> staged{0};      ///< Bytes staged and not yet committed
+        std::atomic<int64_t> file_offset{-1};  ///< File size when staging began; -1 if unknown
+        std::atomic<int> fd{-1};            ///< Duplicated log file descriptor
+    };
+
+#ifdef SPECKIT_PLATFORM_WINDOWS
     /// Static crash signal handler
     static void signalHandler(int signal);
+#else
+    /// Static crash signal handler; chains to the previous handler of non-fatal signals
+    static void signalHandler(int signal, siginfo_t* info, void* context);
+#endif
+
+    /// Write every staged buffer to its file. Async-signal-safe.
+    static void drainEmergencyBuffers();
 
     /// Initialize signal handlers
     void initializeHandlers();
@@ -50,10 +127,13 @@ private:
     static FlushCallback flush_callback_;          ///< Emergency flush callback
     static std::atomic<bool> initialized_;        ///< Handler initialization state
     static std::atomic<bool> flush_requested_;    ///< Flag set by signal handler to request flush
+    static std::atomic<int> handler_state_;       ///< 0 idle, 1 draining, 2 drained
+    static std::atomic<EmergencyBuffer*> emergency_buffers_[kMaxEmergencyBuffers];
+
+    EmergencyBuffer emergency_;                   ///< This instance's staging area
+    bool has_slot_ = false;                       ///< emergency_ is in emergency_buffers_
 
     // Background monitor thread that performs async flush when flush_requested_ is set.
     std::thread monitor_thread_;
     std::atomic<bool> stop_monitor_{false};
 };
-
-
@@ -7,6 +7,9 @@
 #include <vector>
 #include <memory>
 #include "platform.h"
+#include "binary_log_format.h"
+
+class LoggerMetrics;
 
 #ifdef SPECKIT_PLATFORM_WINDOWS
 #include <windows.h>
@@ -24,10 +27,23 @@
 
 #include <filesystem>
 
+/// On-disk encoding of log files
+enum class LogFileFormat {
+    kText,       ///< formatLogEntry lines in "<base>.log"
+    kBinary,     ///< BinaryLogEncoder records in "<base>.slog"; see speckit-decode
+    kJsonLines   ///< formatLogEntryJson objects, one per line, in "<base>.jsonl"
+};
+
 /// File manager for log file operations
 /// Thread-safe file I/O with rotation support
 class FileManager {
 public:
+    /// Rotation size until SetMaxFileSize()
+    static constexpr size_t kDefaultMaxFileSize = 10 * 1024 * 1024;
+
+    /// Historical files kept until SetRetentionCount()
+    static constexpr size_t kDefaultRetentionCount = 3;
+
     /// Constructor
     /// @param base_name Base name for log files (e.g., "MyApp")
     explicit FileManager(const std::string& base_name);
@@ -61,6 +77,24 @@ public:
     /// @param count Maximum number of historical files
     void SetRetentionCount(size_t count);
 
+    /// Choose the file format. Before Initialize() this only selects the extension;
+    /// afterwards the current file is closed and one with the new extension is opened.
+    /// If that open fails, the old format and file stay in use.
+    /// Binary files start with a BinaryFileHeader, written whenever a file is opened.
+    /// @param format Text or binary
+    /// @return true if successful
+    bool SetOutputFormat(LogFileFormat format);
+
+    /// @return Current file format
+    LogFileFormat GetOutputFormat() const;
+
+    /// Incremented each time a file is opened (initialize, rotate, format switch)
+    /// Binary encoders compare it to know when to reset their per-file state.
+    uint64_t GetFileGeneration() const;
+
+    /// @return Header written at the start of the current binary file
+    const BinaryFileHeader& GetBinaryHeader() const;
+
     /// Get current log file name
     /// @return Full path to current log file
     std::string GetLogFileName() const;
@@ -69,6 +103,18 @@ public:
     /// @return true if successful
     bool Flush();
 
+    /// Hand buffered writes to the OS without forcing them to disk
+    /// @return true if successful
+    bool FlushBuffer();
+
+    /// Get the OS file descriptor of the current log file
+    /// @return File descriptor, or -1 if no file is open
+    int GetFileDescriptor() const;
+
+    /// Record fsync latency and rotations into @p metrics (nullptr disables)
+    /// @param metrics Metrics owned by the caller; must outlive this object
+    void SetMetrics(LoggerMetrics* metrics);
+
 private:
     /// Generate log file name based on process
     /// @param first_process Is this the first process instance?
@@ -109,6 +155,13 @@ private:
     /// @return true if file opened successfully
     bool OpenLogFile();
 
+    /// Bookkeeping for a freshly opened file; writes the binary header if needed
+    /// @return true if successful
+    bool StartFile();
+
+    /// @return ".log", ".slog" or ".jsonl", depending on the format
+    const char* Extension() const;
+
     /// Update the current file size member variable
     void UpdateCurrentFileSize();
 
@@ -141,11 +194,15 @@ private:
     std::string base_name_;              ///< Base name for log files
     ProcessIdType process_id_;           ///< Process ID
     std::string current_file_name_;      ///< Current log file name
-    size_t max_size_ = 10 * 1024 * 1024;  ///< Default 10MB
-    size_t retention_count_ = 3;        ///< Default retain 3 historical files
+    size_t max_size_ = kDefaultMaxFileSize;           ///< Default 10MB
+    size_t retention_count_ = kDefaultRetentionCount;  ///< Default retain 3 historical files
     size_t current_file_size_ = 0;      ///< Current file size
     bool initialized_ = false;          ///< Initialization state
     FILE* file_handle_ = nullptr;       ///< File handle
+    LoggerMetrics* metrics_ = nullptr;  ///< Optional metrics sink
+    LogFileFormat format_ = LogFileFormat::kText;  ///< Encoding of written files
+    BinaryFileHeader binary_header_;    ///< Header of the current binary file
+    uint64_t file_generation_ = 0;      ///< Files opened so far
 #ifdef SPECKIT_PLATFORM_WINDOWS
     HANDLE mutex_handle_;                ///< Handle to the mutex for process synchronization
 #elif defined(SPECKIT_PLATFORM_MACOS)
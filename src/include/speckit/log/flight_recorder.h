@@ -0,0 +1,129 @@
+// In-memory flight recorder for entries below the log level
+// Keeps the most recent ones in binary form and writes them out only when a dump is requested
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <stop_token>
+#include <string>
+#include <thread>
+#include "byte_ring_queue.h"
+#include "format_pipeline.h"
+#include "log_entry.h"
+#include "log_level.h"
+#include "platform.h"
+
+/// Settings for AsyncLogger::enableFlightRecorder()
+struct FlightRecorderOptions {
+    size_t budget_bytes = 8 * 1024 * 1024;            ///< Ring memory; rounded up to a power of two
+    LogLevel dump_level = LogLevel::kLogLevelError;   ///< Logging at or above this requests a dump
+    bool dump_on_level = true;                        ///< Set false to dump only on request or signal
+    std::chrono::milliseconds min_dump_interval{5000};  ///< Least time between dumps requested by level or signal
+    int dump_signal = 0;                              ///< Signal that requests a dump (e.g. SIGUSR2); 0 for none
+    std::string dump_base;                            ///< Dump file base name; empty for the logger's base name
+};
+
+/// Point-in-time flight recorder counters
+struct FlightRecorderStats {
+    uint64_t entries_recorded = 0;  ///< Entries put in the ring
+    uint64_t entries_evicted = 0;   ///< Older entries overwritten to make room
+    uint64_t entries_dumped = 0;    ///< Entries written to dump files
+    uint64_t entries_lost = 0;      ///< Entries too large for the ring, or that lost the race for room
+    uint64_t dumps = 0;             ///< Dump files written
+    size_t bytes_used = 0;          ///< Ring bytes in use
+};
+
+/// Ring of recent entries that the log level kept out of the log file
+///
+/// record() copies an entry into a ByteRingQueue in its binary form (fixed fields,
+/// tag, message, structured fields, printf arguments still captured), so recording
+/// never formats. When the ring is full the recording thread evicts the oldest
+/// entries, at least 1/16 of the ring at a time so eviction is rare.
+///
+/// A dump formats everything recorded, oldest first, into a new file
+/// "<dump_base>.flight.<pid>.<n>.log" with the owning logger's line layout, and
+/// leaves the ring empty. It copies the records out and frees the ring first, then
+/// formats and writes without holding the lock that recording threads may need. dump() does it on
+/// the calling thread. requestDump(), and the signal installed by installSignalHandler(),
+/// only raise a flag for the recorder's own thread, so no log call ever writes a file.
+class FlightRecorder {
+public:
+    /// How often the recorder's thread looks for signal requests
+    static constexpr std::chrono::milliseconds kSignalPollInterval{100};
+
+    /// @param dump_base Base name of the dump files
+    /// @param process_id Goes into the dump file names
+    /// @param options Ring size and dump triggers (dump_signal and dump_base are the caller's)
+    /// @param formatter Layout of dumped lines; see setFormatter()
+    FlightRecorder(const std::string& dump_base, ProcessIdType process_id, const FlightRecorderOptions& options,
+                   FormatPipeline::EntryFormatter formatter = formatLogEntry);
+
+    /// Stops the recorder's thread; nothing is dumped
+    ~FlightRecorder();
+
+    FlightRecorder(const FlightRecorder&) = delete;
+    FlightRecorder& operator=(const FlightRecorder&) = delete;
+
+    /// Copy @p entry into the ring, evicting the oldest entries if needed (any thread)
+    void record(const LogEntry& entry);
+
+    /// Have the recorder's thread dump soon; at most one such dump per min_dump_interval
+    void requestDump();
+
+    /// Set the layout of dumped lines, e.g. when the logger's formatter or output format changes
+    void setFormatter(FormatPipeline::EntryFormatter formatter);
+
+    /// Dump now on the calling thread
+    /// @return Path of the new dump file, or empty if nothing was recorded or it could not be written
+    std::string dump();
+
+    /// @return Level at or above which log calls request a dump
+    LogLevel getDumpLevel() const;
+
+    /// @return true if log calls at getDumpLevel() request dumps
+    bool dumpsOnLevel() const;
+
+    /// @return Point-in-time counters
+    FlightRecorderStats getStats() const;
+
+    /// Make @p signal request a dump from every flight recorder in the process
+    /// The handler only bumps an atomic counter; recorders notice it within kSignalPollInterval.
+    /// @return false if the handler could not be installed
+    static bool installSignalHandler(int signal);
+
+private:
+    void dumpThread(std::stop_token stop_token);
+
+    /// Free at least @p bytes by discarding the oldest entries (takes consumer_mutex_)
+    void evict(size_t bytes);
+
+    ByteRingQueue ring_;
+    const std::string dump_base_;
+    const ProcessIdType process_id_;
+    const FlightRecorderOptions options_;
+    std::atomic<FormatPipeline::EntryFormatter> formatter_;  ///< Layout of dumped lines
+
+    std::mutex consumer_mutex_;                   ///< Single consumer of ring_: eviction and dumps
+    std::mutex dump_mutex_;                       ///< One dump at a time; never taken by log calls
+    uint64_t dump_sequence_ = 0;                  ///< Dumps written (dump_mutex_)
+    std::string dump_records_;                    ///< Records copied out of ring_ by a dump (dump_mutex_)
+
+    std::mutex request_mutex_;
+    std::condition_variable_any request_cv_;
+    std::atomic<bool> dump_requested_{false};
+    uint32_t signals_seen_ = 0;                   ///< Signal count already handled (dump thread)
+    std::chrono::steady_clock::time_point last_requested_dump_{};  ///< Dump thread only
+
+    std::atomic<uint64_t> entries_recorded_{0};
+    std::atomic<uint64_t> entries_evicted_{0};
+    std::atomic<uint64_t> entries_dumped_{0};
+    std::atomic<uint64_t> entries_lost_{0};
+    std::atomic<uint64_t> dumps_{0};
+
+    std::jthread thread_;                         ///< Last: started once everything above exists
+};
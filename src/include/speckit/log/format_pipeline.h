@@ -0,0 +1,121 @@
+// Parallel formatting stage with a single ordered I/O stage
+// Batches are formatted by a thread pool and written strictly in submission order
+
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+#include "log_entry.h"
+#include "log_level.h"
+#include "log_router.h"
+
+/// Where one formatted entry lies within a chunk
+struct FormattedLine {
+    uint32_t offset = 0;   ///< First byte in the chunk
+    uint32_t size = 0;     ///< Bytes, trailing newline included
+    LogLevel level = LogLevel::kLogLevelDebug;
+    uint32_t routes = 0;   ///< Route targets that also get the line (LogRouter::route())
+};
+
+/// Three-stage writer pipeline: drain -> format (parallel) -> write (ordered)
+///
+/// The drain stage (the logger's writer thread) moves entries into a pooled batch
+/// obtained from acquireBatch() and hands it back with submitBatch(), which stamps it
+/// with the next sequence number. Formatter threads render batches in parallel into
+/// the batch's own reusable chunk buffers. A single I/O thread passes the chunks to
+/// the writer callback strictly in sequence order, so the output is identical to
+/// formatting on one thread.
+///
+/// The number of batches in flight is bounded by the pool; acquireBatch() blocks
+/// while every batch is being formatted or written, which throttles the drain stage
+/// to the speed of the slower of the two later stages.
+class FormatPipeline {
+public:
+    /// Receives each formatted chunk, in order, on the I/O thread
+    using ChunkWriter = std::function<void(const std::string&)>;
+
+    /// Same, with the position and level of every entry in the chunk
+    using LineChunkWriter = std::function<void(const std::string&, std::span<const FormattedLine>)>;
+
+    /// Renders one entry; must be safe to call from several threads at once
+    using EntryFormatter = std::string (*)(const LogEntry&);
+
+    /// @param formatter_threads Number of formatter threads (at least 1)
+    /// @param batch_entries Capacity of each batch
+    /// @param chunk_bytes Formatted bytes per chunk handed to @p writer
+    /// @param writer Called for every chunk; only ever from the I/O thread
+    FormatPipeline(size_t formatter_threads, size_t batch_entries, size_t chunk_bytes, ChunkWriter writer);
+
+    /// As above, for a writer that also needs the line boundaries of each chunk
+    FormatPipeline(size_t formatter_threads, size_t batch_entries, size_t chunk_bytes, LineChunkWriter writer);
+
+    /// Writes everything submitted so far, then stops all threads
+    ~FormatPipeline();
+
+    FormatPipeline(const FormatPipeline&) = delete;
+    FormatPipeline& operator=(const FormatPipeline&) = delete;
+
+    /// Drain stage: get the next free batch to fill, blocking while none is free
+    /// Must be followed by submitBatch(). Single caller at a time.
+    /// @return Entry slots of the batch
+    std::span<LogEntry> acquireBatch();
+
+    /// Drain stage: queue the acquired batch for formatting
+    /// @param count Number of leading entries that were filled; 0 returns the batch unused
+    /// @param formatter Formatter for the entries of this batch
+    /// @param router Routing rules for FormattedLine::routes; nullptr leaves them 0.
+    ///        Must stay alive until the batch is written (see waitIdle()).
+    void submitBatch(size_t count, EntryFormatter formatter = formatLogEntry,
+                     const LogRouter* router = nullptr);
+
+    /// Block until every submitted batch has been written
+    void waitIdle();
+
+    /// @return Number of formatter threads
+    size_t formatterThreads() const;
+
+private:
+    struct Batch {
+        uint64_t sequence = 0;
+        std::vector<LogEntry> entries;
+        size_t count = 0;
+        EntryFormatter formatter = formatLogEntry;
+        const LogRouter* router = nullptr;
+        std::vector<std::string> chunks;  ///< Reused formatted output, chunk_count in use
+        std::vector<std::vector<FormattedLine>> chunk_lines;  ///< Entries of each chunk
+        size_t chunk_count = 0;
+    };
+
+    void formatterThread();
+    void ioThread();
+
+    /// Render batch->entries into batch->chunks and release the entries' payloads
+    void format(Batch& batch);
+
+    const size_t chunk_bytes_;
+    LineChunkWriter writer_;
+
+    std::vector<std::unique_ptr<Batch>> pool_;
+    std::mutex mutex_;
+    std::condition_variable free_cv_;    ///< A batch was returned or the pipeline drained
+    std::condition_variable work_cv_;    ///< A batch was submitted for formatting
+    std::condition_variable ready_cv_;   ///< A batch finished formatting
+    std::deque<Batch*> free_;            ///< Batches available to the drain stage
+    std::deque<Batch*> pending_;         ///< Submitted, waiting for a formatter
+    std::vector<Batch*> ready_;          ///< Formatted, indexed by sequence % pool size
+    Batch* current_ = nullptr;           ///< Acquired by the drain stage
+    uint64_t next_sequence_ = 0;         ///< Sequence of the next submitted batch
+    uint64_t written_sequence_ = 0;      ///< Batches fully written
+    bool stopping_ = false;
+
+    std::vector<std::thread> formatters_;
+    std::thread io_thread_;
+};
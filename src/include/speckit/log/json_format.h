@@ -0,0 +1,32 @@
+// JSON Lines formatting for log entries
+// One JSON object per line, for pipelines that ingest JSON instead of parsing text
+
+#pragma once
+
+#include <string>
+#include <string_view>
+#include "log_entry.h"
+
+/// Format a log entry as one JSON object followed by '\n'
+///
+///   {"ts":1700000000123,"level":"INFO","pid":4242,"tid":"1234","tag":"Network",
+///    "msg":"connected","fields":{"user_id":42,"latency_us":1234}}
+///
+/// "ts" is milliseconds since the epoch; "fields" is present only for entries
+/// logged with structured fields. Non-finite doubles are written as null.
+/// @param entry The log entry to format
+/// @return Formatted JSON line
+std::string formatLogEntryJson(const LogEntry& entry);
+
+namespace speckit {
+namespace log {
+
+/// Append @p text as the body of a JSON string (without the surrounding quotes)
+/// Quotes, backslashes and control characters are escaped, and well-formed UTF-8
+/// sequences are copied unchanged; each other byte becomes U+FFFD, so the output is
+/// always valid UTF-8. Runs of plain ASCII are found 16 bytes at a time with SSE2 or
+/// NEON where available.
+void appendJsonEscaped(std::string& out, std::string_view text);
+
+}  // namespace log
+}  // namespace speckit
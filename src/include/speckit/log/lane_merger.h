@@ -0,0 +1,44 @@
+// Drain source over a priority lane and a bulk lane
+// Used by AsyncLogger so WARNING/ERROR entries never wait behind a DEBUG flood
+
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <vector>
+#include "log_entry.h"
+#include "tuned_async_queue.h"
+
+/// Single consumer of two TunedAsyncQueues, drained as one
+///
+/// Each batch takes everything the priority lane holds first and fills the rest
+/// from the bulk lane, so a backlog of low-level entries cannot delay important
+/// ones by more than one batch. Within a batch the two lanes are merged back into
+/// timestamp order; the batch is the reordering window, so an entry is never
+/// written after a later batch. Equal timestamps keep the bulk entry first, since
+/// AsyncLogger only uses the priority lane once the bulk lane is full.
+class LaneMerger {
+public:
+    /// @param priority Lane drained first
+    /// @param bulk Lane filling the rest of each batch
+    LaneMerger(TunedAsyncQueue& priority, TunedAsyncQueue& bulk);
+
+    LaneMerger(const LaneMerger&) = delete;
+    LaneMerger& operator=(const LaneMerger&) = delete;
+
+    /// Single-consumer: move up to out.size() entries into a caller-owned buffer
+    /// @param out Reusable destination; existing elements are move-assigned over
+    /// @return Number of entries written to the front of @p out, in timestamp order
+    size_t drainInto(std::span<LogEntry> out);
+
+    /// @return Entries queued in both lanes
+    size_t size() const;
+
+    /// @return true if both lanes are empty
+    bool isEmpty() const;
+
+private:
+    TunedAsyncQueue& priority_;
+    TunedAsyncQueue& bulk_;
+    std::vector<LogEntry> merge_buffer_;  ///< Priority entries set aside while merging
+};
@@ -0,0 +1,263 @@
+// Compile-time line pattern formatter
+// The pattern is parsed by constexpr code; formatting runs a fixed sequence of field writers
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <string>
+#include <string_view>
+#include <utility>
+#include "log_entry.h"
+
+namespace speckit {
+namespace log {
+
+/// Pattern text usable as a template argument: LinePattern<"%L %m">
+template <size_t N>
+struct PatternString {
+    char chars[N] = {};
+
+    constexpr PatternString(const char (&text)[N]) {
+        for (size_t i = 0; i < N; ++i) {
+            chars[i] = text[i];
+        }
+    }
+
+    constexpr std::string_view view() const { return std::string_view(chars, N - 1); }
+};
+
+/// What one step of a parsed pattern writes
+enum class PatternField : uint8_t {
+    kLiteral,
+    kLevel,      ///< %L
+    kProcessId,  ///< %P
+    kThreadId,   ///< %t
+    kTag,        ///< %g
+    kMessage,    ///< %m, including printf rendering and structured fields
+    kYear,       ///< %Y inside %T{...}
+    kMonth,      ///< %m inside %T{...}
+    kDay,        ///< %d inside %T{...}
+    kHour,       ///< %H inside %T{...}
+    kMinute,     ///< %M inside %T{...}
+    kSecond,     ///< %S inside %T{...}
+    kMillis,     ///< %f inside %T{...}
+};
+
+struct PatternStep {
+    PatternField field = PatternField::kLiteral;
+    uint16_t offset = 0;  ///< Literal text in ParsedPattern::text
+    uint16_t length = 0;
+};
+
+/// Result of parsePattern(); N bounds both the steps and the literal text
+template <size_t N>
+struct ParsedPattern {
+    std::array<PatternStep, N> steps{};
+    size_t step_count = 0;
+    std::array<char, N> text{};
+    size_t text_size = 0;
+    bool needs_time = false;
+    bool needs_message = false;
+
+    constexpr void addLiteral(char c) {
+        text[text_size] = c;
+        if (step_count > 0 && steps[step_count - 1].field == PatternField::kLiteral &&
+            steps[step_count - 1].offset + steps[step_count - 1].length == text_size) {
+            ++steps[step_count - 1].length;  // Extend the previous literal
+        } else {
+            steps[step_count++] = PatternStep{PatternField::kLiteral, static_cast<uint16_t>(text_size), 1};
+        }
+        ++text_size;
+    }
+
+    constexpr void addField(PatternField field) {
+        steps[step_count++] = PatternStep{field, 0, 0};
+        needs_time = needs_time || field >= PatternField::kYear;
+        needs_message = needs_message || field == PatternField::kMessage;
+    }
+};
+
+/// Layout %T expands to when it has no {...}: YYYY-MM-DD HH:MM:SS.mmm
+inline constexpr std::string_view kDefaultTimePattern = "%Y-%m-%d %H:%M:%S.%f";
+
+/// Upper bound on steps and literal bytes for a pattern of @p pattern_size characters
+constexpr size_t patternCapacity(size_t pattern_size) {
+    return pattern_size + kDefaultTimePattern.size() * (pattern_size / 2 + 1);
+}
+
+/// Report a malformed pattern; not a constant expression, so it fails the build
+inline void invalidPattern(const char* /*reason*/) {}
+
+template <size_t N>
+constexpr void parseTimePattern(std::string_view pattern, ParsedPattern<N>& parsed) {
+    for (size_t i = 0; i < pattern.size(); ++i) {
+        if (pattern[i] != '%') {
+            parsed.addLiteral(pattern[i]);
+            continue;
+        }
+        if (++i == pattern.size()) {
+            invalidPattern("pattern ends with %");
+            return;
+        }
+        switch (pattern[i]) {
+        case 'Y': parsed.addField(PatternField::kYear); break;
+        case 'm': parsed.addField(PatternField::kMonth); break;
+        case 'd': parsed.addField(PatternField::kDay); break;
+        case 'H': parsed.addField(PatternField::kHour); break;
+        case 'M': parsed.addField(PatternField::kMinute); break;
+        case 'S': parsed.addField(PatternField::kSecond); break;
+        case 'f': parsed.addField(PatternField::kMillis); break;
+        case '%': parsed.addLiteral('%'); break;
+        default: invalidPattern("unknown %T{...} directive"); return;
+        }
+    }
+}
+
+/// Parse a line pattern
+///
+/// Directives: %L level, %T timestamp (%T{...} with %Y %m %d %H %M %S %f for a custom
+/// layout), %P process ID, %t thread ID, %g tag, %m message, %% a literal percent.
+/// Everything else is copied. A newline is always appended to the line.
+template <size_t N>
+constexpr ParsedPattern<N> parsePattern(std::string_view pattern) {
+    ParsedPattern<N> parsed;
+    for (size_t i = 0; i < pattern.size(); ++i) {
+        if (pattern[i] != '%') {
+            parsed.addLiteral(pattern[i]);
+            continue;
+        }
+        if (++i == pattern.size()) {
+            invalidPattern("pattern ends with %");
+            break;
+        }
+        switch (pattern[i]) {
+        case 'L': parsed.addField(PatternField::kLevel); break;
+        case 'P': parsed.addField(PatternField::kProcessId); break;
+        case 't': parsed.addField(PatternField::kThreadId); break;
+        case 'g': parsed.addField(PatternField::kTag); break;
+        case 'm': parsed.addField(PatternField::kMessage); break;
+        case '%': parsed.addLiteral('%'); break;
+        case 'T':
+            if (i + 1 < pattern.size() && pattern[i + 1] == '{') {
+                const size_t close = pattern.find('}', i + 2);
+                if (close == std::string_view::npos) {
+                    invalidPattern("unterminated %T{");
+                    return parsed;
+                }
+                parseTimePattern(pattern.substr(i + 2, close - i - 2), parsed);
+                i = close;
+            } else {
+                parseTimePattern(kDefaultTimePattern, parsed);
+            }
+            break;
+        default:
+            invalidPattern("unknown directive");
+            return parsed;
+        }
+    }
+    return parsed;
+}
+
+/// Broken-down local time of one entry
+struct PatternTime {
+    std::tm tm;
+    int millis;
+};
+
+/// Local time for @p timestamp_ms; localtime is only called when the second changes
+/// Cached per thread, so formatter threads do not contend.
+const PatternTime& patternLocalTime(int64_t timestamp_ms);
+
+/// Append @p value in decimal, zero-padded to @p width digits
+void appendPaddedDecimal(std::string& out, unsigned value, int width);
+
+/// Append @p value in decimal
+void appendDecimal(std::string& out, uint64_t value);
+
+/// Append a thread ID the way threadIdToString renders it
+void appendThreadId(std::string& out, ThreadIdType thread_id);
+
+}  // namespace log
+}  // namespace speckit
+
+/// Line formatter for a pattern fixed at compile time
+///
+/// The pattern is parsed while compiling; format() is an unrolled sequence of
+/// field writers with no runtime interpretation. It has the signature of
+/// formatLogEntry, so it can be handed to AsyncLogger::setLineFormatter():
+///
+///     logger->setLineFormatter(LinePattern<"%L %T{%H:%M:%S.%f} [%t] [%g] %m">::format);
+///
+/// A malformed pattern fails to compile.
+template <speckit::log::PatternString Pattern>
+class LinePattern {
+public:
+    /// Format one entry, including the trailing newline
+    static std::string format(const LogEntry& entry) {
+        std::string scratch;
+        std::string_view message;
+        if constexpr (kParsed.needs_message) {
+            message = resolveMessage(entry, scratch);
+        }
+        const speckit::log::PatternTime* time = nullptr;
+        if constexpr (kParsed.needs_time) {
+            time = &speckit::log::patternLocalTime(entry.timestamp_ms);
+        }
+
+        std::string out;
+        out.reserve(kParsed.text_size + 64 + entry.tag.size() + message.size());
+        [&]<size_t... I>(std::index_sequence<I...>) {
+            (writeStep<I>(out, entry, message, time), ...);
+        }(std::make_index_sequence<kParsed.step_count>{});
+        out.push_back('\n');
+        return out;
+    }
+
+    /// @return The pattern text
+    static constexpr std::string_view pattern() { return Pattern.view(); }
+
+private:
+    static constexpr auto kParsed =
+        speckit::log::parsePattern<speckit::log::patternCapacity(sizeof(Pattern.chars))>(Pattern.view());
+
+    template <size_t I>
+    static void writeStep(std::string& out, const LogEntry& entry, std::string_view message,
+                          const speckit::log::PatternTime* time) {
+        using speckit::log::PatternField;
+        constexpr speckit::log::PatternStep step = kParsed.steps[I];
+
+        if constexpr (step.field == PatternField::kLiteral) {
+            out.append(kParsed.text.data() + step.offset, step.length);
+        } else if constexpr (step.field == PatternField::kLevel) {
+            out.append(levelToString(entry.level));
+        } else if constexpr (step.field == PatternField::kProcessId) {
+            speckit::log::appendDecimal(out, static_cast<uint64_t>(entry.process_id));
+        } else if constexpr (step.field == PatternField::kThreadId) {
+            speckit::log::appendThreadId(out, entry.thread_id);
+        } else if constexpr (step.field == PatternField::kTag) {
+            out.append(entry.tag);
+        } else if constexpr (step.field == PatternField::kMessage) {
+            out.append(message);
+        } else if constexpr (step.field == PatternField::kYear) {
+            speckit::log::appendPaddedDecimal(out, static_cast<unsigned>(time->tm.tm_year + 1900), 4);
+        } else if constexpr (step.field == PatternField::kMonth) {
+            speckit::log::appendPaddedDecimal(out, static_cast<unsigned>(time->tm.tm_mon + 1), 2);
+        } else if constexpr (step.field == PatternField::kDay) {
+            speckit::log::appendPaddedDecimal(out, static_cast<unsigned>(time->tm.tm_mday), 2);
+        } else if constexpr (step.field == PatternField::kHour) {
+            speckit::log::appendPaddedDecimal(out, static_cast<unsigned>(time->tm.tm_hour), 2);
+        } else if constexpr (step.field == PatternField::kMinute) {
+            speckit::log::appendPaddedDecimal(out, static_cast<unsigned>(time->tm.tm_min), 2);
+        } else if constexpr (step.field == PatternField::kSecond) {
+            speckit::log::appendPaddedDecimal(out, static_cast<unsigned>(time->tm.tm_sec), 2);
+        } else if constexpr (step.field == PatternField::kMillis) {
+            speckit::log::appendPaddedDecimal(out, static_cast<unsigned>(time->millis), 3);
+        }
+    }
+};
+
+/// The formatLogEntry layout as a pattern
+using DefaultLinePattern = LinePattern<"[%L] %T [%P, %t] [%g]: %m">;
@@ -3,10 +3,13 @@
 
 #pragma once
 
+#include <algorithm>
 #include <atomic>
 #include <mutex>
 #include <cstdint>
+#include <limits>
 #include <memory>
+#include <span>
 #include <vector>
 #include "log_entry.h"
 
@@ -30,6 +33,20 @@ public:
     /// @return Vector of all log entries currently in buffer
     std::vector<LogEntry> popAll();
 
+    /// Pass up to @p max entries to @p fn in place, oldest first (single consumer)
+    /// Nothing is allocated. The entry's payload is released after @p fn returns,
+    /// so @p fn must move from it if it needs to keep it.
+    /// @param fn Callable invoked as fn(LogEntry&)
+    /// @param max Maximum number of entries to consume
+    /// @return Number of entries consumed
+    template <typename F>
+    size_t drain(F&& fn, size_t max = std::numeric_limits<size_t>::max());
+
+    /// Move up to out.size() entries into a caller-owned, reusable buffer (single consumer)
+    /// @param out Destination; existing elements are move-assigned over
+    /// @return Number of entries written to the front of @p out
+    size_t drainInto(std::span<LogEntry> out);
+
     /// Check if buffer is empty
     /// @return true if buffer has no entries
     bool isEmpty() const;
@@ -48,4 +65,25 @@ private:
     std::atomic<size_t> tail_;                        ///< Index where oldest entry is located
     std::atomic<size_t> size_;                        ///< Current number of entries
     const size_t capacity_;                           ///< Total capacity of buffer
-};
\ No newline at end of file
+};
+
+template <typename F>
+size_t RingBuffer::drain(F&& fn, size_t max) {
+    const size_t count = std::min(size_.load(std::memory_order_acquire), max);
+    if (count == 0) {
+        return 0;
+    }
+
+    const size_t current_tail = tail_.load(std::memory_order_acquire);
+    for (size_t i = 0; i < count; ++i) {
+        LogEntry& entry = buffer_[(current_tail + i) % capacity_];
+        fn(entry);
+        entry.storage.reset();
+    }
+
+    // Release the slots only after they have been read
+    tail_.store((current_tail + count) % capacity_, std::memory_order_release);
+    size_.fetch_sub(count, std::memory_order_acq_rel);
+
+    return count;
+}
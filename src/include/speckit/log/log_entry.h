@@ -4,13 +4,19 @@
 #pragma once
 
 #include <cstdint>
+#include <cstring>
+#include <memory>
 #include <string>
 #include <string_view>
 #include "log_level.h"
 #include "platform.h"
+#include "payload_arena.h"
 
 /// Log entry structure containing all required information
-/// Uses string_view to avoid copying until formatting
+/// Uses string_view to avoid copying until formatting. Entries that outlive the
+/// caller's strings (e.g. queued for the writer thread) must be created with
+/// createOwned(), which keeps tag and message in a single owned payload
+/// carved from PayloadArena.
 struct LogEntry {
     LogLevel level;              ///< Log severity level
     int64_t timestamp_ms;       ///< Timestamp in milliseconds since epoch
@@ -18,6 +24,9 @@ struct LogEntry {
     ThreadIdType thread_id;       ///< Thread ID
     std::string_view tag;      ///< Log category tag
     std::string_view message;   ///< User message
+    std::string_view fields;    ///< Structured fields encoded by speckit::log::encodeFields()
+    std::unique_ptr<char[], PayloadDeleter> storage;  ///< Owned tag + message + fields bytes (createOwned only)
+    bool deferred = false;       ///< message holds a capturePrintf() record, rendered when formatting
 
     /// Constructor with all fields
     LogEntry(LogLevel lvl, int64_t ts, ProcessIdType pid, ThreadIdType tid,
@@ -26,6 +35,25 @@ struct LogEntry {
         tag(tg), message(msg) {
     }
 
+    /// Create an entry that owns a copy of @p tg, @p msg and @p flds
+    /// The views point into arena (or heap) storage, so they stay valid across moves.
+    /// Releasing the storage returns the bytes to the arena.
+    static LogEntry createOwned(LogLevel lvl, int64_t ts, ProcessIdType pid, ThreadIdType tid,
+        std::string_view tg, std::string_view msg, std::string_view flds = {}) {
+        const PayloadAllocation payload =
+            PayloadArena::global().allocate(tg.size() + msg.size() + flds.size() + 1);
+        std::unique_ptr<char[], PayloadDeleter> bytes(payload.data, PayloadDeleter{payload.chunk});
+        std::memcpy(bytes.get(), tg.data(), tg.size());
+        std::memcpy(bytes.get() + tg.size(), msg.data(), msg.size());
+        std::memcpy(bytes.get() + tg.size() + msg.size(), flds.data(), flds.size());
+        LogEntry entry(lvl, ts, pid, tid,
+            std::string_view(bytes.get(), tg.size()),
+            std::string_view(bytes.get() + tg.size(), msg.size()));
+        entry.fields = std::string_view(bytes.get() + tg.size() + msg.size(), flds.size());
+        entry.storage = std::move(bytes);
+        return entry;
+    }
+
     /// Default constructor
     LogEntry() = default;
 
@@ -36,7 +64,10 @@ struct LogEntry {
         process_id(other.process_id),
         thread_id(other.thread_id),
         tag(other.tag),
-        message(other.message) {
+        message(other.message),
+        fields(other.fields),
+        storage(std::move(other.storage)),
+        deferred(other.deferred) {
     }
 
     /// Move assignment
@@ -48,6 +79,9 @@ struct LogEntry {
             thread_id = other.thread_id;
             tag = other.tag;
             message = other.message;
+            fields = other.fields;
+            storage = std::move(other.storage);
+            deferred = other.deferred;
         }
         return *this;
     }
@@ -60,4 +94,23 @@ struct LogEntry {
 /// Format a log entry as a string
 /// @param entry The log entry to format
 /// @return Formatted log entry string
-std::string formatLogEntry(const LogEntry& entry);
\ No newline at end of file
+std::string formatLogEntry(const LogEntry& entry);
+
+/// Message text as formatLogEntry prints it
+/// Renders printf-style entries and appends structured fields as " key=value".
+/// @param entry Log entry
+/// @param scratch Holds the text when it has to be built
+/// @return The message, pointing into @p entry or @p scratch
+std::string_view resolveMessage(const LogEntry& entry, std::string& scratch);
+
+/// Render a thread ID the way formatLogEntry prints it
+/// @param thread_id Thread ID
+/// @return Thread ID text
+std::string threadIdToString(ThreadIdType thread_id);
+
+/// Format already-resolved fields in the formatLogEntry layout
+/// Lets offline decoders reproduce the text exactly from a thread ID string
+/// and an already rendered message.
+/// @return Formatted log line including the trailing newline
+std::string formatLogLine(LogLevel level, int64_t timestamp_ms, ProcessIdType process_id,
+                          std::string_view thread_id, std::string_view tag, std::string_view message);
\ No newline at end of file
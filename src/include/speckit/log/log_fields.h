@@ -0,0 +1,84 @@
+// Structured key-value fields attached to log entries
+// Fields are copied into the entry in a compact binary form and rendered by the formatters
+
+#pragma once
+
+#include <concepts>
+#include <cstdint>
+#include <initializer_list>
+#include <string>
+#include <string_view>
+#include <variant>
+
+namespace speckit {
+namespace log {
+
+/// Typed value of a structured field
+using FieldValue = std::variant<int64_t, uint64_t, double, bool, std::string_view>;
+
+}  // namespace log
+}  // namespace speckit
+
+/// One key-value pair, e.g. {"user_id", 42}
+/// Holds views only; the logger copies key and value before returning.
+struct LogField {
+    std::string_view key;
+    speckit::log::FieldValue value;
+
+    template <std::signed_integral T>
+    LogField(std::string_view k, T v) : key(k), value(static_cast<int64_t>(v)) {}
+
+    template <std::unsigned_integral T>
+        requires(!std::same_as<T, bool>)
+    LogField(std::string_view k, T v) : key(k), value(static_cast<uint64_t>(v)) {}
+
+    template <std::floating_point T>
+    LogField(std::string_view k, T v) : key(k), value(static_cast<double>(v)) {}
+
+    LogField(std::string_view k, bool v) : key(k), value(v) {}
+    LogField(std::string_view k, std::string_view v) : key(k), value(v) {}
+    LogField(std::string_view k, const char* v) : key(k), value(std::string_view(v)) {}
+    LogField(std::string_view k, const std::string& v) : key(k), value(std::string_view(v)) {}
+};
+
+/// Iterates over fields encoded by speckit::log::encodeFields()
+/// Views returned by next() point into the encoded bytes.
+class LogFieldReader {
+public:
+    explicit LogFieldReader(std::string_view encoded) : rest_(encoded) {}
+
+    /// Decode the next field
+    /// @return false at the end or on malformed input (see failed())
+    bool next(std::string_view& key, speckit::log::FieldValue& value);
+
+    /// @return true if decoding stopped on malformed input
+    bool failed() const { return failed_; }
+
+private:
+    std::string_view rest_;
+    bool failed_ = false;
+};
+
+namespace speckit {
+namespace log {
+
+/// Append @p value as an unsigned LEB128 varint
+void appendVarint(std::string& out, uint64_t value);
+
+/// Read an unsigned LEB128 varint from the front of @p in and consume it
+/// @return false if @p in ends early or the encoding is too long
+bool readVarint(std::string_view& in, uint64_t& value);
+
+/// Append the binary form of @p fields to @p out
+/// Layout per field: type byte, varint key length, key, value (zigzag varint for
+/// signed, varint for unsigned, 8 bytes for double, none for bool, varint length
+/// plus bytes for strings).
+void encodeFields(std::initializer_list<LogField> fields, std::string& out);
+
+/// Append encoded fields as text, " key=value" per field
+/// Strings are quoted (with \" and \\ escapes) when empty or containing spaces,
+/// quotes, backslashes or '='.
+void appendFieldsText(std::string& out, std::string_view encoded);
+
+}  // namespace log
+}  // namespace speckit
@@ -0,0 +1,71 @@
+// Per-tag and per-level routing of log lines to extra files
+// Rules are compiled into a table from tag id and level to a bit mask of target files
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "log_level.h"
+#include "metrics.h"
+
+/// An extra log file and the entries copied to it; see AsyncLogger::setRoutes()
+struct RouteTarget {
+    std::string name;                              ///< The file is "<base>.<name>.log"; not all digits
+    std::vector<std::string> tags;                 ///< Entries with one of these tags; empty for any tag
+    LogLevel min_level = LogLevel::kLogLevelDebug;  ///< Entries at or above this level
+    size_t max_file_size = 0;                      ///< Rotation size; 0 for the FileManager default
+    size_t retention_count = 0;                    ///< Rotated files kept; 0 for the FileManager default
+};
+
+/// Routing rules compiled into a lookup table
+///
+/// Every tag named by a rule gets a small id, starting at 1; all other tags share id 0.
+/// The table holds one bit mask per tag id and level, with bit i set if target i takes
+/// such entries, so routing an entry is a tag-to-id lookup followed by one array index.
+/// The tag lookup is skipped when no rule names a tag, and otherwise cached per thread
+/// for the last tag seen, so runs of one tag cost a string compare.
+///
+/// A compiled router never changes; route() may be called from several threads at once.
+class LogRouter {
+public:
+    /// Most targets; one bit each in a route mask
+    static constexpr size_t kMaxTargets = 32;
+
+    /// Compile @p targets. Returns nullptr if there are more than kMaxTargets, or a
+    /// name is empty, all digits (it would clash with rotated files), contains a path
+    /// separator or appears twice.
+    static std::unique_ptr<LogRouter> compile(std::span<const RouteTarget> targets);
+
+    LogRouter(const LogRouter&) = delete;
+    LogRouter& operator=(const LogRouter&) = delete;
+
+    /// @return Bit i set if target i takes an entry with @p tag and @p level
+    uint32_t route(std::string_view tag, LogLevel level) const;
+
+    /// @return The targets, in mask bit order
+    const std::vector<RouteTarget>& targets() const;
+
+private:
+    LogRouter() = default;
+
+    /// Id of @p tag: 1..N for tags named by a rule, 0 for the rest
+    uint32_t tagId(std::string_view tag) const;
+
+    /// Hash that lets lookups take a string_view without building a std::string
+    struct TagHash {
+        using is_transparent = void;
+        size_t operator()(std::string_view tag) const { return std::hash<std::string_view>{}(tag); }
+    };
+
+    std::vector<RouteTarget> targets_;
+    std::unordered_map<std::string, uint32_t, TagHash, std::equal_to<>> tag_ids_;
+    std::vector<uint32_t> masks_;  ///< [tag id * kLogLevelCount + level]
+    uint64_t serial_ = 0;          ///< Unique per router, for the per-thread tag cache
+};
@@ -0,0 +1,192 @@
+// Additional log outputs fed from the writer's formatted batches
+// Each sink runs on its own thread behind a SinkFanout and filters by its own level
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "file_manager.h"
+#include "format_pipeline.h"
+#include "log_level.h"
+
+/// Formatted lines shared by every sink
+/// Filled once by the logger and read concurrently by the sink threads; never
+/// modified after it has been published.
+struct SinkBatch {
+    std::string text;                  ///< Formatted lines, back to back
+    std::vector<FormattedLine> lines;  ///< Each line's position in text and its level
+};
+
+/// An output that receives formatted log lines
+///
+/// write() is only ever called from the sink's own thread, one batch at a time,
+/// so implementations need no locking of their own for the output itself.
+class LogSink {
+public:
+    /// @param min_level Lowest level this sink writes
+    explicit LogSink(LogLevel min_level = LogLevel::kLogLevelDebug);
+    virtual ~LogSink() = default;
+
+    LogSink(const LogSink&) = delete;
+    LogSink& operator=(const LogSink&) = delete;
+
+    /// Write the lines of @p batch at or above getLevel()
+    virtual void write(const SinkBatch& batch) = 0;
+
+    /// Set the lowest level this sink writes; takes effect with the next batch
+    void setLevel(LogLevel level);
+
+    /// @return Lowest level this sink writes
+    LogLevel getLevel() const;
+
+protected:
+    /// Call @p fn(std::string_view) with each run of consecutive lines that pass the level
+    template <typename Fn>
+    void forEachRun(const SinkBatch& batch, Fn&& fn) const {
+        const LogLevel min_level = getLevel();
+        size_t run_begin = 0;
+        size_t run_end = 0;
+        for (const FormattedLine& line : batch.lines) {
+            if (!::shouldLog(line.level, min_level)) {
+                continue;
+            }
+            if (line.offset != run_end) {
+                if (run_end > run_begin) {
+                    fn(std::string_view(batch.text).substr(run_begin, run_end - run_begin));
+                }
+                run_begin = line.offset;
+            }
+            run_end = line.offset + line.size;
+        }
+        if (run_end > run_begin) {
+            fn(std::string_view(batch.text).substr(run_begin, run_end - run_begin));
+        }
+    }
+
+    /// Call @p fn(std::string_view line, LogLevel level) with each line that passes the level
+    template <typename Fn>
+    void forEachLine(const SinkBatch& batch, Fn&& fn) const {
+        const LogLevel min_level = getLevel();
+        for (const FormattedLine& line : batch.lines) {
+            if (::shouldLog(line.level, min_level)) {
+                fn(std::string_view(batch.text).substr(line.offset, line.size), line.level);
+            }
+        }
+    }
+
+private:
+    std::atomic<LogLevel> min_level_;
+};
+
+/// Appends lines to a FileManager-managed file with its own rotation and retention
+class FileSink : public LogSink {
+public:
+    /// Create a sink writing "<base_name>.log". Returns nullptr if the file cannot be opened.
+    /// @param base_name Base name for the files, as for AsyncLogger::create()
+    /// @param min_level Lowest level written
+    static std::shared_ptr<FileSink> create(const std::string& base_name,
+                                            LogLevel min_level = LogLevel::kLogLevelDebug);
+
+    void write(const SinkBatch& batch) override;
+
+    /// The sink's file manager, e.g. for SetMaxFileSize() and SetRetentionCount()
+    FileManager& getFileManager();
+
+    /// @return Path of the file currently being written
+    std::string getLogFileName() const;
+
+private:
+    FileSink(const std::string& base_name, LogLevel min_level);
+
+    FileManager file_manager_;
+    std::string run_;  ///< Reused copy of each run (FileManager::Write takes a std::string)
+};
+
+/// Standard output streams
+enum class ConsoleStream {
+    kStdout,
+    kStderr
+};
+
+/// Writes lines to stdout or stderr, unbuffered by the C library
+class ConsoleSink : public LogSink {
+public:
+    explicit ConsoleSink(ConsoleStream stream = ConsoleStream::kStderr,
+                         LogLevel min_level = LogLevel::kLogLevelDebug);
+
+    void write(const SinkBatch& batch) override;
+
+private:
+    ConsoleStream stream_;
+};
+
+/// Keeps the most recent lines in memory, up to a byte budget
+class MemoryRingSink : public LogSink {
+public:
+    /// @param capacity_bytes Most line bytes kept; older lines are discarded first
+    /// @param min_level Lowest level kept
+    explicit MemoryRingSink(size_t capacity_bytes, LogLevel min_level = LogLevel::kLogLevelDebug);
+
+    void write(const SinkBatch& batch) override;
+
+    /// Copy of the kept lines, oldest first, as formatted (newline included)
+    /// Safe to call from any thread.
+    std::vector<std::string> getLines() const;
+
+    /// @return Bytes currently kept
+    size_t getSizeBytes() const;
+
+private:
+    const size_t capacity_bytes_;
+    mutable std::mutex mutex_;
+    std::deque<std::string> lines_;
+    size_t size_bytes_ = 0;
+};
+
+/// Sends every line as one datagram to a Unix domain socket
+/// Sends never block; lines the receiver is not ready for (no socket bound, buffer
+/// full, too large) are counted in getSendFailures() and discarded. POSIX only.
+class UnixDatagramSink : public LogSink {
+public:
+    /// Create a sink sending to @p socket_path. Returns nullptr if no socket can be
+    /// created or the path is too long. The receiver may be bound later.
+    static std::shared_ptr<UnixDatagramSink> create(const std::string& socket_path,
+                                                    LogLevel min_level = LogLevel::kLogLevelDebug);
+
+    ~UnixDatagramSink() override;
+
+    void write(const SinkBatch& batch) override;
+
+    /// @return Lines that could not be sent
+    uint64_t getSendFailures() const;
+
+private:
+    UnixDatagramSink(int fd, const std::string& socket_path, LogLevel min_level);
+
+    int fd_;
+    std::string socket_path_;
+    std::atomic<uint64_t> send_failures_{0};
+};
+
+/// Calls a user function for every line
+class CallbackSink : public LogSink {
+public:
+    /// Receives one formatted line (newline included) and its level, on the sink's thread
+    using Callback = std::function<void(LogLevel, std::string_view)>;
+
+    explicit CallbackSink(Callback callback, LogLevel min_level = LogLevel::kLogLevelDebug);
+
+    void write(const SinkBatch& batch) override;
+
+private:
+    Callback callback_;
+};
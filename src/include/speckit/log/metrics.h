@@ -0,0 +1,210 @@
+// Runtime metrics for the logging pipeline
+// Lock-free sharded counters and HDR-style histograms, merged on read
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include "log_level.h"
+
+/// Summary of a histogram: count, extremes and selected percentiles
+struct HistogramSummary {
+    uint64_t count = 0;     ///< Number of recorded values
+    uint64_t min = 0;       ///< Smallest recorded value
+    uint64_t max = 0;       ///< Largest recorded value
+    double mean = 0.0;      ///< Arithmetic mean
+    uint64_t p50 = 0;       ///< Median
+    uint64_t p90 = 0;       ///< 90th percentile
+    uint64_t p99 = 0;       ///< 99th percentile
+    uint64_t p999 = 0;      ///< 99.9th percentile
+};
+
+/// HDR-style log-linear histogram of unsigned values (latencies in ns, sizes, ...)
+/// Each power of two is split into 16 linear sub-buckets, giving ~6% relative error
+/// over the full uint64_t range with a fixed 976-bucket footprint.
+/// record() is lock-free and safe to call from any thread.
+class Histogram {
+public:
+    static constexpr unsigned kSubBucketBits = 4;
+    static constexpr uint64_t kSubBucketCount = 1ULL << kSubBucketBits;
+    static constexpr size_t kBucketCount = kSubBucketCount + (64 - kSubBucketBits) * kSubBucketCount;
+
+    Histogram() = default;
+
+    /// Record a single value
+    void record(uint64_t value);
+
+    /// Add all values recorded in another histogram
+    void merge(const Histogram& other);
+
+    /// Discard all recorded values
+    void reset();
+
+    /// Number of recorded values
+    uint64_t count() const;
+
+    /// Value at the given percentile (0-100), reported as the bucket's upper bound
+    uint64_t percentile(double pct) const;
+
+    /// Summarize count, min/max/mean and p50/p90/p99/p99.9
+    HistogramSummary summarize() const;
+
+    /// Map a value to its bucket index
+    static size_t bucketIndex(uint64_t value);
+
+    /// Highest value that maps to the given bucket
+    static uint64_t bucketUpperBound(size_t index);
+
+private:
+    std::array<std::atomic<uint64_t>, kBucketCount> buckets_{};
+    std::atomic<uint64_t> count_{0};
+    std::atomic<uint64_t> sum_{0};
+    std::atomic<uint64_t> min_{UINT64_MAX};
+    std::atomic<uint64_t> max_{0};
+};
+
+/// Number of log levels, for per-level counters indexed by the level's value
+inline constexpr size_t kLogLevelCount = 4;
+
+/// Point-in-time copy of all logger metrics
+struct MetricsSnapshot {
+    uint64_t entries_enqueued = 0;      ///< Entries accepted by log()
+    uint64_t entries_dropped = 0;       ///< Entries discarded by the overflow policy
+    uint64_t entries_rate_limited = 0;  ///< Log calls throttled by a per-tag rate limit
+    uint64_t entries_sampled_out = 0;   ///< DEBUG/INFO lines skipped by a per-tag sample rate
+    uint64_t repeats_collapsed = 0;     ///< Repeated lines replaced by "last message repeated N times"
+    std::array<uint64_t, kLogLevelCount> dropped_by_level{};  ///< entries_dropped split by level
+    uint64_t entries_written = 0;       ///< Entries formatted and written to the file
+    uint64_t bytes_written = 0;         ///< Formatted bytes written to the file
+    uint64_t emergency_bytes_unstaged = 0;  ///< Written bytes too large for the crash replay buffer
+    uint64_t queue_high_water = 0;      ///< Largest queue depth seen by the writer
+    uint64_t batches = 0;               ///< Writer wakeups that found entries
+    uint64_t rotations = 0;             ///< Log file rotations
+    uint64_t writer_parks = 0;          ///< Times the writer slept waiting for a producer wakeup
+    HistogramSummary batch_size;        ///< Entries per writer batch
+    HistogramSummary flush_latency_ns;  ///< Write + hand-off to OS per chunk
+    HistogramSummary fsync_latency_ns;  ///< Durable flush to disk
+    HistogramSummary rotation_ns;       ///< Duration of each rotation
+};
+
+/// Metrics collected by one logger
+/// Counters are sharded per thread on separate cache lines so producers never
+/// contend on a shared counter; reads merge all shards.
+class LoggerMetrics {
+public:
+    /// Monotonic counters
+    enum class Counter : size_t {
+        kEntriesEnqueued = 0,
+        kEntriesDropped,
+        kEntriesWritten,
+        kBytesWritten,
+        kBatches,
+        kRotations,
+        kWriterParks,
+        kDroppedDebug,     ///< Per-level drops, in LogLevel order; see addDropped()
+        kDroppedInfo,
+        kDroppedWarning,
+        kDroppedError,
+        kEntriesRateLimited,
+        kRepeatsCollapsed,
+        kEntriesSampledOut,
+        kEmergencyBytesUnstaged,
+        kCount
+    };
+
+    /// Number of counter shards; threads are assigned round-robin
+    static constexpr size_t kShardCount = 16;
+
+    LoggerMetrics() = default;
+
+    /// Add to a counter on the calling thread's shard (relaxed)
+    void add(Counter counter, uint64_t amount = 1);
+
+    /// Merged value of a counter across all shards
+    uint64_t value(Counter counter) const;
+
+    /// Count one discarded entry, in the total and in its level's counter
+    void addDropped(LogLevel level);
+
+    /// Merged per-level drop counters
+    std::array<uint64_t, kLogLevelCount> droppedByLevel() const;
+
+    /// Record the queue depth observed by the writer; keeps the high-water mark
+    void observeQueueDepth(uint64_t depth);
+
+    /// Record a writer batch of @p entries entries
+    void recordBatch(uint64_t entries);
+
+    /// Record the time to write a chunk and hand it to the OS
+    void recordFlushLatency(std::chrono::nanoseconds latency);
+
+    /// Record the time of a durable flush (fsync)
+    void recordFsyncLatency(std::chrono::nanoseconds latency);
+
+    /// Record a completed rotation and its duration
+    void recordRotation(std::chrono::nanoseconds duration);
+
+    /// Full flush latency histogram
+    const Histogram& flushLatency() const { return flush_latency_; }
+
+    /// Full fsync latency histogram
+    const Histogram& fsyncLatency() const { return fsync_latency_; }
+
+    /// Copy all metrics into a snapshot
+    MetricsSnapshot snapshot() const;
+
+private:
+    struct alignas(64) Shard {
+        std::array<std::atomic<uint64_t>, static_cast<size_t>(Counter::kCount)> values{};
+    };
+
+    /// Shard used by the calling thread
+    static size_t shardIndex();
+
+    std::array<Shard, kShardCount> shards_{};
+    alignas(64) std::atomic<uint64_t> queue_high_water_{0};
+    Histogram batch_size_;
+    Histogram flush_latency_;
+    Histogram fsync_latency_;
+    Histogram rotation_;
+};
+
+/// Render a snapshot as human-readable "key value" lines
+std::string formatMetrics(const MetricsSnapshot& snapshot);
+
+/// Background thread that periodically writes formatMetrics() output to a file
+class MetricsDumper {
+public:
+    MetricsDumper() = default;
+
+    /// Stops the dump thread
+    ~MetricsDumper();
+
+    MetricsDumper(const MetricsDumper&) = delete;
+    MetricsDumper& operator=(const MetricsDumper&) = delete;
+
+    /// Start dumping @p metrics to @p path every @p interval. Restarts if running.
+    /// @return false if the interval is zero or the path is empty
+    bool start(const LoggerMetrics& metrics, const std::string& path,
+               std::chrono::milliseconds interval);
+
+    /// Stop dumping; writes one final snapshot if running
+    void stop();
+
+    /// Write the current snapshot to @p path (replacing its contents)
+    static bool dumpToFile(const LoggerMetrics& metrics, const std::string& path);
+
+private:
+    std::jthread thread_;
+    std::mutex mutex_;
+    std::condition_variable_any cv_;
+    std::string path_;
+    const LoggerMetrics* metrics_ = nullptr;
+};
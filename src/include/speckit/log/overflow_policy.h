@@ -0,0 +1,25 @@
+// Queue overflow policies for AsyncLogger
+// None of them does I/O on the logging thread
+
+#pragma once
+
+#include <chrono>
+#include "log_level.h"
+
+/// What AsyncLogger::log() does with an entry that does not fit in the queue
+enum class OverflowMode {
+    kDropNewest,      ///< Discard the entry being logged (default)
+    kDropOldest,      ///< Discard the oldest queued entries to make room for it
+    kBlock,           ///< Wait up to block_timeout for the writer to make room, then discard it
+    kDropBelowLevel   ///< Once the queue is 3/4 full, discard entries below min_level, keeping
+                      ///< the last quarter for the rest; a full queue drops the newest entry
+};
+
+/// Overflow handling for AsyncLogger::setOverflowPolicy()
+/// Every discarded entry is counted per level in the metrics, and the writer reports
+/// the loss in the log itself with a "N entries dropped" warning once it catches up.
+struct OverflowPolicy {
+    OverflowMode mode = OverflowMode::kDropNewest;
+    std::chrono::microseconds block_timeout{10000};  ///< kBlock: longest wait for room
+    LogLevel min_level = LogLevel::kLogLevelWarning;  ///< kDropBelowLevel: lowest level kept
+};
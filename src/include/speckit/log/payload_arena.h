@@ -0,0 +1,134 @@
+// Slab arena for owned log entry payloads
+// Producers bump-allocate from a thread-local chunk; chunks are recycled once every entry is released
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+class PayloadArena;
+
+/// One slab of payload bytes; the data follows the header
+struct PayloadChunk {
+    PayloadArena* arena = nullptr;
+    std::atomic<uint32_t> refs{0};       ///< Outstanding payloads, plus a bias while a producer owns it
+    std::atomic<uint32_t> next_free{0};  ///< Free list link: index + 1 of the next chunk, 0 at the end
+    uint32_t index = 0;                  ///< Slot in the arena's chunk table
+    uint32_t allocations = 0;            ///< Payloads handed out (owning producer only)
+    size_t used = 0;                     ///< Bytes handed out (owning producer only)
+
+    char* data() { return reinterpret_cast<char*>(this + 1); }
+};
+
+/// Result of PayloadArena::allocate()
+struct PayloadAllocation {
+    char* data = nullptr;
+    PayloadChunk* chunk = nullptr;  ///< nullptr when the bytes came from the heap (delete[] them)
+};
+
+/// Point-in-time allocator statistics
+struct PayloadArenaStats {
+    size_t chunk_bytes = 0;            ///< Size of each chunk
+    size_t memory_budget = 0;          ///< Cap on chunk memory
+    size_t chunks_allocated = 0;       ///< Chunks created so far (never freed)
+    size_t chunks_in_use = 0;          ///< Chunks owned by a producer or holding queued payloads
+    uint64_t allocation_failures = 0;  ///< Budget exhausted; the payload went to the heap
+    uint64_t oversize_allocations = 0; ///< Payloads too large for a chunk; went to the heap
+};
+
+/// Process-wide slab allocator for LogEntry::createOwned() payloads
+///
+/// Each producer thread bump-allocates from its own chunk, so the hot path is
+/// a pointer increment with no atomics and no malloc. Every payload holds one
+/// reference on its chunk; releasing the entry (normally on the writer thread)
+/// drops it with a single atomic decrement. A chunk the producer has moved on
+/// from goes back to a lock-free free list when its last payload is released.
+///
+/// Chunk memory is capped by the memory budget. When the budget is used up and
+/// no chunk is free, payloads fall back to the heap and allocation_failures is
+/// counted, so logging never blocks or drops on the arena. The queue capacity
+/// still bounds how many such payloads can exist.
+class PayloadArena {
+public:
+    /// Bytes per chunk
+    static constexpr size_t kChunkBytes = 64 * 1024;
+
+    /// Larger payloads bypass the arena to keep chunks from being wasted
+    static constexpr size_t kMaxPayloadBytes = kChunkBytes / 8;
+
+    /// Upper bound on chunks, and so on the budget (256 MiB)
+    static constexpr size_t kMaxChunks = 4096;
+
+    /// Default memory budget (16 MiB)
+    static constexpr size_t kDefaultMemoryBudget = 16 * 1024 * 1024;
+
+    /// The arena used by LogEntry::createOwned()
+    /// Never destroyed, so entries released during static destruction stay safe.
+    static PayloadArena& global();
+
+    PayloadArena(const PayloadArena&) = delete;
+    PayloadArena& operator=(const PayloadArena&) = delete;
+
+    /// Allocate @p size bytes for a payload
+    /// @return Bytes from the calling thread's chunk, or heap bytes with chunk == nullptr
+    PayloadAllocation allocate(size_t size);
+
+    /// Release one payload allocated from @p chunk
+    static void release(PayloadChunk* chunk) noexcept;
+
+    /// Cap the memory used by chunks; chunks already created are kept and reused
+    /// @param bytes Budget in bytes, rounded down to whole chunks; 0 sends every payload to the heap
+    void setMemoryBudget(size_t bytes);
+
+    /// @return Current memory budget in bytes
+    size_t getMemoryBudget() const;
+
+    /// @return Point-in-time statistics
+    PayloadArenaStats getStats() const;
+
+private:
+    /// The calling thread's current chunk; retired when the thread exits
+    struct ThreadChunk {
+        PayloadChunk* chunk = nullptr;
+        ~ThreadChunk();
+    };
+
+    static thread_local ThreadChunk t_chunk_;
+
+    PayloadArena();
+
+    /// Reference bias held by the owning producer; allocations are charged against it
+    static constexpr uint32_t kProducerBias = 1u << 30;
+
+    /// Take a free chunk, or create one within the budget
+    PayloadChunk* acquireChunk();
+
+    /// Producer is done with @p chunk; recycle it once its payloads are released
+    void retire(PayloadChunk* chunk);
+
+    void pushFree(PayloadChunk* chunk);
+    PayloadChunk* popFree();
+
+    std::array<std::atomic<PayloadChunk*>, kMaxChunks> chunks_{};  ///< Created chunks by index
+    std::atomic<uint64_t> free_head_{0};        ///< ABA tag (high 32 bits) | index + 1 of the top chunk
+    std::atomic<size_t> chunk_count_{0};        ///< Chunks created
+    std::atomic<size_t> free_count_{0};         ///< Chunks on the free list
+    std::atomic<size_t> max_chunks_;            ///< Budget in chunks
+    std::atomic<uint64_t> allocation_failures_{0};
+    std::atomic<uint64_t> oversize_allocations_{0};
+};
+
+/// unique_ptr deleter for payload bytes that may live in a PayloadArena chunk
+struct PayloadDeleter {
+    PayloadChunk* chunk = nullptr;  ///< nullptr for heap bytes
+
+    void operator()(char* bytes) const noexcept {
+        if (chunk) {
+            PayloadArena::release(chunk);
+        } else {
+            delete[] bytes;
+        }
+    }
+};
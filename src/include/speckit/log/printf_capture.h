@@ -0,0 +1,35 @@
+// Deferred printf-style formatting
+// Captures a format string and its arguments on the logging thread and renders them later
+
+#pragma once
+
+#include <cstdarg>
+#include <string>
+#include <string_view>
+
+namespace speckit {
+namespace log {
+
+/// Validate @p format and append it, together with the arguments it consumes from
+/// @p args, to @p out as a self-contained byte record. Strings (%s) are deep-copied,
+/// so the caller's buffers may be reused as soon as this returns.
+///
+/// Supported: flags "-+ #0", width and precision (digits or '*'), length modifiers
+/// hh h l ll j z t L, and conversions d i u o x X c s p f F e E g G a A %.
+/// Rejected: %n, positional arguments (%1$d), wide characters (%lc, %ls) and
+/// anything unknown. On failure @p out is restored to its original size.
+///
+/// @param format printf-style format string
+/// @param args Arguments matching @p format; consumed by this call
+/// @param out Destination buffer; the record is appended
+/// @return true if the format was valid and all arguments were captured
+bool capturePrintf(const char* format, va_list args, std::string& out);
+
+/// Render a record produced by capturePrintf() into the final message.
+/// Runs on the writer thread. A malformed record renders as far as it is valid.
+/// @param captured Bytes written by capturePrintf()
+/// @return Formatted message, as snprintf(format, args...) would have produced
+std::string renderPrintf(std::string_view captured);
+
+}  // namespace log
+}  // namespace speckit
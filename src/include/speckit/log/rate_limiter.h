@@ -0,0 +1,67 @@
+// Per-call-site rate limiting for log calls
+// Token buckets keyed by std::source_location and tag, configured per tag through TagFilter
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <source_location>
+#include <string_view>
+#include "tag_filter.h"
+
+namespace speckit { namespace log {
+
+/// Lock-free token buckets, one per call site
+///
+/// Each bucket is a GCRA cell: a single atomic "next conforming time". A call is
+/// allowed while it is no more than burst - 1 intervals ahead of that time, and
+/// pushes it one interval further. A suppressed call costs a few relaxed loads
+/// and no write, so a hot loop that is being throttled does not bounce the cache line.
+///
+/// Sites (source_location + tag) are hashed into a fixed table and placed in the
+/// first free slot among kProbeLength, starting at their hash. The tag's RateLimit
+/// is looked up once per site and cached in its slot until the filter changes, which
+/// also refills the bucket. When all kProbeLength slots belong to other sites, the
+/// site shares the first one's bucket: it is throttled together with that site, never
+/// handed a fresh burst, and checked against its own tag's limit without rewriting
+/// the owner's cached rule.
+class CallSiteRateLimiter {
+public:
+    /// Number of slots in the table
+    static constexpr size_t kSlotCount = 1024;
+
+    /// Slots searched for a site, from the one its hash selects
+    static constexpr size_t kProbeLength = 4;
+
+    /// Largest representable settings; larger values are clamped
+    static constexpr uint32_t kMaxPerSecond = (1u << 20) - 1;
+    static constexpr uint32_t kMaxBurst = (1u << 12) - 1;
+
+    CallSiteRateLimiter() = default;
+    CallSiteRateLimiter(const CallSiteRateLimiter&) = delete;
+    CallSiteRateLimiter& operator=(const CallSiteRateLimiter&) = delete;
+
+    /// Take a token for one log call; safe from any thread
+    /// @param site Call site of the log call
+    /// @param tag Tag of the entry; selects the RateLimit
+    /// @param filter Rate limit configuration
+    /// @return false if the call exceeds its tag's rate limit and should be dropped
+    bool tryAcquire(const std::source_location& site, std::string_view tag, const TagFilter& filter);
+
+private:
+    struct Slot {
+        /// Site check (16 bits) | filter generation (16) | burst (12) | per_second (20)
+        std::atomic<uint64_t> rule{0};
+        /// Earliest time (steady clock, ns) at which a call conforms
+        std::atomic<int64_t> next_ns{0};
+    };
+
+    /// Take a token from @p slot under @p rule
+    static bool takeToken(Slot& slot, uint64_t rule);
+
+    std::array<Slot, kSlotCount> slots_{};
+};
+
+}} // namespace speckit::log
@@ -0,0 +1,63 @@
+// Writer-side collapsing of repeated log lines
+// Identical consecutive entries become one line plus "last message repeated N times"
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include "log_entry.h"
+#include "tag_filter.h"
+
+/// Result of RepeatCollapser::collapse()
+struct CollapseResult {
+    size_t size = 0;      ///< Entries now at the front of the batch, markers included
+    size_t removed = 0;   ///< Repeats taken out of the batch
+};
+
+/// Single-consumer filter over drained batches
+///
+/// An entry with the same level, tag, message and fields as the previous one is
+/// removed when its tag collapses repeats (TagFilter::setTagCollapseRepeats()).
+/// When a run ends, or at the end of the batch, a "last message repeated N times"
+/// entry with the run's level and tag takes the place of the repeats, so a run
+/// spanning several batches is reported once per batch. The previous entry is
+/// remembered across batches.
+class RepeatCollapser {
+public:
+    RepeatCollapser() = default;
+    RepeatCollapser(const RepeatCollapser&) = delete;
+    RepeatCollapser& operator=(const RepeatCollapser&) = delete;
+
+    /// Remove repeats from @p batch in place
+    /// Removed entries release their payload; markers reuse their slots.
+    /// @param batch Entries in output order
+    /// @param filter Decides which tags collapse
+    /// @return New batch size and the number of repeats removed
+    CollapseResult collapse(std::span<LogEntry> batch, const speckit::log::TagFilter& filter);
+
+private:
+    /// True if @p entry repeats the remembered one
+    bool isRepeat(const LogEntry& entry) const;
+
+    /// Remember @p entry as the one later entries are compared with
+    void remember(const LogEntry& entry);
+
+    /// "last message repeated N times" for the current run
+    LogEntry makeMarker() const;
+
+    /// Whether @p tag collapses; cached for the last tag looked up
+    bool collapses(std::string_view tag, const speckit::log::TagFilter& filter);
+
+    bool has_last_ = false;
+    LogEntry last_;                  ///< Level, timestamp and ids of the remembered entry
+    std::string last_tag_;           ///< Copies, since the entry's payload is released after writing
+    std::string last_message_;
+    std::string last_fields_;
+    uint64_t repeats_ = 0;           ///< Repeats removed since the last marker
+
+    std::string cached_tag_;         ///< Tag of the last collapses() lookup
+    uint32_t cached_generation_ = 0; ///< Filter generation of that lookup
+    bool cached_collapses_ = false;
+};
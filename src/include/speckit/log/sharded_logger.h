@@ -0,0 +1,127 @@
+// Sharded multi-writer logger for high core counts
+// K independent AsyncLogger pipelines, each with its own queue, writer thread and files
+
+#pragma once
+
+#include <cstdarg>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "async_logger.h"
+#include "log_level.h"
+#include "metrics.h"
+#include "wait_strategy.h"
+
+/// How producers are assigned to shards
+enum class ShardMapping {
+    kThread,  ///< Fixed shard per thread (round-robin on first use); keeps per-thread order in one file
+    kCpu      ///< Shard of the CPU the caller runs on; falls back to kThread where unavailable (macOS)
+};
+
+/// Opt-in multi-writer mode
+///
+/// A single AsyncLogger is capped by one writer thread formatting and writing every
+/// entry. ShardedLogger runs @c shard_count AsyncLogger pipelines side by side, each
+/// with its own queue, writer thread, crash staging and output files, so throughput
+/// scales with the number of writers. Shard @c i writes to "<base_name>.shard<i>.log"
+/// and rotates independently to "<base_name>.shard<i>.<N>.log".
+///
+/// Entries from one thread stay in order within their shard with ShardMapping::kThread.
+/// There is no ordering across shards; merge by timestamp when reading if needed.
+///
+/// Crash replay covers at most CrashHandler::kMaxEmergencyBuffers loggers per process.
+/// Shards created beyond that cap (or while other loggers hold the slots) log normally
+/// but lose the chunk being written when the process crashes; see crashReplayShardCount().
+class ShardedLogger {
+public:
+    /// Create a sharded logger. Returns nullptr if any shard fails to initialize.
+    /// @param base_name Base name for log files; each shard appends ".shard<i>"
+    /// @param shard_count Number of writer pipelines (at least 1)
+    /// @param queue_size Queue size of each shard
+    /// @param mapping How producers are assigned to shards
+    static std::unique_ptr<ShardedLogger> create(const std::string& base_name,
+                                                 size_t shard_count,
+                                                 size_t queue_size = 10000,
+                                                 ShardMapping mapping = ShardMapping::kThread);
+
+    /// Log a message on the caller's shard; see AsyncLogger::log
+    void log(LogLevel level, std::string_view tag, std::string_view message,
+             std::source_location site = std::source_location::current());
+
+    /// Log a message with structured fields on the caller's shard; see AsyncLogger::log
+    void log(LogLevel level, std::string_view tag, std::string_view message,
+             std::initializer_list<LogField> fields,
+             std::source_location site = std::source_location::current());
+
+    /// Log a lazily built message on the caller's shard; see AsyncLogger::log
+    template <typename MessageFn>
+        requires std::invocable<MessageFn&> &&
+                 std::convertible_to<std::invoke_result_t<MessageFn&>, std::string_view>
+    void log(LogLevel level, std::string_view tag, MessageFn&& make_message,
+             std::source_location site = std::source_location::current()) {
+        currentShard().log(level, tag, std::forward<MessageFn>(make_message), site);
+    }
+
+    /// Log a message written into a per-thread buffer on the caller's shard; see AsyncLogger::log
+    template <typename WriteFn>
+        requires std::invocable<WriteFn&, std::string&>
+    void log(LogLevel level, std::string_view tag, WriteFn&& write_message,
+             std::source_location site = std::source_location::current()) {
+        currentShard().log(level, tag, std::forward<WriteFn>(write_message), site);
+    }
+
+    /// Log a printf-style message on the caller's shard; see AsyncLogger::vlogf
+    bool vlogf(LogLevel level, std::string_view tag, const char* format, va_list args,
+               std::source_location site = std::source_location::current());
+
+    /// Set minimum log level on all shards
+    void setLogLevel(LogLevel level);
+
+    /// Get current minimum log level
+    LogLevel getLogLevel() const;
+
+    /// Set the writer wait strategy on all shards
+    void setWaitStrategy(WaitStrategy strategy);
+
+    /// Set the queue overflow policy on all shards
+    void setOverflowPolicy(const OverflowPolicy& policy);
+
+    /// Set the text line formatter on all shards
+    void setLineFormatter(FormatPipeline::EntryFormatter formatter);
+
+    /// Apply @p filter on all shards; rate limits are counted per shard
+    void setTagFilter(const speckit::log::TagFilter* filter);
+
+    /// Flush all shards
+    void flush();
+
+    /// Stop all writer threads after draining. Safe to call multiple times.
+    void deinitialize();
+
+    /// @return Number of shards
+    size_t shardCount() const;
+
+    /// @return Number of shards whose in-flight bytes are replayed on crash; less than
+    ///         shardCount() once the process has more than CrashHandler::kMaxEmergencyBuffers loggers
+    size_t crashReplayShardCount() const;
+
+    /// Access one shard, e.g. for per-shard metrics dumps
+    /// @param index Shard index in [0, shardCount())
+    AsyncLogger& shard(size_t index);
+
+    /// @return Current log file of every shard, by shard index
+    std::vector<std::string> getLogFileNames() const;
+
+    /// @return Metrics of every shard, by shard index
+    std::vector<MetricsSnapshot> getShardMetrics() const;
+
+private:
+    ShardedLogger(std::vector<std::unique_ptr<AsyncLogger>> shards, ShardMapping mapping);
+
+    /// Shard used by the calling thread (or CPU)
+    AsyncLogger& currentShard();
+
+    std::vector<std::unique_ptr<AsyncLogger>> shards_;
+    ShardMapping mapping_;
+};
@@ -0,0 +1,121 @@
+// Fan-out of formatted batches to independent sink threads
+// One producer publishes into a ring; every sink drains it with its own cursor
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "log_sink.h"
+
+/// Per-sink delivery counters
+struct SinkStats {
+    uint64_t batches_written = 0;  ///< Batches passed to LogSink::write()
+    uint64_t batches_skipped = 0;  ///< Batches overwritten before the sink reached them
+    uint64_t wait_timeouts = 0;    ///< waitIdle() calls that gave up on this sink
+};
+
+/// Shares each formatted batch between sinks that each run on their own thread
+///
+/// The producer (the logger's writer or I/O thread) fills a batch from acquireBatch()
+/// and hands it to publish(), which stores it in a ring of kRingBatches slots and
+/// returns at once. Each sink thread follows the ring with its own cursor and writes
+/// batches in order. A sink that falls a whole ring behind skips forward to the oldest
+/// batch still held, counting what it missed, so a slow or stuck sink never holds up
+/// the producer or the other sinks.
+///
+/// Batches are reference counted: the ring holds one reference and every sink writing
+/// one holds another. When the last is dropped the batch, with its buffers, goes back
+/// to a free list for acquireBatch() to reuse.
+///
+/// Waiting for the sinks is bounded, so a sink stuck in write() cannot hang the
+/// producer's flushes or shutdown either: waitIdle() gives up after its timeout, and
+/// the destructor leaves a sink that is still busy after the stop timeout running on
+/// a detached thread, which ends once its write() returns.
+class SinkFanout {
+public:
+    /// Batches kept for sinks that are behind
+    static constexpr size_t kRingBatches = 64;
+
+    /// Default for how long waitIdle() and the destructor wait for a sink
+    static constexpr std::chrono::milliseconds kDefaultWaitTimeout{5000};
+
+    /// @param stop_timeout How long the destructor waits for busy sinks to finish
+    explicit SinkFanout(std::chrono::milliseconds stop_timeout = kDefaultWaitTimeout);
+
+    /// Lets every sink write what was published, then stops the sink threads;
+    /// see getAbandonedSinks()
+    ~SinkFanout();
+
+    SinkFanout(const SinkFanout&) = delete;
+    SinkFanout& operator=(const SinkFanout&) = delete;
+
+    /// Start a thread for @p sink; it receives batches published from now on
+    /// @param sink Sink to add; ignored if null
+    void addSink(std::shared_ptr<LogSink> sink);
+
+    /// @return true if at least one sink was added (cheap; for the producer's fast path)
+    bool hasSinks() const;
+
+    /// Producer: an empty batch to fill, reused from the free list when possible
+    std::shared_ptr<SinkBatch> acquireBatch();
+
+    /// Producer: make @p batch visible to every sink; never waits for them
+    void publish(std::shared_ptr<SinkBatch> batch);
+
+    /// Block until every sink has written or skipped everything published so far
+    /// @param timeout Longest wait; each sink still behind then counts a wait timeout
+    /// @return false on timeout
+    bool waitIdle(std::chrono::milliseconds timeout = kDefaultWaitTimeout);
+
+    /// @return Counters of each sink, in the order they were added
+    std::vector<SinkStats> getStats() const;
+
+    /// @return Batches created so far; stays small while sinks keep up
+    size_t getBatchesAllocated() const;
+
+    /// @return Sink threads left running by destroyed SinkFanouts, process-wide
+    static uint64_t getAbandonedSinks();
+
+private:
+    /// Recycled batches; shared with the deleters of batches still in use
+    struct BatchPool {
+        std::mutex mutex;
+        std::vector<std::unique_ptr<SinkBatch>> free;
+        size_t allocated = 0;
+    };
+
+    struct Worker {
+        std::shared_ptr<LogSink> sink;
+        uint64_t cursor = 0;     ///< Next sequence to take (guarded by mutex)
+        uint64_t completed = 0;  ///< Everything before this is written or skipped (guarded by mutex)
+        SinkStats stats;         ///< Guarded by mutex
+        bool exited = false;     ///< The thread is done with the shared state (guarded by mutex)
+        std::thread thread;
+    };
+
+    /// Everything the sink threads touch; shared with them so an abandoned thread
+    /// can outlive the SinkFanout
+    struct Shared {
+        mutable std::mutex mutex;
+        std::condition_variable published_cv;  ///< A batch was published or stopping
+        std::condition_variable idle_cv;       ///< A sink finished a batch or exited
+        std::vector<std::shared_ptr<const SinkBatch>> ring;  ///< Slot sequence % kRingBatches
+        uint64_t published = 0;                ///< Batches published
+        bool stopping = false;
+        std::vector<std::unique_ptr<Worker>> workers;
+    };
+
+    static void sinkThread(const std::shared_ptr<Shared>& shared, Worker& worker);
+
+    std::shared_ptr<BatchPool> pool_;
+    std::shared_ptr<Shared> shared_;
+    std::chrono::milliseconds stop_timeout_;
+    std::atomic<bool> has_sinks_{false};
+};
@@ -0,0 +1,130 @@
+// Batched stream socket sink for local log shippers
+// Length-prefixed frames over a Unix domain or localhost TCP socket, spilled to disk while the peer is down
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "log_sink.h"
+#include "platform.h"
+
+#ifndef SPECKIT_PLATFORM_WINDOWS
+#include <sys/socket.h>
+#include <sys/uio.h>
+#endif
+
+/// Connection and spill settings for SocketSink
+struct SocketSinkOptions {
+    std::chrono::milliseconds initial_backoff{100};  ///< Wait after the first failed connect
+    std::chrono::milliseconds max_backoff{30000};    ///< Cap for the doubling wait
+    std::chrono::milliseconds send_timeout{1000};    ///< A stalled peer is dropped after this
+    std::string spill_path;                          ///< File for frames while the peer is down; empty to drop them
+    size_t max_spill_bytes = 64 * 1024 * 1024;       ///< Spill file limit; further frames are dropped
+};
+
+/// Delivery counters of a SocketSink
+struct SocketSinkStats {
+    uint64_t frames_sent = 0;       ///< Frames written to the socket, replayed ones included
+    uint64_t records_sent = 0;      ///< Lines in those frames
+    uint64_t frames_spilled = 0;    ///< Frames written to the spill file
+    uint64_t frames_dropped = 0;    ///< Frames lost: no spill file, or it was full
+    uint64_t connects = 0;          ///< Successful connections
+    uint64_t connect_failures = 0;  ///< Failed connection attempts
+};
+
+/// Ships formatted lines to a log shipper over a stream socket
+///
+/// Every batch is sent as frames of up to kMaxFrameRecords lines:
+///
+///     u32 frame_bytes   bytes that follow this field
+///     u32 record_count
+///     record_count x { u32 record_bytes, record_bytes of text }
+///
+/// All integers are big-endian, and records are formatted lines without the trailing
+/// newline. Frames are written with sendmsg() from iovecs that point into the shared
+/// batch, so the text is never copied.
+///
+/// Connecting happens on the sink's thread when there is something to send. A failed
+/// attempt waits initial_backoff before the next one, doubling up to max_backoff, and
+/// a successful one resets it. Until then frames are appended to the spill file,
+/// which is sent first, in order, once the peer is back. A frame interrupted by a
+/// send error or timeout is sent again in full on the next connection; the receiver
+/// discards the incomplete copy when the connection drops. POSIX only.
+class SocketSink : public LogSink {
+public:
+    /// Most records in one frame (each takes two iovecs)
+    static constexpr size_t kMaxFrameRecords = 256;
+
+    /// Sink for a Unix domain stream socket. Returns nullptr if the path is too long or
+    /// the spill file cannot be created. The peer may start later.
+    static std::shared_ptr<SocketSink> createUnix(const std::string& socket_path,
+                                                  const SocketSinkOptions& options = {},
+                                                  LogLevel min_level = LogLevel::kLogLevelDebug);
+
+    /// Sink for a TCP peer, normally on localhost. Returns nullptr if @p address is not
+    /// a numeric IPv4 address or the spill file cannot be created.
+    static std::shared_ptr<SocketSink> createTcp(const std::string& address, uint16_t port,
+                                                 const SocketSinkOptions& options = {},
+                                                 LogLevel min_level = LogLevel::kLogLevelDebug);
+
+    ~SocketSink() override;
+
+    void write(const SinkBatch& batch) override;
+
+    /// @return Point-in-time delivery counters
+    SocketSinkStats getStats() const;
+
+private:
+    explicit SocketSink(const SocketSinkOptions& options, LogLevel min_level);
+
+    /// Open the spill file, if configured
+    bool openSpill();
+
+    /// Connect unless connected or still backing off
+    bool ensureConnected();
+
+    void disconnect();
+
+    /// Start or double the wait before the next connection attempt
+    void backOff();
+
+    /// Send one frame, or spill it while the peer is down or older frames are still spilled
+    void deliver(size_t records);
+
+    /// Send the spilled frames; true once none are left
+    bool replaySpill();
+
+#ifndef SPECKIT_PLATFORM_WINDOWS
+    /// Write all of @p iov to the socket, advancing it over partial writes
+    bool sendAll(iovec* iov, size_t count);
+
+    sockaddr_storage address_{};
+    socklen_t address_length_ = 0;
+    std::vector<iovec> iov_;            ///< Frame being built: header, then prefix and text per record
+    std::vector<iovec> send_iov_;       ///< Copy of iov_ that sendAll() consumes
+#endif
+
+    const SocketSinkOptions options_;
+    int socket_fd_ = -1;
+    int spill_fd_ = -1;
+    uint64_t spill_read_offset_ = 0;    ///< Start of the oldest frame not yet sent
+    uint64_t spill_end_ = 0;            ///< Bytes in the spill file
+    std::chrono::steady_clock::time_point next_attempt_{};
+    std::chrono::milliseconds backoff_{0};
+
+    uint32_t header_[2] = {};           ///< Big-endian frame_bytes and record_count
+    std::vector<uint32_t> prefixes_;    ///< Big-endian record lengths, kMaxFrameRecords reserved
+    std::vector<char> replay_buffer_;   ///< Reused for reading spilled frames
+
+    std::atomic<uint64_t> frames_sent_{0};
+    std::atomic<uint64_t> records_sent_{0};
+    std::atomic<uint64_t> frames_spilled_{0};
+    std::atomic<uint64_t> frames_dropped_{0};
+    std::atomic<uint64_t> connects_{0};
+    std::atomic<uint64_t> connect_failures_{0};
+};
@@ -1,26 +1,82 @@
 #pragma once
 
 #include "log_level.h"
+#include <atomic>
+#include <cstdint>
+#include <functional>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <mutex>
 
 namespace speckit { namespace log {
 
+/// Token bucket settings for a tag; see TagFilter::setTagRateLimit()
+struct RateLimit {
+    uint32_t per_second = 0;  ///< Sustained lines per second per call site; 0 means unlimited
+    uint32_t burst = 1;       ///< Lines a call site may log back to back before the rate applies
+};
+
 class TagFilter {
 public:
     TagFilter();
 
     void setTagEnabled(const std::string& tag, bool enabled);
-    bool isTagEnabled(const std::string& tag) const;
+    bool isTagEnabled(std::string_view tag) const;
 
     void setTagLevel(const std::string& tag, LogLevel level);
-    LogLevel getTagLevel(const std::string& tag) const;
+    LogLevel getTagLevel(std::string_view tag) const;
+
+    /// Limit how fast each call site may log with @p tag (checked by AsyncLogger on the producer)
+    void setTagRateLimit(const std::string& tag, RateLimit limit);
+    RateLimit getTagRateLimit(std::string_view tag) const;
+
+    /// Collapse identical consecutive @p tag lines into "last message repeated N times" (on the writer)
+    void setTagCollapseRepeats(const std::string& tag, bool collapse);
+    bool isTagCollapsingRepeats(std::string_view tag) const;
+
+    /// Keep one in @p one_in_n DEBUG and INFO @p tag lines, chosen at random; WARNING
+    /// and ERROR are always kept. 0 or 1 keeps everything.
+    void setTagSampleRate(const std::string& tag, uint32_t one_in_n);
+    uint32_t getTagSampleRate(std::string_view tag) const;
+
+    /// Sampling decision for one log call (checked by AsyncLogger on the producer)
+    /// Uses a per-thread PRNG and a per-thread cache of the last tag's rate, so a
+    /// chatty tag costs no lock and no shared write.
+    /// @return false if the line is sampled out
+    bool sample(std::string_view tag, LogLevel level) const;
+
+    /// @return true once any tag has a sample rate
+    bool hasSampling() const { return has_sampling_.load(std::memory_order_relaxed); }
+
+    /// @return true once any tag has a rate limit; lets callers skip the lookup
+    bool hasRateLimits() const { return has_rate_limits_.load(std::memory_order_relaxed); }
+
+    /// @return true once any tag collapses repeats
+    bool hasCollapseRules() const { return has_collapse_rules_.load(std::memory_order_relaxed); }
+
+    /// Changed by every setter, so callers can cache lookups
+    /// Drawn from a process-wide counter: no two filters have the same generation.
+    uint32_t generation() const { return generation_.load(std::memory_order_relaxed); }
 
 private:
+    /// Hash that lets lookups take a string_view without building a std::string
+    struct TagHash {
+        using is_transparent = void;
+        size_t operator()(std::string_view tag) const { return std::hash<std::string_view>{}(tag); }
+    };
+
     mutable std::mutex mutex_;
-    std::unordered_map<std::string, bool> enabled_;
-    std::unordered_map<std::string, LogLevel> levels_;
+    std::atomic<bool> has_rules_{false};  ///< Lets lookups skip the lock until a rule is set
+    std::atomic<bool> has_rate_limits_{false};
+    std::atomic<bool> has_collapse_rules_{false};
+    std::atomic<bool> has_sampling_{false};
+    std::atomic<uint32_t> generation_;
+    std::unordered_map<std::string, bool, TagHash, std::equal_to<>> enabled_;
+    std::unordered_map<std::string, LogLevel, TagHash, std::equal_to<>> levels_;
+    std::unordered_map<std::string, RateLimit, TagHash, std::equal_to<>> rate_limits_;
+    std::unordered_map<std::string, bool, TagHash, std::equal_to<>> collapse_;
+    std::unordered_map<std::string, uint32_t, TagHash, std::equal_to<>> sample_rates_;
 };
 
 }} // namespace speckit::log
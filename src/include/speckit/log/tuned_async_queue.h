@@ -0,0 +1,134 @@
+// Cache-friendly lock-free MPSC queue for async logging
+// Same per-slot sequence algorithm as AsyncQueue, laid out to avoid false sharing
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <span>
+#include <vector>
+#include "log_entry.h"
+
+/// Lock-free MPSC bounded queue, tuned variant of AsyncQueue
+///
+/// Differences from AsyncQueue:
+/// - Capacity is rounded up to a power of two, so slots are found with a mask
+///   instead of a modulo.
+/// - Every cell, and each of the producer and consumer counters, sits on its own
+///   cache line, so neighbouring producers and the consumer do not false-share.
+/// - There is no separate size counter; size() is derived from tail - head.
+///
+/// A producer takes a ticket with a CAS on tail_ only once the ticket's cell is free,
+/// so tryPush never waits for the consumer: it returns false as soon as it finds the
+/// cell for the next ticket still occupied. A wait-free fetch_add on tail_ was tried
+/// and dropped on purpose: a ticket taken that way is owned even when its cell is
+/// still full, so a producer would have to wait for the consumer instead of failing fast.
+///
+/// The consumer claims each batch by advancing head_ with a CAS before reading it,
+/// so tryPopOldest() can take the oldest ticket from any thread (e.g. a producer
+/// evicting to make room) without breaking the single-consumer drain.
+class TunedAsyncQueue {
+public:
+    /// Cache line size used for padding
+    static constexpr size_t kCacheLineSize = 64;
+
+    /// @param capacity Minimum number of entries; rounded up to a power of two
+    explicit TunedAsyncQueue(size_t capacity);
+    ~TunedAsyncQueue() = default;
+
+    TunedAsyncQueue(const TunedAsyncQueue&) = delete;
+    TunedAsyncQueue& operator=(const TunedAsyncQueue&) = delete;
+
+    /// Push an entry; it is moved from only on success
+    /// @param entry Entry to push
+    /// @return false if the queue is full (entry left untouched)
+    bool tryPush(LogEntry& entry);
+
+    /// Convenience overload for temporaries; forwards to the lvalue overload
+    bool tryPush(LogEntry&& entry);
+
+    /// Disable accidental passing of const lvalues
+    bool tryPush(const LogEntry&) = delete;
+
+    /// Remove the oldest entry; safe to call from any thread, concurrently with the consumer
+    /// @param out Receives the entry
+    /// @return false if the queue was empty
+    bool tryPopOldest(LogEntry& out);
+
+    /// Single-consumer: pop all available entries
+    /// @return Entries in ticket order
+    std::vector<LogEntry> popAll();
+
+    /// Single-consumer: hand up to @p max entries to @p fn in place, in ticket order
+    /// Nothing is allocated. The entry is destroyed after @p fn returns, so @p fn must
+    /// move from it if it needs to keep it. @p fn must not throw.
+    /// @param fn Callable invoked as fn(LogEntry&)
+    /// @param max Maximum number of entries to consume
+    /// @return Number of entries consumed
+    template <typename F>
+    size_t drain(F&& fn, size_t max = std::numeric_limits<size_t>::max());
+
+    /// Single-consumer: move up to out.size() entries into a caller-owned buffer
+    /// @param out Reusable destination; existing elements are move-assigned over
+    /// @return Number of entries written to the front of @p out
+    size_t drainInto(std::span<LogEntry> out);
+
+    /// @return true if no tickets are outstanding
+    bool isEmpty() const;
+
+    /// Number of reserved tickets not yet consumed
+    /// Includes entries that are still being written by their producer.
+    size_t size() const;
+
+    /// @return Power-of-two capacity
+    size_t capacity() const;
+
+private:
+    struct alignas(kCacheLineSize) Cell {
+        std::atomic<size_t> seq{0};
+        std::optional<LogEntry> storage;
+    };
+
+    /// Wait until @p cell reaches @p expected, spinning briefly before yielding
+    static void waitForSeq(const Cell& cell, size_t expected);
+
+    // Read-only after construction; shared by producers and the consumer
+    std::unique_ptr<Cell[]> buffer_;
+    const size_t capacity_;
+    const size_t mask_;
+
+    alignas(kCacheLineSize) std::atomic<size_t> tail_{0};  ///< Next ticket (producers)
+    alignas(kCacheLineSize) std::atomic<size_t> head_{0};  ///< Next unclaimed ticket (consumer, evictions)
+};
+
+template <typename F>
+size_t TunedAsyncQueue::drain(F&& fn, size_t max) {
+    // Claim the batch first; tryPopOldest() may be competing for the oldest ticket
+    size_t head = head_.load(std::memory_order_acquire);
+    size_t count;
+    do {
+        count = std::min(tail_.load(std::memory_order_acquire) - head, max);
+        if (count == 0) {
+            return 0;
+        }
+    } while (!head_.compare_exchange_weak(head, head + count, std::memory_order_acq_rel,
+                                          std::memory_order_acquire));
+
+    for (size_t ticket = head; ticket != head + count; ++ticket) {
+        Cell& cell = buffer_[ticket & mask_];
+
+        // Wait until the producer holding this ticket has published
+        waitForSeq(cell, ticket + 1);
+
+        fn(*cell.storage);
+        cell.storage.reset();
+
+        // Free the slot for the ticket one lap ahead
+        cell.seq.store(ticket + capacity_, std::memory_order_release);
+    }
+    return count;
+}
@@ -0,0 +1,118 @@
+// Writer wait strategies and producer-to-writer wakeup
+// Producers only pay for a wakeup when the writer has announced that it is asleep
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86) || defined(_M_ARM64))
+#include <intrin.h>
+#endif
+
+namespace speckit {
+namespace log {
+
+/// Tell the CPU we are in a spin loop (x86 pause, ARM yield)
+inline void cpuRelax() {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    _mm_pause();
+#elif defined(_MSC_VER) && defined(_M_ARM64)
+    __yield();
+#elif defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield");
+#endif
+}
+
+}  // namespace log
+}  // namespace speckit
+
+/// How the writer thread waits for work
+enum class WaitStrategy {
+    kBusySpin,     ///< Spin with cpuRelax() forever; lowest latency, burns a core
+    kSpinYield,    ///< Spin briefly, then yield() in a loop; never sleeps in the kernel
+    kSpinPark,     ///< Spin briefly, then sleep on an atomic wait until a producer wakes it (default)
+    kTimedPark     ///< Spin briefly, then poll every kTimedParkInterval; producers never signal
+};
+
+/// Single-waiter wakeup between producers and the writer thread
+///
+/// The writer announces that it is about to sleep by raising a waiter flag, re-checks
+/// for work, and then blocks on an epoch counter with std::atomic::wait (a futex on
+/// Linux, __ulock on macOS, WaitOnAddress on Windows). notify() is a fence and a load
+/// while the writer is awake; only when the flag is raised does it bump the epoch and
+/// enter the kernel. Work published before notify() is always seen by the writer:
+/// the fences order the producer's publish/flag-load against the writer's
+/// flag-store/re-check, so one side always observes the other.
+class WriterWakeup {
+public:
+    /// Pause-spins before a strategy falls back to yielding or parking
+    static constexpr int kSpinIterations = 256;
+
+    /// Poll interval for WaitStrategy::kTimedPark
+    static constexpr std::chrono::microseconds kTimedParkInterval{1000};
+
+    /// Producer side: wake the writer if it is asleep.
+    /// Call after the work has been published.
+    void notify() {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        // The exchange lets only the first producer that sees the flag enter the kernel
+        if (sleeping_.load(std::memory_order_relaxed) &&
+            sleeping_.exchange(false, std::memory_order_acq_rel)) {
+            epoch_.fetch_add(1, std::memory_order_release);
+            epoch_.notify_one();
+        }
+    }
+
+    /// Writer side: return once @p has_work() is true
+    /// @param strategy How to wait between checks
+    /// @param has_work Predicate that is true when there is work or a stop request
+    template <typename Predicate>
+    void wait(WaitStrategy strategy, Predicate&& has_work) {
+        int spins = 0;
+        while (!has_work()) {
+            if (strategy == WaitStrategy::kBusySpin || spins < kSpinIterations) {
+                spins += spins < kSpinIterations;
+                speckit::log::cpuRelax();
+                continue;
+            }
+            switch (strategy) {
+            case WaitStrategy::kSpinYield:
+                std::this_thread::yield();
+                break;
+            case WaitStrategy::kTimedPark:
+                std::this_thread::sleep_for(kTimedParkInterval);
+                break;
+            default:
+                park(has_work);
+                break;
+            }
+        }
+    }
+
+    /// Number of times the writer has actually gone to sleep
+    uint64_t parks() const { return parks_.load(std::memory_order_relaxed); }
+
+private:
+    template <typename Predicate>
+    void park(Predicate& has_work) {
+        const uint32_t epoch = epoch_.load(std::memory_order_acquire);
+        sleeping_.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        // Work published before the flag was raised is caught here
+        if (!has_work()) {
+            parks_.fetch_add(1, std::memory_order_relaxed);
+            epoch_.wait(epoch, std::memory_order_acquire);
+        }
+        sleeping_.store(false, std::memory_order_relaxed);
+    }
+
+    std::atomic<uint32_t> epoch_{0};      ///< Bumped by producers that saw the waiter flag
+    std::atomic<bool> sleeping_{false};   ///< Waiter flag raised by the writer before parking
+    std::atomic<uint64_t> parks_{0};      ///< Diagnostics: completed park attempts
+};
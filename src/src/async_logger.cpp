@@ -3,28 +3,50 @@
 #include "speckit/log/async_logger.h"
 #include "speckit/log/log_level.h"
 #include "speckit/log/log_entry.h"
+#include "speckit/log/printf_capture.h"
+#include <algorithm>
+#include <bit>
 #include <chrono>
 #include <format>
 #include <stop_token>
 #include <thread>
 
+namespace {
 
+// Routed files get text when the main file is binary
+LogFileFormat routedFormat(LogFileFormat format) {
+    return format == LogFileFormat::kBinary ? LogFileFormat::kText : format;
+}
+
+}  // namespace
 
 std::unique_ptr<AsyncLogger> AsyncLogger::create(const std::string& base_name,
-                                                  size_t queue_size) {
+                                                  size_t queue_size,
+                                                  size_t formatter_threads) {
     auto logger = std::unique_ptr<AsyncLogger>(new AsyncLogger());
-    if (!logger->initialize(base_name, queue_size)) {
+    if (!logger->initialize(base_name, queue_size, formatter_threads)) {
         return nullptr;
     }
     return logger;
 }
 
-bool AsyncLogger::initializeComponents(const std::string& base_name, size_t queue_size) {
+bool AsyncLogger::initializeComponents(const std::string& base_name, size_t queue_size,
+                                       size_t formatter_threads) {
     // Create components
+    base_name_ = base_name;
     file_manager_ = std::make_unique<FileManager>(base_name);
-    async_queue_ = std::make_unique<AsyncQueue>(queue_size);
-    ring_buffer_ = std::make_unique<RingBuffer>(queue_size);  // Same size for crash safety
+    async_queue_ = std::make_unique<TunedAsyncQueue>(queue_size);
+    priority_queue_ = std::make_unique<TunedAsyncQueue>(
+        std::max(queue_size / kPriorityLaneDivisor, kMinPriorityLaneEntries));
+    lanes_ = std::make_unique<LaneMerger>(*priority_queue_, *async_queue_);
     crash_handler_ = std::make_unique<CrashHandler>();
+    sinks_ = std::make_unique<SinkFanout>();
+
+    // Allocated once; the writer reuses them for every batch
+    drain_buffer_.resize(kDrainBatchEntries);
+    write_buffer_.reserve(kWriteChunkBytes);
+
+    file_manager_->SetMetrics(&metrics_);
 
     // Initialize file manager
     if (!file_manager_->Initialize(process_id_)) {
@@ -33,6 +55,16 @@ bool AsyncLogger::initializeComponents(const std::string& base_name, size_t queu
 
     // Set crash handler callback
     crash_handler_->setFlushCallback([this]() { this->emergencyFlush(); });
+    crash_handler_->attachEmergencyFile(file_manager_->GetFileDescriptor());
+
+    if (formatter_threads > 0) {
+        // Chunks are written on the pipeline's I/O thread, one at a time and in order
+        format_pipeline_ = std::make_unique<FormatPipeline>(
+            formatter_threads, kDrainBatchEntries, kWriteChunkBytes,
+            [this](const std::string& chunk, std::span<const FormattedLine> lines) {
+                this->writeChunk(chunk, lines);
+            });
+    }
 
     // Start background writer thread with stop token support
     writer_thread_ = std::jthread([this](std::stop_token st) { this->writerThread(st); });
@@ -40,23 +72,287 @@ bool AsyncLogger::initializeComponents(const std::string& base_name, size_t queu
     return true;
 }
 
-void AsyncLogger::writeEntries(const std::vector<LogEntry>& entries) {
-    if (!file_manager_) return;
+FormatPipeline* AsyncLogger::activePipeline() const {
+    // Binary encoding keeps per-file state, so it stays on this thread
+    return file_manager_->GetOutputFormat() != LogFileFormat::kBinary ? format_pipeline_.get() : nullptr;
+}
+
+FormatPipeline::EntryFormatter AsyncLogger::activeFormatter() const {
+    return file_manager_->GetOutputFormat() == LogFileFormat::kJsonLines
+               ? formatLogEntryJson
+               : line_formatter_.load(std::memory_order_relaxed);
+}
+
+template <typename Source>
+void AsyncLogger::drainAndWrite(Source& source) {
+    FormatPipeline* pipeline = activePipeline();
+    const FormatPipeline::EntryFormatter formatter = activeFormatter();
+
+    const speckit::log::TagFilter* filter = tag_filter_.load(std::memory_order_acquire);
+    const bool collapse = filter && filter->hasCollapseRules();
+
+    size_t remaining = source.size();
+    while (remaining > 0) {
+        std::span<LogEntry> batch = pipeline ? pipeline->acquireBatch()
+                                             : std::span<LogEntry>(drain_buffer_);
+        batch = batch.first(std::min(remaining, batch.size()));
+        const size_t count = source.drainInto(batch);
+        CollapseResult kept{count, 0};
+        if (collapse && count > 0) {
+            kept = repeat_collapser_.collapse(batch.first(count), *filter);
+            metrics_.add(LoggerMetrics::Counter::kRepeatsCollapsed, kept.removed);
+        }
+        if (pipeline) {
+            // Formatted and written asynchronously; the pipeline releases the payloads
+            pipeline->submitBatch(kept.size, formatter, router_.get());
+        }
+        if (count == 0) {
+            break;
+        }
+        remaining -= count;
+
+        metrics_.recordBatch(count);
+        metrics_.add(LoggerMetrics::Counter::kEntriesWritten, count - kept.removed);
+        if (pipeline) {
+            continue;
+        }
+        writeEntries(batch.first(kept.size));
+
+        // Release payloads now rather than when the slot is next overwritten
+        for (auto& entry : batch.first(kept.size)) {
+            entry.storage.reset();
+        }
+    }
+}
+
+void AsyncLogger::writeEntries(std::span<const LogEntry> entries) {
+    if (!file_manager_ || entries.empty()) return;
+
+    const bool binary = file_manager_->GetOutputFormat() == LogFileFormat::kBinary;
+    const FormatPipeline::EntryFormatter formatter = activeFormatter();
+    const bool fan_out = sinks_ && sinks_->hasSinks();
+    const LogRouter* router = router_.get();
+    const bool record_lines = fan_out || router;
+
+    // Record where each line starts in text, and its route targets, for the sinks and routed files
+    auto addLine = [router](std::vector<FormattedLine>& lines, const std::string& text, size_t offset,
+                            const LogEntry& entry) {
+        lines.push_back(FormattedLine{static_cast<uint32_t>(offset),
+                                      static_cast<uint32_t>(text.size() - offset), entry.level,
+                                      router ? router->route(entry.tag, entry.level) : 0});
+    };
+
+    write_buffer_.clear();
+    write_lines_.clear();
     for (const auto& entry : entries) {
-        std::string formatted = formatLogEntry(entry);
-        file_manager_->Write(formatted);
+        if (binary) {
+            // A new file (including one opened by rotation in writeChunk) has a new header
+            if (encoder_generation_ != file_manager_->GetFileGeneration()) {
+                encoder_generation_ = file_manager_->GetFileGeneration();
+                binary_encoder_.reset(file_manager_->GetBinaryHeader());
+            }
+            binary_encoder_.encode(entry, write_buffer_);
+            if (record_lines) {
+                // Sinks and routed files get text; this is the only formatting a binary entry gets
+                const size_t offset = sink_text_.size();
+                sink_text_ += formatter(entry);
+                addLine(sink_lines_, sink_text_, offset, entry);
+            }
+        } else {
+            const size_t offset = write_buffer_.size();
+            write_buffer_ += formatter(entry);
+            if (record_lines) {
+                addLine(write_lines_, write_buffer_, offset, entry);
+            }
+        }
+        if (write_buffer_.size() >= kWriteChunkBytes) {
+            writeChunk(write_buffer_, write_lines_);
+            write_buffer_.clear();
+            write_lines_.clear();
+        }
     }
+    writeChunk(write_buffer_, write_lines_);
+    write_buffer_.clear();
+    write_lines_.clear();
+
+    if (!sink_lines_.empty()) {
+        if (router) {
+            writeRoutes(sink_text_, sink_lines_);
+        }
+        if (fan_out) {
+            fanOut(sink_text_, sink_lines_);
+        }
+        sink_text_.clear();
+        sink_lines_.clear();
+    }
+}
+
+void AsyncLogger::writeChunk(const std::string& chunk, std::span<const FormattedLine> lines) {
+    if (chunk.empty()) return;
+
+    // Stage the formatted bytes so a crash before they reach the OS can replay them.
+    const size_t staged = crash_handler_->stageEmergencyBytes(chunk.data(), chunk.size());
+    if (staged < chunk.size()) {
+        metrics_.add(LoggerMetrics::Counter::kEmergencyBytesUnstaged, chunk.size() - staged);
+    }
+    auto start = std::chrono::steady_clock::now();
+    file_manager_->Write(chunk);
+    file_manager_->FlushBuffer();
+    crash_handler_->commitEmergencyBytes();
+    metrics_.recordFlushLatency(std::chrono::steady_clock::now() - start);
+    metrics_.add(LoggerMetrics::Counter::kBytesWritten, chunk.size());
+
+    if (file_manager_->NeedsRotation() && file_manager_->Rotate()) {
+        // The staged bytes must be replayed into the new file
+        crash_handler_->attachEmergencyFile(file_manager_->GetFileDescriptor());
+    }
+
+    if (!lines.empty() && router_) {
+        writeRoutes(chunk, lines);
+    }
+    if (!lines.empty() && sinks_ && sinks_->hasSinks()) {
+        fanOut(chunk, lines);
+    }
+}
+
+void AsyncLogger::writeRoutes(std::string_view text, std::span<const FormattedLine> lines) {
+    for (const auto& line : lines) {
+        for (uint32_t routes = line.routes; routes != 0; routes &= routes - 1) {
+            route_buffers_[std::countr_zero(routes)].append(text.substr(line.offset, line.size));
+        }
+    }
+    for (size_t i = 0; i < route_buffers_.size(); ++i) {
+        if (route_buffers_[i].empty()) {
+            continue;
+        }
+        FileManager& file = *route_files_[i];
+        file.Write(route_buffers_[i]);
+        file.FlushBuffer();
+        if (file.NeedsRotation()) {
+            file.Rotate();
+        }
+        route_buffers_[i].clear();
+    }
+}
+
+void AsyncLogger::fanOut(std::string_view text, std::span<const FormattedLine> lines) {
+    std::shared_ptr<SinkBatch> batch = sinks_->acquireBatch();
+    batch->text.assign(text);
+    batch->lines.assign(lines.begin(), lines.end());
+    sinks_->publish(std::move(batch));
+}
+
+void AsyncLogger::addSink(std::shared_ptr<LogSink> sink) {
+    if (sinks_) {
+        sinks_->addSink(std::move(sink));
+    }
+}
+
+std::vector<SinkStats> AsyncLogger::getSinkStats() const {
+    return sinks_ ? sinks_->getStats() : std::vector<SinkStats>();
+}
+
+bool AsyncLogger::setRoutes(const std::vector<RouteTarget>& targets) {
+    if (!initialized_) {
+        return false;
+    }
+    std::unique_ptr<LogRouter> router;
+    if (!targets.empty()) {
+        router = LogRouter::compile(targets);
+        if (!router) {
+            return false;
+        }
+    }
+
+    // Everything already queued is routed by the old rules
+    std::lock_guard<std::mutex> lock(write_mutex_);
+    drainAndWrite(*lanes_);
+    if (format_pipeline_) {
+        format_pipeline_->waitIdle();
+    }
+
+    // A target keeping its name keeps its open file; the others are opened before
+    // anything changes, so a failure leaves the old routes in place
+    const std::vector<RouteTarget> no_targets;
+    const std::vector<RouteTarget>& old_targets = router_ ? router_->targets() : no_targets;
+    const std::vector<RouteTarget>& new_targets = router ? router->targets() : no_targets;
+    std::vector<std::unique_ptr<FileManager>> files(new_targets.size());
+    std::vector<size_t> reused(new_targets.size(), old_targets.size());
+    for (size_t i = 0; i < new_targets.size(); ++i) {
+        for (size_t j = 0; j < old_targets.size(); ++j) {
+            if (old_targets[j].name == new_targets[i].name) {
+                reused[i] = j;
+            }
+        }
+        if (reused[i] < old_targets.size()) {
+            continue;
+        }
+        files[i] = std::make_unique<FileManager>(base_name_ + "." + new_targets[i].name);
+        files[i]->SetOutputFormat(routedFormat(file_manager_->GetOutputFormat()));
+        if (!files[i]->Initialize(process_id_)) {
+            return false;
+        }
+    }
+
+    for (size_t i = 0; i < new_targets.size(); ++i) {
+        if (reused[i] < old_targets.size()) {
+            files[i] = std::move(route_files_[reused[i]]);
+        }
+        const RouteTarget& target = new_targets[i];
+        files[i]->SetMaxFileSize(target.max_file_size > 0 ? target.max_file_size
+                                                          : FileManager::kDefaultMaxFileSize);
+        files[i]->SetRetentionCount(target.retention_count > 0 ? target.retention_count
+                                                               : FileManager::kDefaultRetentionCount);
+    }
+    route_files_ = std::move(files);
+    route_buffers_.assign(route_files_.size(), std::string());
+    router_ = std::move(router);
+    return true;
+}
+
+std::vector<std::string> AsyncLogger::getRouteFileNames() const {
+    std::lock_guard<std::mutex> lock(write_mutex_);
+    std::vector<std::string> names;
+    for (const auto& file : route_files_) {
+        names.push_back(file->GetLogFileName());
+    }
+    return names;
+}
+
+bool AsyncLogger::enableFlightRecorder(const FlightRecorderOptions& options) {
+    if (!initialized_ || flight_recorder_owner_) {
+        return false;
+    }
+    if (options.dump_signal != 0 && !FlightRecorder::installSignalHandler(options.dump_signal)) {
+        return false;
+    }
+    // Under write_mutex_ so a concurrent layout change cannot be missed
+    std::lock_guard<std::mutex> lock(write_mutex_);
+    flight_recorder_owner_ = std::make_unique<FlightRecorder>(
+        options.dump_base.empty() ? base_name_ : options.dump_base, process_id_, options, activeFormatter());
+    flight_recorder_.store(flight_recorder_owner_.get(), std::memory_order_release);
+    return true;
+}
+
+std::string AsyncLogger::dumpFlightRecorder() {
+    FlightRecorder* recorder = flight_recorder_.load(std::memory_order_acquire);
+    return recorder ? recorder->dump() : std::string();
+}
+
+FlightRecorderStats AsyncLogger::getFlightRecorderStats() const {
+    const FlightRecorder* recorder = flight_recorder_.load(std::memory_order_acquire);
+    return recorder ? recorder->getStats() : FlightRecorderStats();
 }
 
 AsyncLogger::AsyncLogger()
-    : process_id_(getProcessId()), queue_size_(0), sem_(0) {
+    : process_id_(getProcessId()), queue_size_(0) {
     // Default ctor. Call initialize(...) to set up components.
 }
 
-bool AsyncLogger::initialize(const std::string& base_name, size_t queue_size) {
+bool AsyncLogger::initialize(const std::string& base_name, size_t queue_size, size_t formatter_threads) {
     if (initialized_) return true;
     queue_size_ = queue_size;
-    if (!initializeComponents(base_name, queue_size)) {
+    if (!initializeComponents(base_name, queue_size, formatter_threads)) {
         initialized_ = false;
         return false;
     }
@@ -69,14 +365,21 @@ void AsyncLogger::deinitialize() {
 
     // Request thread stop and wake it up
     writer_thread_.request_stop();
-    sem_.release();  // Signal writer thread to wake up
+    wakeup_.notify();  // Wake the writer if it is parked
 
     if (writer_thread_.joinable()) {
         writer_thread_.join();
     }
 
-    // Flush any remaining entries
+    // Flush any remaining entries, then stop the pipeline threads
     flush();
+    format_pipeline_.reset();
+    sinks_.reset();
+    router_.reset();
+    route_files_.clear();
+
+    // Final dump reflects everything written above
+    metrics_dumper_.stop();
 
     initialized_ = false;
 }
@@ -87,92 +390,387 @@ AsyncLogger::~AsyncLogger() {
 }
 
 void AsyncLogger::setLogLevel(LogLevel level) {
-    min_level_ = level;
+    min_level_.store(level, std::memory_order_relaxed);
 }
 
 LogLevel AsyncLogger::getLogLevel() const {
-    return min_level_;
+    return min_level_.load(std::memory_order_relaxed);
+}
+
+void AsyncLogger::setWaitStrategy(WaitStrategy strategy) {
+    wait_strategy_.store(strategy, std::memory_order_relaxed);
+}
+
+WaitStrategy AsyncLogger::getWaitStrategy() const {
+    return wait_strategy_.load(std::memory_order_relaxed);
+}
+
+bool AsyncLogger::setOutputFormat(LogFileFormat format) {
+    if (!initialized_) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(write_mutex_);
+    if (file_manager_->GetOutputFormat() == format) {
+        return true;
+    }
+
+    // Everything already queued goes out in the old format
+    drainAndWrite(*lanes_);
+    if (format_pipeline_) {
+        format_pipeline_->waitIdle();
+    }
+
+    if (!file_manager_->SetOutputFormat(format)) {
+        return false;
+    }
+    crash_handler_->attachEmergencyFile(file_manager_->GetFileDescriptor());
+    for (auto& file : route_files_) {
+        file->SetOutputFormat(routedFormat(format));
+    }
+    if (flight_recorder_owner_) {
+        flight_recorder_owner_->setFormatter(activeFormatter());
+    }
+    return true;
+}
+
+LogFileFormat AsyncLogger::getOutputFormat() const {
+    std::lock_guard<std::mutex> lock(write_mutex_);
+    return file_manager_ ? file_manager_->GetOutputFormat() : LogFileFormat::kText;
+}
+
+void AsyncLogger::setOverflowPolicy(const OverflowPolicy& policy) {
+    overflow_timeout_us_.store(policy.block_timeout.count(), std::memory_order_relaxed);
+    overflow_min_level_.store(policy.min_level, std::memory_order_relaxed);
+    overflow_mode_.store(policy.mode, std::memory_order_release);
+}
+
+OverflowPolicy AsyncLogger::getOverflowPolicy() const {
+    OverflowPolicy policy;
+    policy.mode = overflow_mode_.load(std::memory_order_acquire);
+    policy.block_timeout = std::chrono::microseconds(overflow_timeout_us_.load(std::memory_order_relaxed));
+    policy.min_level = overflow_min_level_.load(std::memory_order_relaxed);
+    return policy;
 }
 
-void AsyncLogger::log(LogLevel level, const std::string& tag,
-                const std::string& message) {
+void AsyncLogger::setTagFilter(const speckit::log::TagFilter* filter) {
+    tag_filter_.store(filter, std::memory_order_release);
+}
+
+void AsyncLogger::setLineFormatter(FormatPipeline::EntryFormatter formatter) {
+    if (!formatter) {
+        formatter = formatLogEntry;
+    }
+    if (!initialized_) {
+        line_formatter_.store(formatter, std::memory_order_relaxed);
+        return;
+    }
+
+    // Everything already queued goes out with the old layout
+    std::lock_guard<std::mutex> lock(write_mutex_);
+    drainAndWrite(*lanes_);
+    line_formatter_.store(formatter, std::memory_order_relaxed);
+    if (flight_recorder_owner_) {
+        flight_recorder_owner_->setFormatter(activeFormatter());
+    }
+}
+
+FormatPipeline::EntryFormatter AsyncLogger::getLineFormatter() const {
+    return line_formatter_.load(std::memory_order_relaxed);
+}
+
+size_t AsyncLogger::getFormatterThreads() const {
+    return format_pipeline_ ? format_pipeline_->formatterThreads() : 0;
+}
+
+bool AsyncLogger::passesTagFilter(LogLevel level, std::string_view tag, const std::source_location& site) {
+    const speckit::log::TagFilter* filter = tag_filter_.load(std::memory_order_acquire);
+    if (!filter) {
+        return true;
+    }
+    if (!filter->isTagEnabled(tag) || !::shouldLog(level, filter->getTagLevel(tag))) {
+        return false;
+    }
+    if (!filter->sample(tag, level)) {
+        metrics_.add(LoggerMetrics::Counter::kEntriesSampledOut);
+        return false;
+    }
+    if (filter->hasRateLimits() && !rate_limiter_.tryAcquire(site, tag, *filter)) {
+        metrics_.add(LoggerMetrics::Counter::kEntriesRateLimited);
+        return false;
+    }
+    return true;
+}
+
+AsyncLogger::Admission AsyncLogger::admit(LogLevel level, std::string_view tag,
+                                          const std::source_location& site) {
     // Check if message should be logged (fast path - no locking)
-    if (!::shouldLog(level, min_level_)) {
-        return;  // Filtered out - no queuing needed
+    if (!::shouldLog(level, min_level_.load(std::memory_order_relaxed))) {
+        // Filtered out - no queuing needed, but the flight recorder may keep it
+        if (!flight_recorder_.load(std::memory_order_relaxed) || !initialized_) {
+            return Admission::kSkip;
+        }
+        const speckit::log::TagFilter* filter = tag_filter_.load(std::memory_order_acquire);
+        return !filter || filter->isTagEnabled(tag) ? Admission::kRecord : Admission::kSkip;
     }
-    
+
     if (!initialized_) {
-        return;  // Logger not initialized
+        return Admission::kSkip;  // Logger not initialized
     }
-    
-    // Create log entry
-    LogEntry entry(
+
+    return passesTagFilter(level, tag, site) ? Admission::kQueue : Admission::kSkip;
+}
+
+namespace {
+
+thread_local std::array<std::string, AsyncLogger::kMessageBufferDepth> t_message_buffers;
+thread_local size_t t_message_buffer_depth = 0;
+
+}  // namespace
+
+AsyncLogger::MessageBuffer::MessageBuffer() : buffer_(&overflow_) {
+    if (t_message_buffer_depth < kMessageBufferDepth) {
+        buffer_ = &t_message_buffers[t_message_buffer_depth];
+        buffer_->clear();
+    }
+    ++t_message_buffer_depth;
+}
+
+AsyncLogger::MessageBuffer::~MessageBuffer() {
+    --t_message_buffer_depth;
+    if (buffer_->capacity() > kMaxRetainedMessageBuffer) {
+        std::string().swap(*buffer_);
+    }
+}
+
+void AsyncLogger::log(LogLevel level, std::string_view tag, std::string_view message,
+                      std::source_location site) {
+    const Admission admission = admit(level, tag, site);
+    if (admission != Admission::kSkip) {
+        enqueueMessage(admission, level, tag, message);
+    }
+}
+
+void AsyncLogger::enqueueMessage(Admission admission, LogLevel level, std::string_view tag,
+                                 std::string_view message, std::string_view fields, bool deferred) {
+    FlightRecorder* recorder = flight_recorder_.load(std::memory_order_acquire);
+    if (admission == Admission::kRecord) {
+        // The ring copies the bytes, so the entry can point at the caller's
+        LogEntry entry(level, getTimestamp(), process_id_, getThreadId(), tag, message);
+        entry.fields = fields;
+        entry.deferred = deferred;
+        recorder->record(entry);
+        return;
+    }
+    if (recorder && recorder->dumpsOnLevel() && ::shouldLog(level, recorder->getDumpLevel())) {
+        recorder->requestDump();
+    }
+
+    // Create log entry; it owns its strings because the writer formats it later
+    LogEntry entry = LogEntry::createOwned(
         level,
         getTimestamp(),
         process_id_,
         getThreadId(),
         tag,
-        message
+        message,
+        fields
     );
-    
-    // Try to push to async queue (non-blocking)
-    if (async_queue_->tryPush(std::move(entry))) {
-        // Success - notify writer thread
-        sem_.release();
-    } else {
-        // Queue full - try ring buffer for crash safety
-        if (!ring_buffer_->tryPush(std::move(entry))) {
-            // Ring buffer also full - silently drop to prevent blocking
-            return;
+    entry.deferred = deferred;
+
+    enqueue(std::move(entry));
+}
+
+void AsyncLogger::log(LogLevel level, std::string_view tag, std::string_view message,
+                      std::initializer_list<LogField> fields, std::source_location site) {
+    const Admission admission = admit(level, tag, site);
+    if (admission == Admission::kSkip) {
+        return;
+    }
+
+    // Reused per thread so encoding does not allocate in the steady state
+    thread_local std::string encoded;
+    encoded.clear();
+    speckit::log::encodeFields(fields, encoded);
+
+    enqueueMessage(admission, level, tag, message, encoded);
+}
+
+bool AsyncLogger::vlogf(LogLevel level, std::string_view tag, const char* format, va_list args,
+                        std::source_location site) {
+    const Admission admission = admit(level, tag, site);
+    if (admission == Admission::kSkip) {
+        return true;  // Filtered out; the arguments are never read
+    }
+
+    // Reused per thread so capturing does not allocate in the steady state
+    thread_local std::string captured;
+    captured.clear();
+    if (!speckit::log::capturePrintf(format, args, captured)) {
+        return false;
+    }
+
+    enqueueMessage(admission, level, tag, captured, {}, true);
+    return true;
+}
+
+void AsyncLogger::enqueue(LogEntry&& entry) {
+    const OverflowMode mode = overflow_mode_.load(std::memory_order_relaxed);
+
+    // Keep the last quarter of the queue for entries at or above the policy level
+    if (mode == OverflowMode::kDropBelowLevel &&
+        !::shouldLog(entry.level, overflow_min_level_.load(std::memory_order_relaxed)) &&
+        async_queue_->size() >= async_queue_->capacity() - async_queue_->capacity() / 4) {
+        metrics_.addDropped(entry.level);
+        return;
+    }
+
+    // Important entries stay in order in the main queue and use their reserved lane
+    // only while it is full
+    if (async_queue_->tryPush(entry) ||
+        (::shouldLog(entry.level, kPriorityLaneLevel) && priority_queue_->tryPush(entry)) ||
+        pushOnOverflow(entry, mode)) {
+        // Success - wake the writer only if it is parked
+        metrics_.add(LoggerMetrics::Counter::kEntriesEnqueued);
+        wakeup_.notify();
+        return;
+    }
+
+    // Never write from here: I/O belongs to the writer, and producers must not stall on it
+    metrics_.addDropped(entry.level);
+}
+
+bool AsyncLogger::pushOnOverflow(LogEntry& entry, OverflowMode mode) {
+    switch (mode) {
+    case OverflowMode::kDropOldest: {
+        // Other producers may take the freed slot first, so allow a few rounds
+        LogEntry evicted;
+        for (int attempt = 0; attempt < kMaxEvictionAttempts; ++attempt) {
+            if (async_queue_->tryPopOldest(evicted)) {
+                metrics_.addDropped(evicted.level);
+                evicted.storage.reset();
+            }
+            if (async_queue_->tryPush(entry)) {
+                return true;
+            }
         }
-        // Flush ring buffer to free up space
-        flush();
+        return false;
+    }
+    case OverflowMode::kBlock: {
+        const auto deadline = std::chrono::steady_clock::now() +
+            std::chrono::microseconds(overflow_timeout_us_.load(std::memory_order_relaxed));
+        int spins = 0;
+        do {
+            wakeup_.notify();  // The writer may be parked on an earlier, emptier view
+            if (spins < WriterWakeup::kSpinIterations) {
+                ++spins;
+                std::this_thread::yield();
+            } else {
+                std::this_thread::sleep_for(kBlockPollInterval);
+            }
+            if (async_queue_->tryPush(entry)) {
+                return true;
+            }
+        } while (std::chrono::steady_clock::now() < deadline);
+        return false;
+    }
+    case OverflowMode::kDropNewest:
+    case OverflowMode::kDropBelowLevel:
+        break;
+    }
+    return false;
+}
+
+void AsyncLogger::reportDrops() {
+    const std::array<uint64_t, kLogLevelCount> dropped = metrics_.droppedByLevel();
+    uint64_t total = 0;
+    std::string detail;
+    for (size_t i = 0; i < kLogLevelCount; ++i) {
+        const uint64_t count = dropped[i] - reported_drops_[i];
+        if (count > 0) {
+            total += count;
+            detail += std::format("{}{}={}", detail.empty() ? "" : ", ",
+                                  levelToString(static_cast<LogLevel>(i)), count);
+        }
+    }
+    if (total == 0) {
+        return;
+    }
+    reported_drops_ = dropped;
+
+    // Goes through the same formatter and file as the entries around it, but is not
+    // counted as a written entry
+    LogEntry marker = LogEntry::createOwned(LogLevel::kLogLevelWarning, getTimestamp(), process_id_,
+                                            getThreadId(), kLossMarkerTag,
+                                            std::format("{} entries dropped ({})", total, detail));
+    if (FormatPipeline* pipeline = activePipeline()) {
+        std::span<LogEntry> batch = pipeline->acquireBatch();
+        batch[0] = std::move(marker);
+        pipeline->submitBatch(1, activeFormatter(), router_.get());
+    } else {
+        writeEntries(std::span<const LogEntry>(&marker, 1));
     }
 }
 
 void AsyncLogger::flush() {
-    // Get all entries from async queue
-    auto queue_entries = async_queue_->popAll();
-    
-    // Get all entries from ring buffer
-    auto ring_entries = ring_buffer_->popAll();
-    
-    // Write all entries to file
-    writeEntries(queue_entries);
-    writeEntries(ring_entries);
-    
-    // Force file flush
-    if (file_manager_) {
-        // FileManager handles periodic flushing
+    drainPending();
+
+    // Entries handed to the pipeline are written once this returns
+    if (format_pipeline_) {
+        format_pipeline_->waitIdle();
+    }
+    if (sinks_) {
+        sinks_->waitIdle();
+    }
+}
+
+void AsyncLogger::drainPending() {
+    // Draining is single-consumer; the writer thread and flush() callers take turns
+    std::lock_guard<std::mutex> lock(write_mutex_);
+
+    const size_t depth = lanes_->size();
+    if (depth > 0) {
+        metrics_.observeQueueDepth(depth);
+    }
+
+    drainAndWrite(*lanes_);
+
+    // Caught up: say in the log itself how much was lost since the last report
+    if (metrics_.value(LoggerMetrics::Counter::kEntriesDropped) != reported_drop_total_) {
+        reported_drop_total_ = metrics_.value(LoggerMetrics::Counter::kEntriesDropped);
+        reportDrops();
     }
 }
 
 void AsyncLogger::writerThread(std::stop_token stop_token) {
-    while (!stop_token.stop_requested()) {
-        // Wait for entries or stop request using semaphore
-        sem_.acquire();
+    // This thread stages bytes for crash replay; a stack overflow here must still reach the handler
+    CrashHandler::installAltStackForCurrentThread();
 
-        if (stop_token.stop_requested()) {
-            // Process remaining entries before exiting
-            flush();
-            break;
-        }
+    auto has_work = [&]() {
+        return stop_token.stop_requested() || !lanes_->isEmpty();
+    };
 
-        // Flush all queued entries
-        flush();
+    while (!stop_token.stop_requested()) {
+        // Wait for entries or stop request
+        const uint64_t parks = wakeup_.parks();
+        wakeup_.wait(wait_strategy_.load(std::memory_order_relaxed), has_work);
+        metrics_.add(LoggerMetrics::Counter::kWriterParks, wakeup_.parks() - parks);
+
+        // Hand off all queued entries; remaining ones are flushed by deinitialize().
+        // With formatter threads this does not wait for them, so the next batches
+        // are cut while earlier ones are still being formatted and written.
+        drainPending();
     }
 }
 
 void AsyncLogger::emergencyFlush() {
     // Emergency flush on crash - write all buffers
+    std::lock_guard<std::mutex> lock(write_mutex_);
     
-    // Flush async queue
-    auto queue_entries = async_queue_->popAll();
-    writeEntries(queue_entries);
-    
-    // Flush ring buffer
-    auto ring_entries = ring_buffer_->popAll();
-    writeEntries(ring_entries);
+    drainAndWrite(*lanes_);
+    if (format_pipeline_) {
+        format_pipeline_->waitIdle();
+    }
     
     // Force file flush immediately
     // Note: This requires FileManager interface to support immediate flush
@@ -182,6 +780,26 @@ void AsyncLogger::emergencyFlush() {
     }
 }
 
+std::string AsyncLogger::getLogFileName() const {
+    return file_manager_ ? file_manager_->GetLogFileName() : std::string();
+}
+
+MetricsSnapshot AsyncLogger::getMetrics() const {
+    return metrics_.snapshot();
+}
+
+bool AsyncLogger::hasCrashReplay() const {
+    return crash_handler_ && crash_handler_->hasEmergencySlot();
+}
+
+bool AsyncLogger::setMetricsDump(const std::string& path, std::chrono::milliseconds interval) {
+    if (interval.count() <= 0) {
+        metrics_dumper_.stop();
+        return false;
+    }
+    return metrics_dumper_.start(metrics_, path, interval);
+}
+
 ProcessIdType AsyncLogger::getProcessId() const {
 #ifdef SPECKIT_PLATFORM_WINDOWS
     return GetCurrentProcessId();
@@ -74,45 +74,16 @@ bool AsyncQueue::tryPush(LogEntry&& entry) {
 
 std::vector<LogEntry> AsyncQueue::popAll() {
     std::vector<LogEntry> result;
-    const size_t cap = capacity_;
-
-    size_t head = head_.load(std::memory_order_relaxed);
-    size_t tail = tail_.load(std::memory_order_acquire);
-
-    size_t available = (tail >= head) ? (tail - head) : 0;
-    if (available == 0) {
-        return result;
-    }
-
-    result.reserve(available);
-
-    for (size_t i = 0; i < available; ++i) {
-        size_t idx = (head + i) % cap;
-        Cell& cell = buffer_[idx];
-
-        // Wait until producer published slot: seq == head + i + 1
-        size_t expected = head + i + 1;
-        while (cell.seq.load(std::memory_order_acquire) != expected) {
-            std::this_thread::yield();
-        }
-
-        // Move entry out if present
-        if (cell.storage.has_value()) {
-            result.push_back(std::move(*cell.storage));
-            cell.storage.reset();
-        }
-
-        // Mark slot free for future producers: set seq = head + i + cap
-        cell.seq.store(head + i + cap, std::memory_order_release);
-    }
-
-    // Advance head and update size
-    head_.store(head + available, std::memory_order_release);
-    size_.fetch_sub(available, std::memory_order_acq_rel);
-
+    result.reserve(size());
+    drain([&result](LogEntry& entry) { result.push_back(std::move(entry)); });
     return result;
 }
 
+size_t AsyncQueue::drainInto(std::span<LogEntry> out) {
+    size_t count = 0;
+    return drain([&out, &count](LogEntry& entry) { out[count++] = std::move(entry); }, out.size());
+}
+
 bool AsyncQueue::isEmpty() const {
     return size_.load(std::memory_order_acquire) == 0;
 }
@@ -0,0 +1,230 @@
+// Binary log format implementation
+
+#include "speckit/log/binary_log_format.h"
+#include "speckit/log/printf_capture.h"
+#include "speckit/log/log_fields.h"
+#include <chrono>
+#include <cstring>
+
+namespace {
+
+using speckit::log::appendVarint;
+
+void appendFixed(std::string& out, uint64_t value, int bytes) {
+    for (int i = 0; i < bytes; ++i) {
+        out.push_back(static_cast<char>((value >> (8 * i)) & 0xff));
+    }
+}
+
+uint64_t readFixed(const char* data, int bytes) {
+    uint64_t value = 0;
+    for (int i = 0; i < bytes; ++i) {
+        value |= static_cast<uint64_t>(static_cast<uint8_t>(data[i])) << (8 * i);
+    }
+    return value;
+}
+
+uint64_t zigzagEncode(int64_t value) {
+    return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+int64_t zigzagDecode(uint64_t value) {
+    return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+void appendString(std::string& out, uint8_t kind, uint32_t id, std::string_view text) {
+    out.push_back(static_cast<char>(kind));
+    appendVarint(out, id);
+    appendVarint(out, text.size());
+    out.append(text);
+}
+
+/// Upper bound for a single tag, thread or message field; guards against corrupt lengths
+constexpr uint64_t kMaxFieldBytes = 64ull * 1024 * 1024;
+
+}  // namespace
+
+BinaryFileHeader BinaryFileHeader::now(ProcessIdType process_id) {
+    BinaryFileHeader header;
+    header.process_id = static_cast<uint64_t>(process_id);
+    header.wall_clock_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    header.steady_clock_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+    return header;
+}
+
+void BinaryFileHeader::encode(std::string& out) const {
+    out.append(kMagic, sizeof(kMagic));
+    appendFixed(out, version, 4);
+    appendFixed(out, process_id, 8);
+    appendFixed(out, static_cast<uint64_t>(wall_clock_ms), 8);
+    appendFixed(out, static_cast<uint64_t>(steady_clock_ns), 8);
+}
+
+void BinaryLogEncoder::reset(const BinaryFileHeader& header) {
+    tags_.clear();
+    threads_.clear();
+    last_timestamp_ms_ = header.wall_clock_ms;
+    process_id_ = header.process_id;
+}
+
+void BinaryLogEncoder::encode(const LogEntry& entry, std::string& out) {
+    auto tag = tags_.find(entry.tag);
+    if (tag == tags_.end()) {
+        tag = tags_.emplace(std::string(entry.tag), static_cast<uint32_t>(tags_.size())).first;
+        appendString(out, kRecordTag, tag->second, entry.tag);
+    }
+
+    auto thread = threads_.find(entry.thread_id);
+    if (thread == threads_.end()) {
+        thread = threads_.emplace(entry.thread_id, static_cast<uint32_t>(threads_.size())).first;
+        appendString(out, kRecordThread, thread->second, threadIdToString(entry.thread_id));
+    }
+
+    const uint64_t pid = static_cast<uint64_t>(entry.process_id);
+    uint8_t flags = static_cast<uint8_t>(entry.level) & kFlagLevelMask;
+    if (entry.deferred) flags |= kFlagDeferred;
+    if (pid != process_id_) flags |= kFlagProcessId;
+    if (!entry.fields.empty()) flags |= kFlagFields;
+
+    out.push_back(static_cast<char>(kRecordEntry));
+    out.push_back(static_cast<char>(flags));
+    appendVarint(out, zigzagEncode(entry.timestamp_ms - last_timestamp_ms_));
+    appendVarint(out, tag->second);
+    appendVarint(out, thread->second);
+    if (flags & kFlagProcessId) {
+        appendVarint(out, pid);
+    }
+    appendVarint(out, entry.message.size());
+    out.append(entry.message);
+    if (flags & kFlagFields) {
+        appendVarint(out, entry.fields.size());
+        out.append(entry.fields);
+    }
+
+    last_timestamp_ms_ = entry.timestamp_ms;
+}
+
+BinaryLogDecoder::BinaryLogDecoder(std::istream& in) : in_(in) {
+}
+
+BinaryLogDecoder::Status BinaryLogDecoder::fail(std::string message) {
+    error_ = std::move(message);
+    return Status::kError;
+}
+
+bool BinaryLogDecoder::readVarint(uint64_t& value) {
+    value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        const int byte = in_.get();
+        if (byte == std::char_traits<char>::eof()) {
+            return false;
+        }
+        value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+        if ((byte & 0x80) == 0) {
+            return true;
+        }
+    }
+    return false;  // Over-long encoding
+}
+
+bool BinaryLogDecoder::readBytes(std::string& out, uint64_t length) {
+    if (length > kMaxFieldBytes) {
+        return false;
+    }
+    out.resize(static_cast<size_t>(length));
+    in_.read(out.data(), static_cast<std::streamsize>(length));
+    return static_cast<uint64_t>(in_.gcount()) == length;
+}
+
+bool BinaryLogDecoder::readHeader() {
+    char bytes[BinaryFileHeader::kSize];
+    in_.read(bytes, sizeof(bytes));
+    if (in_.gcount() != static_cast<std::streamsize>(sizeof(bytes)) ||
+        std::memcmp(bytes, BinaryFileHeader::kMagic, sizeof(BinaryFileHeader::kMagic)) != 0) {
+        return false;
+    }
+
+    const char* field = bytes + sizeof(BinaryFileHeader::kMagic);
+    header_.version = static_cast<uint32_t>(readFixed(field, 4));
+    header_.process_id = readFixed(field + 4, 8);
+    header_.wall_clock_ms = static_cast<int64_t>(readFixed(field + 12, 8));
+    header_.steady_clock_ns = static_cast<int64_t>(readFixed(field + 20, 8));
+
+    tags_.clear();
+    threads_.clear();
+    last_timestamp_ms_ = header_.wall_clock_ms;
+    have_header_ = true;
+    return true;
+}
+
+BinaryLogDecoder::Status BinaryLogDecoder::next(std::string& line) {
+    while (true) {
+        const int kind = in_.peek();
+        if (kind == std::char_traits<char>::eof()) {
+            return have_header_ ? Status::kEnd : fail("missing file header");
+        }
+
+        if (kind == BinaryLogEncoder::kRecordHeader) {
+            if (!readHeader()) {
+                return fail("bad file header");
+            }
+            if (header_.version != BinaryFileHeader::kVersion) {
+                return fail("unsupported version " + std::to_string(header_.version));
+            }
+            continue;
+        }
+        if (!have_header_) {
+            return fail("missing file header");
+        }
+        in_.get();
+
+        if (kind == BinaryLogEncoder::kRecordTag || kind == BinaryLogEncoder::kRecordThread) {
+            auto& table = (kind == BinaryLogEncoder::kRecordTag) ? tags_ : threads_;
+            uint64_t id = 0;
+            uint64_t length = 0;
+            if (!readVarint(id) || id != table.size() || !readVarint(length)) {
+                return fail("bad definition record");
+            }
+            table.emplace_back();
+            if (!readBytes(table.back(), length)) {
+                return fail("truncated definition record");
+            }
+            continue;
+        }
+
+        if (kind != BinaryLogEncoder::kRecordEntry) {
+            return fail("unknown record type " + std::to_string(kind));
+        }
+
+        const int flags = in_.get();
+        uint64_t delta = 0;
+        uint64_t tag = 0;
+        uint64_t thread = 0;
+        uint64_t pid = header_.process_id;
+        uint64_t length = 0;
+        if (flags == std::char_traits<char>::eof() || !readVarint(delta) || !readVarint(tag) ||
+            !readVarint(thread) ||
+            ((flags & BinaryLogEncoder::kFlagProcessId) && !readVarint(pid)) ||
+            !readVarint(length) || !readBytes(message_, length) ||
+            ((flags & BinaryLogEncoder::kFlagFields) && !(readVarint(length) && readBytes(fields_, length)))) {
+            return fail("truncated entry record");
+        }
+        if (tag >= tags_.size() || thread >= threads_.size()) {
+            return fail("entry refers to an undefined tag or thread");
+        }
+
+        last_timestamp_ms_ += zigzagDecode(delta);
+        const auto level = static_cast<LogLevel>(flags & BinaryLogEncoder::kFlagLevelMask);
+        if (flags & BinaryLogEncoder::kFlagDeferred) {
+            message_ = speckit::log::renderPrintf(message_);
+        }
+        if (flags & BinaryLogEncoder::kFlagFields) {
+            speckit::log::appendFieldsText(message_, fields_);
+        }
+        line = formatLogLine(level, last_timestamp_ms_, static_cast<ProcessIdType>(pid),
+                             threads_[thread], tags_[tag], message_);
+        return Status::kLine;
+    }
+}
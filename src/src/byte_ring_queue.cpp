@@ -0,0 +1,146 @@
+#include "speckit/log/byte_ring_queue.h"
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <type_traits>
+
+static_assert(std::atomic_ref<uint32_t>::required_alignment <= ByteRingQueue::kAlignment,
+              "record headers must be usable with atomic_ref");
+
+ByteRingQueue::ByteRingQueue(size_t budget_bytes)
+    : words_(nullptr),
+      bytes_(nullptr),
+      capacity_(std::bit_ceil(std::max(budget_bytes, kMinCapacity))),
+      mask_(capacity_ - 1) {
+    // Value-initialized: every header starts out as kStateEmpty
+    words_ = std::make_unique<uint64_t[]>(capacity_ / sizeof(uint64_t));
+    bytes_ = reinterpret_cast<char*>(words_.get());
+}
+
+char* ByteRingQueue::reserve(size_t length) {
+    // Larger records could wait forever for a contiguous region
+    if (length > maxRecordBytes()) {
+        return nullptr;
+    }
+    const size_t need = recordBytes(length);
+
+    size_t tail = tail_.load(std::memory_order_relaxed);
+    size_t pos = 0;
+    size_t pad = 0;
+    while (true) {
+        const size_t head = head_.load(std::memory_order_acquire);
+        pos = tail & mask_;
+        // A record never wraps; skip to offset 0 and pad the end of the ring instead
+        pad = (pos + need > capacity_) ? capacity_ - pos : 0;
+        if (tail + pad + need - head > capacity_) {
+            return nullptr;  // Not enough free bytes
+        }
+        if (tail_.compare_exchange_weak(tail, tail + pad + need,
+                                        std::memory_order_acq_rel,
+                                        std::memory_order_relaxed)) {
+            break;
+        }
+        // tail was reloaded by the failed CAS; retry
+    }
+
+    if (pad > 0) {
+        // The padding belongs to this reservation, so it is committed right away
+        auto* header = reinterpret_cast<uint32_t*>(bytes_ + pos);
+        header[1] = static_cast<uint32_t>(pad - kHeaderSize);
+        std::atomic_ref<uint32_t>(header[0]).store(kStatePadding, std::memory_order_release);
+        pos = 0;
+    }
+
+    auto* header = reinterpret_cast<uint32_t*>(bytes_ + pos);
+    header[1] = static_cast<uint32_t>(length);
+    return bytes_ + pos + kHeaderSize;
+}
+
+void ByteRingQueue::commit(char* payload) {
+    auto* header = reinterpret_cast<uint32_t*>(payload - kHeaderSize);
+    std::atomic_ref<uint32_t>(header[0]).store(kStateCommitted, std::memory_order_release);
+}
+
+bool ByteRingQueue::tryPush(std::string_view record) {
+    char* payload = reserve(record.size());
+    if (!payload) {
+        return false;
+    }
+    std::memcpy(payload, record.data(), record.size());
+    commit(payload);
+    return true;
+}
+
+bool ByteRingQueue::tryPushEntry(const LogEntry& entry) {
+    static_assert(std::is_trivially_copyable_v<EntryPrefix>, "EntryPrefix is copied with memcpy");
+
+    EntryPrefix prefix{entry.timestamp_ms,
+                       entry.process_id,
+                       entry.thread_id,
+                       static_cast<uint32_t>(entry.tag.size()),
+                       static_cast<uint32_t>(entry.message.size()),
+                       static_cast<uint32_t>(entry.fields.size()),
+                       entry.level,
+                       entry.deferred};
+
+    char* payload = reserve(sizeof(prefix) + entry.tag.size() + entry.message.size() + entry.fields.size());
+    if (!payload) {
+        return false;
+    }
+    std::memcpy(payload, &prefix, sizeof(prefix));
+    std::memcpy(payload + sizeof(prefix), entry.tag.data(), entry.tag.size());
+    std::memcpy(payload + sizeof(prefix) + entry.tag.size(), entry.message.data(), entry.message.size());
+    std::memcpy(payload + sizeof(prefix) + entry.tag.size() + entry.message.size(),
+                entry.fields.data(), entry.fields.size());
+    commit(payload);
+    return true;
+}
+
+LogEntry ByteRingQueue::decodeEntry(std::string_view record) {
+    EntryPrefix prefix;
+    std::memcpy(&prefix, record.data(), sizeof(prefix));
+
+    const char* tag = record.data() + sizeof(prefix);
+    LogEntry entry(prefix.level, prefix.timestamp_ms, prefix.process_id, prefix.thread_id,
+                   std::string_view(tag, prefix.tag_size),
+                   std::string_view(tag + prefix.tag_size, prefix.message_size));
+    entry.fields = std::string_view(tag + prefix.tag_size + prefix.message_size, prefix.fields_size);
+    entry.deferred = prefix.deferred;
+    return entry;
+}
+
+const char* ByteRingQueue::peek(size_t pos, uint32_t& state, uint32_t& length) const {
+    auto* header = reinterpret_cast<uint32_t*>(bytes_ + pos);
+    state = std::atomic_ref<uint32_t>(header[0]).load(std::memory_order_acquire);
+    length = header[1];
+    return bytes_ + pos + kHeaderSize;
+}
+
+void ByteRingQueue::release(size_t head, size_t bytes) {
+    // Stale payload bytes could otherwise be read as a future record's header
+    const size_t pos = head & mask_;
+    const size_t first = std::min(bytes, capacity_ - pos);
+    std::memset(bytes_ + pos, 0, first);
+    std::memset(bytes_, 0, bytes - first);
+
+    head_.store(head + bytes, std::memory_order_release);
+}
+
+bool ByteRingQueue::isEmpty() const {
+    return sizeBytes() == 0;
+}
+
+size_t ByteRingQueue::sizeBytes() const {
+    const size_t head = head_.load(std::memory_order_acquire);
+    const size_t tail = tail_.load(std::memory_order_acquire);
+    return tail - head;
+}
+
+size_t ByteRingQueue::capacityBytes() const {
+    return capacity_;
+}
+
+size_t ByteRingQueue::maxRecordBytes() const {
+    // With at most half the ring per record, the padding plus the record always fit when empty
+    return capacity_ / 2 - kHeaderSize;
+}
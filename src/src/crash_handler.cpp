@@ -2,9 +2,19 @@
 
 #include "speckit/log/crash_handler.h"
 #include "speckit/log/platform.h"
+#include <algorithm>
 #include <csignal>
+#include <cstring>
 #include <iostream>
 
+#ifndef SPECKIT_PLATFORM_WINDOWS
+#include <cerrno>
+#include <signal.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
 
 
 namespace {
@@ -16,20 +26,105 @@ constexpr int kHandledSignals[] = {
     SIGABRT,
 #else
     SIGSEGV,
+    SIGBUS,
+    SIGFPE,
+    SIGILL,
     SIGABRT,
+    SIGTERM,
 #endif
 };
 
+constexpr size_t kHandledSignalCount = sizeof(kHandledSignals) / sizeof(kHandledSignals[0]);
+
+// Number of live CrashHandler instances; handlers stay installed while any exist.
+std::atomic<int> g_instance_count{0};
+
+#ifndef SPECKIT_PLATFORM_WINDOWS
+
+// Size of the alternate signal stack installed per thread.
+constexpr size_t kAltStackSize = 64 * 1024;
+
+// Dispositions that were active before we installed ours, restored before re-raising.
+struct sigaction g_previous_actions[kHandledSignalCount];
+bool g_installed[kHandledSignalCount] = {};
+
+int signalIndex(int signal) {
+    for (size_t i = 0; i < kHandledSignalCount; ++i) {
+        if (kHandledSignals[i] == signal) {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+// Synchronous faults re-execute the faulting instruction when the handler returns,
+// so they must never be left ignored.
+bool isSynchronousFault(int signal) {
+    return signal == SIGSEGV || signal == SIGBUS || signal == SIGFPE || signal == SIGILL;
+}
+
+// An application handler was installed before ours; the signal may not end the process
+bool isApplicationHandler(const struct sigaction& action) {
+    if (action.sa_flags & SA_SIGINFO) {
+        return action.sa_sigaction != nullptr;
+    }
+    return action.sa_handler != SIG_DFL && action.sa_handler != SIG_IGN;
+}
+
+int64_t monotonicNanos() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);  // async-signal-safe
+    return static_cast<int64_t>(ts.tv_sec) * 1000000000LL + ts.tv_nsec;
+}
+
+#endif
+
 }  // namespace
 
 // Static members
 CrashHandler::FlushCallback CrashHandler::flush_callback_ = nullptr;
 std::atomic<bool> CrashHandler::initialized_{false};
 std::atomic<bool> CrashHandler::flush_requested_{false};
+std::atomic<int> CrashHandler::handler_state_{0};
+std::atomic<CrashHandler::EmergencyBuffer*> CrashHandler::emergency_buffers_[kMaxEmergencyBuffers] = {};
 
-CrashHandler::CrashHandler() { initializeHandlers(); }
+CrashHandler::CrashHandler(size_t emergency_buffer_size) {
+    // Pre-allocate the staging area; nothing is allocated on the crash path.
+    emergency_.data = std::make_unique<char[]>(emergency_buffer_size);
+    emergency_.capacity = emergency_buffer_size;
 
-CrashHandler::~CrashHandler() { cleanupHandlers(); }
+    for (auto& slot : emergency_buffers_) {
+        EmergencyBuffer* expected = nullptr;
+        if (slot.compare_exchange_strong(expected, &emergency_)) {
+            has_slot_ = true;
+            break;
+        }
+    }
+
+    g_instance_count.fetch_add(1);
+    initializeHandlers();
+}
+
+CrashHandler::~CrashHandler() {
+    for (auto& slot : emergency_buffers_) {
+        EmergencyBuffer* expected = &emergency_;
+        if (has_slot_ && slot.compare_exchange_strong(expected, nullptr)) {
+            break;
+        }
+    }
+
+#ifndef SPECKIT_PLATFORM_WINDOWS
+    int fd = emergency_.fd.exchange(-1);
+    if (fd >= 0) {
+        ::close(fd);
+    }
+#endif
+
+    if (g_instance_count.fetch_sub(1) == 1) {
+        cleanupHandlers();
+    }
+    stopMonitor();
+}
 
 void CrashHandler::startMonitor() {
     stop_monitor_.store(false);
@@ -64,6 +159,132 @@ void CrashHandler::emergencyFlush() {
     }
 }
 
+bool CrashHandler::attachEmergencyFile(int fd) {
+#ifdef SPECKIT_PLATFORM_WINDOWS
+    (void)fd;
+    return false;  // Windows uses the monitor thread path
+#else
+    int dup_fd = fd >= 0 ? ::dup(fd) : -1;
+    int old_fd = emergency_.fd.exchange(dup_fd, std::memory_order_acq_rel);
+    if (old_fd >= 0) {
+        ::close(old_fd);
+    }
+    return dup_fd >= 0;
+#endif
+}
+
+size_t CrashHandler::stageEmergencyBytes(const char* data, size_t size) {
+    // Once a signal is being handled the buffer belongs to the handler.
+    if (handler_state_.load(std::memory_order_acquire) != 0) {
+        return 0;
+    }
+
+    size_t offset = emergency_.staged.load(std::memory_order_relaxed);
+    size_t count = std::min(size, emergency_.capacity - offset);
+    if (count == 0) {
+        return 0;
+    }
+
+#ifndef SPECKIT_PLATFORM_WINDOWS
+    if (offset == 0) {
+        // Everything up to here is on disk; the replay resumes from the file size
+        int64_t file_offset = -1;
+        struct stat st{};
+        int fd = emergency_.fd.load(std::memory_order_acquire);
+        if (fd >= 0 && ::fstat(fd, &st) == 0) {
+            file_offset = static_cast<int64_t>(st.st_size);
+        }
+        emergency_.file_offset.store(file_offset, std::memory_order_relaxed);
+    }
+#endif
+
+    std::memcpy(emergency_.data.get() + offset, data, count);
+
+    // Publish after the copy so the handler never sees unwritten bytes.
+    emergency_.staged.store(offset + count, std::memory_order_release);
+    return count;
+}
+
+void CrashHandler::commitEmergencyBytes() {
+    emergency_.staged.store(0, std::memory_order_release);
+}
+
+bool CrashHandler::hasEmergencySlot() const {
+    return has_slot_;
+}
+
+bool CrashHandler::installAltStackForCurrentThread() {
+#ifdef SPECKIT_PLATFORM_WINDOWS
+    return false;
+#else
+    thread_local std::unique_ptr<char[]> alt_stack;
+
+    stack_t current{};
+    if (sigaltstack(nullptr, &current) == 0 && !(current.ss_flags & SS_DISABLE)) {
+        return true;  // Already has an alternate stack
+    }
+
+    if (!alt_stack) {
+        alt_stack = std::make_unique<char[]>(kAltStackSize);
+    }
+
+    stack_t ss{};
+    ss.ss_sp = alt_stack.get();
+    ss.ss_size = kAltStackSize;
+    ss.ss_flags = 0;
+    return sigaltstack(&ss, nullptr) == 0;
+#endif
+}
+
+void CrashHandler::drainEmergencyBuffers() {
+#ifndef SPECKIT_PLATFORM_WINDOWS
+    // Only async-signal-safe calls from here on: atomics, fstat(2), write(2), clock_gettime.
+    const int64_t deadline = monotonicNanos() +
+        std::chrono::duration_cast<std::chrono::nanoseconds>(kEmergencyWriteBudget).count();
+
+    for (auto& slot : emergency_buffers_) {
+        EmergencyBuffer* buffer = slot.load(std::memory_order_acquire);
+        if (!buffer) {
+            continue;
+        }
+
+        int fd = buffer->fd.load(std::memory_order_acquire);
+        size_t remaining = std::min(buffer->staged.load(std::memory_order_acquire),
+                                    buffer->capacity);
+        if (fd < 0 || remaining == 0) {
+            continue;
+        }
+
+        // Skip the staged bytes that reached the file before the signal. The
+        // descriptor is opened for appending, so write(2) resumes at the file end.
+        const char* cursor = buffer->data.get();
+        const int64_t file_offset = buffer->file_offset.load(std::memory_order_relaxed);
+        struct stat st{};
+        if (file_offset >= 0 && ::fstat(fd, &st) == 0 && st.st_size > file_offset) {
+            const size_t written = std::min(static_cast<size_t>(st.st_size - file_offset), remaining);
+            cursor += written;
+            remaining -= written;
+        }
+        while (remaining > 0) {
+            if (monotonicNanos() > deadline) {
+                return;  // Out of budget; let the process die
+            }
+            ssize_t written = ::write(fd, cursor, remaining);
+            if (written < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                break;
+            }
+            cursor += written;
+            remaining -= static_cast<size_t>(written);
+        }
+        buffer->staged.store(0, std::memory_order_release);
+    }
+#endif
+}
+
+#ifdef SPECKIT_PLATFORM_WINDOWS
 void CrashHandler::signalHandler(int signal) {
     // Prevent recursive handling for the same signal.
     std::signal(signal, SIG_IGN);
@@ -76,6 +297,60 @@ void CrashHandler::signalHandler(int signal) {
     std::signal(signal, SIG_DFL);
     std::raise(signal);
 }
+#else
+void CrashHandler::signalHandler(int signal, siginfo_t* info, void* context) {
+    const int saved_errno = errno;
+    const int index = signalIndex(signal);
+
+    // SIGTERM or SIGABRT the application handles itself: the writer thread may go on,
+    // and replaying its staged chunk now would write those bytes twice
+    if (index >= 0 && !isSynchronousFault(signal) && isApplicationHandler(g_previous_actions[index])) {
+        const struct sigaction previous = g_previous_actions[index];
+        if (previous.sa_flags & SA_RESETHAND) {
+            // One-shot handler: the next delivery takes the default (fatal) action
+            g_previous_actions[index].sa_handler = SIG_DFL;
+            g_previous_actions[index].sa_flags = 0;
+        }
+        errno = saved_errno;
+        if (previous.sa_flags & SA_SIGINFO) {
+            previous.sa_sigaction(signal, info, context);
+        } else {
+            previous.sa_handler(signal);
+        }
+        return;
+    }
+
+    // The first thread to crash drains; concurrent crashes wait (bounded) for it.
+    int expected = 0;
+    if (handler_state_.compare_exchange_strong(expected, 1)) {
+        drainEmergencyBuffers();
+        handler_state_.store(2, std::memory_order_release);
+    } else {
+        const int64_t deadline = monotonicNanos() +
+            std::chrono::duration_cast<std::chrono::nanoseconds>(kEmergencyWriteBudget).count();
+        while (handler_state_.load(std::memory_order_acquire) != 2 &&
+               monotonicNanos() < deadline) {
+        }
+    }
+
+    flush_requested_.store(true);
+
+    // Hand the signal back to whoever owned it before us (usually the default action).
+    struct sigaction previous{};
+    if (index >= 0) {
+        previous = g_previous_actions[index];
+    }
+    if (index < 0 || (isSynchronousFault(signal) && previous.sa_handler == SIG_IGN)) {
+        previous.sa_handler = SIG_DFL;
+        previous.sa_flags = 0;
+        sigemptyset(&previous.sa_mask);
+    }
+    sigaction(signal, &previous, nullptr);
+
+    errno = saved_errno;
+    raise(signal);
+}
+#endif
 
 void CrashHandler::initializeHandlers() {
     bool expected = false;
@@ -91,13 +366,27 @@ void CrashHandler::initializeHandlers() {
     // Start background monitor thread
     startMonitor();
 #else
+    handler_state_.store(0);
+    installAltStackForCurrentThread();
+
+    // No SA_RESETHAND: signals chained to an application handler keep ours installed,
+    // and the fatal path restores the previous action itself before re-raising
     struct sigaction sa{};
-    sa.sa_handler = signalHandler;
+    sa.sa_sigaction = signalHandler;
     sigemptyset(&sa.sa_mask);
-    sa.sa_flags = SA_RESETHAND;
+    sa.sa_flags = SA_SIGINFO | SA_ONSTACK;
 
-    for (int sig : kHandledSignals) {
-        sigaction(sig, &sa, nullptr);
+    for (size_t i = 0; i < kHandledSignalCount; ++i) {
+        const int sig = kHandledSignals[i];
+        g_installed[i] = false;
+        if (sigaction(sig, nullptr, &g_previous_actions[i]) != 0) {
+            continue;
+        }
+        // Respect signals the application deliberately ignores.
+        if (!isSynchronousFault(sig) && g_previous_actions[i].sa_handler == SIG_IGN) {
+            continue;
+        }
+        g_installed[i] = sigaction(sig, &sa, nullptr) == 0;
     }
 #endif
 }
@@ -115,15 +404,11 @@ void CrashHandler::cleanupHandlers() {
     // Stop background monitor thread
     stopMonitor();
 #else
-    struct sigaction sa{};
-    sa.sa_handler = SIG_DFL;
-    sigemptyset(&sa.sa_mask);
-    sa.sa_flags = SA_RESETHAND;
-
-    for (int sig : kHandledSignals) {
-        sigaction(sig, &sa, nullptr);
+    for (size_t i = 0; i < kHandledSignalCount; ++i) {
+        if (g_installed[i]) {
+            sigaction(kHandledSignals[i], &g_previous_actions[i], nullptr);
+            g_installed[i] = false;
+        }
     }
 #endif
 }
-
-
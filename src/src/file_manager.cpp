@@ -1,6 +1,8 @@
 // File manager implementation
 
 #include "speckit/log/file_manager.h"
+#include "speckit/log/metrics.h"
+#include <chrono>
 #include <fstream>
 #include <filesystem>
 #include <format>
@@ -24,6 +26,7 @@ namespace fs = std::filesystem;
 
 namespace {
 
+#ifdef SPECKIT_PLATFORM_WINDOWS
 // Helper function to convert UTF-8 string to wide string for Windows API
 std::wstring Utf8ToWideString(const std::string& utf8_string) {
     if (utf8_string.empty()) {
@@ -39,6 +42,7 @@ std::wstring Utf8ToWideString(const std::string& utf8_string) {
     MultiByteToWideChar(CP_UTF8, 0, utf8_string.c_str(), -1, wide_string.data(), wide_char_count);
     return wide_string;
 }
+#endif
 
 // Helper function to get sequence number from historical log filename
 int ExtractSequenceNumber(const std::string& filename) {
@@ -248,6 +252,9 @@ bool FileManager::Initialize(ProcessIdType process_id) {
 
     // Get current file size if file exists
     UpdateCurrentFileSize();
+    if (!StartFile()) {
+        return false;
+    }
 
     initialized_ = true;
     return true;
@@ -269,7 +276,9 @@ bool FileManager::OpenLogFile() {
 #ifdef SPECKIT_PLATFORM_WINDOWS
     try {
         std::wstring wide_path = Utf8ToWideString(current_file_name_);
-        errno_t err = _wfopen_s(&file_handle_, wide_path.c_str(), L"a");
+        // Binary files must not get CRLF translation
+        const wchar_t* mode = (format_ == LogFileFormat::kBinary) ? L"ab" : L"a";
+        errno_t err = _wfopen_s(&file_handle_, wide_path.c_str(), mode);
         if (err != 0) {
             file_handle_ = nullptr;
             return false;
@@ -279,12 +288,78 @@ bool FileManager::OpenLogFile() {
         return false;
     }
 #else
-    file_handle_ = std::fopen(current_file_name_.c_str(), "a");
+    file_handle_ = std::fopen(current_file_name_.c_str(), format_ == LogFileFormat::kBinary ? "ab" : "a");
 #endif
 
     return file_handle_ != nullptr;
 }
 
+bool FileManager::StartFile() {
+    ++file_generation_;
+    if (format_ != LogFileFormat::kBinary) {
+        return true;
+    }
+
+    // Also written when appending, so each process's records decode on their own
+    binary_header_ = BinaryFileHeader::now(process_id_);
+    std::string header;
+    binary_header_.encode(header);
+    // On disk before any chunk is staged, so crash replay resumes after it
+    return Write(header) && FlushBuffer();
+}
+
+const char* FileManager::Extension() const {
+    switch (format_) {
+    case LogFileFormat::kBinary:
+        return ".slog";
+    case LogFileFormat::kJsonLines:
+        return ".jsonl";
+    default:
+        return ".log";
+    }
+}
+
+bool FileManager::SetOutputFormat(LogFileFormat format) {
+    if (format == format_) {
+        return true;
+    }
+    const LogFileFormat old_format = format_;
+    const std::string old_extension = Extension();
+    format_ = format;
+    if (!file_handle_) {
+        return true;  // Takes effect in Initialize()
+    }
+
+    // Same name, new extension; the old file is left as it is. The new file is
+    // opened before the old one is closed, so a failed open changes nothing.
+    const std::string old_file_name = current_file_name_;
+    FILE* old_handle = file_handle_;
+    file_handle_ = nullptr;
+    current_file_name_ = old_file_name.substr(0, old_file_name.size() - old_extension.size()) + Extension();
+    if (!OpenLogFile()) {
+        format_ = old_format;
+        current_file_name_ = old_file_name;
+        file_handle_ = old_handle;
+        return false;
+    }
+    std::fclose(old_handle);
+    current_file_size_ = 0;
+    UpdateCurrentFileSize();
+    return StartFile();
+}
+
+LogFileFormat FileManager::GetOutputFormat() const {
+    return format_;
+}
+
+uint64_t FileManager::GetFileGeneration() const {
+    return file_generation_;
+}
+
+const BinaryFileHeader& FileManager::GetBinaryHeader() const {
+    return binary_header_;
+}
+
 void FileManager::UpdateCurrentFileSize() {
     if (fs::exists(current_file_name_)) {
         current_file_size_ = fs::file_size(current_file_name_);
@@ -325,7 +400,12 @@ bool FileManager::FlushToFile() {
     if (std::fflush(file_handle_) != 0) return false;
     int fd = fileno(file_handle_);
     if (fd < 0) return false;
-    return fsync(fd) == 0;
+    auto start = std::chrono::steady_clock::now();
+    bool ok = fsync(fd) == 0;
+    if (metrics_) {
+        metrics_->recordFsyncLatency(std::chrono::steady_clock::now() - start);
+    }
+    return ok;
 #endif
 }
 
@@ -337,6 +417,8 @@ bool FileManager::Rotate() {
     if (!file_handle_) {
         return false;
     }
+
+    auto start = std::chrono::steady_clock::now();
     
     // Close current file
     CloseCurrentFile();
@@ -363,6 +445,12 @@ bool FileManager::Rotate() {
     }
     
     current_file_size_ = 0;
+    if (!StartFile()) {
+        return false;
+    }
+    if (metrics_) {
+        metrics_->recordRotation(std::chrono::steady_clock::now() - start);
+    }
     return true;
 }
 
@@ -424,15 +512,15 @@ std::string FileManager::GetLogFileName() const {
 std::string FileManager::GenerateFileName(bool first_process) const {
     if (first_process) {
         // First process: base_name.log
-        return base_name_ + ".log";
+        return base_name_ + Extension();
     } else {
         // Subsequent process: base_name_PID.log
-        return std::format("{}_{}.log", base_name_, process_id_);
+        return std::format("{}_{}{}", base_name_, process_id_, Extension());
     }
 }
 
 bool FileManager::RenameWithSequence(int sequence) {
-    std::string new_name = std::format("{}.{}.log", base_name_, sequence);
+    std::string new_name = std::format("{}.{}{}", base_name_, sequence, Extension());
     
     std::error_code ec;
     fs::rename(current_file_name_, new_name, ec);
@@ -461,9 +549,10 @@ std::vector<std::string> FileManager::GetHistoricalFiles() const {
 
 bool FileManager::IsHistoricalLogFile(const std::string& filename, 
                                      const std::string& base_pattern) const {
-    // Check if filename starts with base pattern and ends with .log
-    if (filename.find(base_pattern) != 0 || 
-        filename.find(".log") != filename.length() - 4) {
+    // Check if filename starts with base pattern and ends with the current extension
+    const std::string extension = Extension();
+    if (filename.find(base_pattern) != 0 || filename.size() < extension.size() ||
+        filename.compare(filename.size() - extension.size(), extension.size(), extension) != 0) {
         return false;
     }
     
@@ -492,4 +581,22 @@ bool FileManager::IsHistoricalLogFile(const std::string& filename,
 bool FileManager::Flush() {
     if (!file_handle_) return false;
     return FlushToFile();
-}
\ No newline at end of file
+}
+
+bool FileManager::FlushBuffer() {
+    if (!file_handle_) return false;
+    return std::fflush(file_handle_) == 0;
+}
+
+int FileManager::GetFileDescriptor() const {
+    if (!file_handle_) return -1;
+#ifdef SPECKIT_PLATFORM_WINDOWS
+    return _fileno(file_handle_);
+#else
+    return fileno(file_handle_);
+#endif
+}
+
+void FileManager::SetMetrics(LoggerMetrics* metrics) {
+    metrics_ = metrics;
+}
@@ -0,0 +1,190 @@
+// Flight recorder implementation
+
+#include "speckit/log/flight_recorder.h"
+#include <algorithm>
+#include <csignal>
+#include <cstring>
+#include <format>
+#include <fstream>
+
+namespace {
+
+// Signals received by installSignalHandler() handlers; each recorder compares it with
+// the count it has already handled
+std::atomic<uint32_t> g_signal_requests{0};
+static_assert(std::atomic<uint32_t>::is_always_lock_free, "Bumped from a signal handler");
+
+void onDumpSignal(int) {
+    g_signal_requests.fetch_add(1, std::memory_order_relaxed);
+}
+
+// Eviction rounds before an entry is given up; each frees more of the ring
+constexpr int kMaxRecordAttempts = 3;
+
+// Formatted bytes collected before each write of a dump
+constexpr size_t kDumpChunkBytes = 64 * 1024;
+
+}  // namespace
+
+FlightRecorder::FlightRecorder(const std::string& dump_base, ProcessIdType process_id,
+                               const FlightRecorderOptions& options,
+                               FormatPipeline::EntryFormatter formatter)
+    : ring_(options.budget_bytes),
+      dump_base_(dump_base),
+      process_id_(process_id),
+      options_(options),
+      formatter_(formatter ? formatter : formatLogEntry),
+      signals_seen_(g_signal_requests.load(std::memory_order_relaxed)),
+      thread_([this](std::stop_token stop_token) { dumpThread(stop_token); }) {}
+
+FlightRecorder::~FlightRecorder() {
+    thread_.request_stop();
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+void FlightRecorder::record(const LogEntry& entry) {
+    const size_t capacity = ring_.capacityBytes();
+    for (int attempt = 0; attempt < kMaxRecordAttempts; ++attempt) {
+        if (ring_.tryPushEntry(entry)) {
+            entries_recorded_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        // 1/16 of the ring, then 1/4, then all of it
+        evict(std::min(capacity, (capacity / 16) << (2 * attempt)));
+    }
+    entries_lost_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void FlightRecorder::evict(size_t bytes) {
+    std::lock_guard<std::mutex> lock(consumer_mutex_);
+    uint64_t evicted = 0;
+    while (ring_.capacityBytes() - ring_.sizeBytes() < bytes) {
+        // Stops early at an entry another thread is still writing
+        if (ring_.drain([](std::string_view) {}, 1) == 0) {
+            break;
+        }
+        ++evicted;
+    }
+    entries_evicted_.fetch_add(evicted, std::memory_order_relaxed);
+}
+
+void FlightRecorder::requestDump() {
+    if (dump_requested_.exchange(true, std::memory_order_acq_rel)) {
+        return;  // Already pending
+    }
+    {
+        // Orders the flag against the dump thread's predicate check
+        std::lock_guard<std::mutex> lock(request_mutex_);
+    }
+    request_cv_.notify_one();
+}
+
+void FlightRecorder::setFormatter(FormatPipeline::EntryFormatter formatter) {
+    formatter_.store(formatter ? formatter : formatLogEntry, std::memory_order_relaxed);
+}
+
+std::string FlightRecorder::dump() {
+    std::lock_guard<std::mutex> dump_lock(dump_mutex_);
+    if (ring_.isEmpty()) {
+        return std::string();
+    }
+
+    const std::string path = std::format("{}.flight.{}.{}.log", dump_base_, process_id_, ++dump_sequence_);
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) {
+        return std::string();
+    }
+
+    // Copy the records out so the ring is free again before anything is formatted;
+    // each one is stored as its length followed by its bytes
+    dump_records_.clear();
+    size_t count = 0;
+    {
+        std::lock_guard<std::mutex> lock(consumer_mutex_);
+        count = ring_.drain([this](std::string_view record) {
+            const uint32_t length = static_cast<uint32_t>(record.size());
+            dump_records_.append(reinterpret_cast<const char*>(&length), sizeof(length));
+            dump_records_.append(record);
+        });
+    }
+
+    const FormatPipeline::EntryFormatter formatter = formatter_.load(std::memory_order_relaxed);
+    std::string buffer;
+    buffer.reserve(kDumpChunkBytes);
+    for (size_t pos = 0; pos < dump_records_.size();) {
+        uint32_t length = 0;
+        std::memcpy(&length, dump_records_.data() + pos, sizeof(length));
+        pos += sizeof(length);
+        buffer += formatter(ByteRingQueue::decodeEntry(std::string_view(dump_records_).substr(pos, length)));
+        pos += length;
+        if (buffer.size() >= kDumpChunkBytes) {
+            out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+            buffer.clear();
+        }
+    }
+    out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    out.flush();
+
+    entries_dumped_.fetch_add(count, std::memory_order_relaxed);
+    dumps_.fetch_add(1, std::memory_order_relaxed);
+    return out.good() ? path : std::string();
+}
+
+LogLevel FlightRecorder::getDumpLevel() const {
+    return options_.dump_level;
+}
+
+bool FlightRecorder::dumpsOnLevel() const {
+    return options_.dump_on_level;
+}
+
+FlightRecorderStats FlightRecorder::getStats() const {
+    FlightRecorderStats stats;
+    stats.entries_recorded = entries_recorded_.load(std::memory_order_relaxed);
+    stats.entries_evicted = entries_evicted_.load(std::memory_order_relaxed);
+    stats.entries_dumped = entries_dumped_.load(std::memory_order_relaxed);
+    stats.entries_lost = entries_lost_.load(std::memory_order_relaxed);
+    stats.dumps = dumps_.load(std::memory_order_relaxed);
+    stats.bytes_used = ring_.sizeBytes();
+    return stats;
+}
+
+bool FlightRecorder::installSignalHandler(int signal) {
+    return std::signal(signal, onDumpSignal) != SIG_ERR;
+}
+
+void FlightRecorder::dumpThread(std::stop_token stop_token) {
+    std::unique_lock<std::mutex> lock(request_mutex_);
+    while (!stop_token.stop_requested()) {
+        // Signal handlers cannot notify, so requests from them are polled
+        request_cv_.wait_for(lock, stop_token, kSignalPollInterval, [this]() {
+            return dump_requested_.load(std::memory_order_acquire);
+        });
+        if (stop_token.stop_requested()) {
+            break;
+        }
+        const uint32_t signals = g_signal_requests.load(std::memory_order_relaxed);
+        const bool signaled = signals != signals_seen_;
+        signals_seen_ = signals;
+        if (!dump_requested_.exchange(false, std::memory_order_acq_rel) && !signaled) {
+            continue;
+        }
+
+        // A burst of errors gets one dump per interval; the entries in between are kept
+        const auto earliest = last_requested_dump_ + options_.min_dump_interval;
+        if (last_requested_dump_ != std::chrono::steady_clock::time_point{} &&
+            std::chrono::steady_clock::now() < earliest) {
+            if (request_cv_.wait_until(lock, stop_token, earliest, [] { return false; }) ||
+                stop_token.stop_requested()) {
+                break;
+            }
+        }
+
+        lock.unlock();
+        dump();
+        lock.lock();
+        last_requested_dump_ = std::chrono::steady_clock::now();
+    }
+}
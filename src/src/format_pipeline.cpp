@@ -0,0 +1,158 @@
+// Parallel formatting pipeline implementation
+
+#include "speckit/log/format_pipeline.h"
+#include "speckit/log/crash_handler.h"
+#include <algorithm>
+
+FormatPipeline::FormatPipeline(size_t formatter_threads, size_t batch_entries, size_t chunk_bytes,
+                               ChunkWriter writer)
+    : FormatPipeline(formatter_threads, batch_entries, chunk_bytes,
+                     LineChunkWriter([writer = std::move(writer)](const std::string& chunk,
+                                                                  std::span<const FormattedLine>) {
+                         writer(chunk);
+                     })) {}
+
+FormatPipeline::FormatPipeline(size_t formatter_threads, size_t batch_entries, size_t chunk_bytes,
+                               LineChunkWriter writer)
+    : chunk_bytes_(chunk_bytes), writer_(std::move(writer)) {
+    formatter_threads = std::max<size_t>(formatter_threads, 1);
+
+    // Enough batches to keep every formatter busy while one is written and one is filled
+    const size_t pool_size = 2 * formatter_threads + 2;
+    pool_.reserve(pool_size);
+    for (size_t i = 0; i < pool_size; ++i) {
+        auto batch = std::make_unique<Batch>();
+        batch->entries.resize(batch_entries);
+        free_.push_back(batch.get());
+        pool_.push_back(std::move(batch));
+    }
+    ready_.assign(pool_size, nullptr);
+
+    formatters_.reserve(formatter_threads);
+    for (size_t i = 0; i < formatter_threads; ++i) {
+        formatters_.emplace_back([this]() { formatterThread(); });
+    }
+    io_thread_ = std::thread([this]() { ioThread(); });
+}
+
+FormatPipeline::~FormatPipeline() {
+    waitIdle();
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    work_cv_.notify_all();
+    ready_cv_.notify_all();
+    for (auto& formatter : formatters_) {
+        formatter.join();
+    }
+    io_thread_.join();
+}
+
+std::span<LogEntry> FormatPipeline::acquireBatch() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    free_cv_.wait(lock, [this]() { return !free_.empty(); });
+    current_ = free_.front();
+    free_.pop_front();
+    return std::span<LogEntry>(current_->entries);
+}
+
+void FormatPipeline::submitBatch(size_t count, EntryFormatter formatter, const LogRouter* router) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        Batch* batch = current_;
+        current_ = nullptr;
+        if (count == 0) {
+            free_.push_front(batch);
+            return;
+        }
+        batch->count = count;
+        batch->formatter = formatter;
+        batch->router = router;
+        batch->sequence = next_sequence_++;
+        pending_.push_back(batch);
+    }
+    work_cv_.notify_one();
+}
+
+void FormatPipeline::waitIdle() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    free_cv_.wait(lock, [this]() { return written_sequence_ == next_sequence_; });
+}
+
+size_t FormatPipeline::formatterThreads() const {
+    return formatters_.size();
+}
+
+void FormatPipeline::format(Batch& batch) {
+    batch.chunk_count = 0;
+    std::string* chunk = nullptr;
+    std::vector<FormattedLine>* lines = nullptr;
+    for (auto& entry : std::span<LogEntry>(batch.entries).first(batch.count)) {
+        if (!chunk || chunk->size() >= chunk_bytes_) {
+            if (batch.chunk_count == batch.chunks.size()) {
+                batch.chunks.emplace_back().reserve(chunk_bytes_);
+                batch.chunk_lines.emplace_back();
+            }
+            lines = &batch.chunk_lines[batch.chunk_count];
+            chunk = &batch.chunks[batch.chunk_count++];
+            chunk->clear();
+            lines->clear();
+        }
+        const size_t offset = chunk->size();
+        *chunk += batch.formatter(entry);
+        lines->push_back(FormattedLine{static_cast<uint32_t>(offset),
+                                       static_cast<uint32_t>(chunk->size() - offset), entry.level,
+                                       batch.router ? batch.router->route(entry.tag, entry.level) : 0});
+
+        // Release payloads here, in parallel, rather than on the drain stage
+        entry.storage.reset();
+    }
+}
+
+void FormatPipeline::formatterThread() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        work_cv_.wait(lock, [this]() { return stopping_ || !pending_.empty(); });
+        if (pending_.empty()) {
+            return;  // Stopping and nothing left to format
+        }
+        Batch* batch = pending_.front();
+        pending_.pop_front();
+
+        lock.unlock();
+        format(*batch);
+        lock.lock();
+
+        ready_[batch->sequence % ready_.size()] = batch;
+        ready_cv_.notify_one();
+    }
+}
+
+void FormatPipeline::ioThread() {
+    // Writes (and stages for crash replay) in place of the logger's writer thread
+    CrashHandler::installAltStackForCurrentThread();
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        Batch*& slot = ready_[written_sequence_ % ready_.size()];
+        ready_cv_.wait(lock, [this, &slot]() {
+            return slot != nullptr || (stopping_ && written_sequence_ == next_sequence_);
+        });
+        if (!slot) {
+            return;  // Stopping and everything is written
+        }
+        Batch* batch = slot;
+        slot = nullptr;
+
+        lock.unlock();
+        for (size_t i = 0; i < batch->chunk_count; ++i) {
+            writer_(batch->chunks[i], batch->chunk_lines[i]);
+        }
+        lock.lock();
+
+        ++written_sequence_;
+        free_.push_back(batch);
+        free_cv_.notify_all();  // Wakes the drain stage and waitIdle()
+    }
+}
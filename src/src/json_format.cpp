@@ -0,0 +1,209 @@
+// JSON Lines formatting implementation
+
+#include "speckit/log/json_format.h"
+#include "speckit/log/log_fields.h"
+#include "speckit/log/log_level.h"
+#include "speckit/log/printf_capture.h"
+#include <bit>
+#include <cmath>
+#include <format>
+#include <iterator>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define SPECKIT_JSON_SSE2 1
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define SPECKIT_JSON_NEON 1
+#endif
+
+namespace {
+
+/// Bytes that are escaped, or checked as the start of a UTF-8 sequence
+bool needsEscape(char c) {
+    const auto byte = static_cast<unsigned char>(c);
+    return byte < 0x20 || byte >= 0x80 || c == '"' || c == '\\';
+}
+
+/// Index of the first byte at or after @p from that needs escaping or is not ASCII,
+/// or text.size()
+size_t findEscape(std::string_view text, size_t from) {
+    size_t i = from;
+    const char* data = text.data();
+
+#if defined(SPECKIT_JSON_SSE2)
+    const __m128i quote = _mm_set1_epi8('"');
+    const __m128i backslash = _mm_set1_epi8('\\');
+    const __m128i max_control = _mm_set1_epi8(0x1f);
+    for (; i + 16 <= text.size(); i += 16) {
+        const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        // Unsigned bytes <= 0x1f are exactly those with min(bytes, 0x1f) == bytes
+        const __m128i control = _mm_cmpeq_epi8(_mm_min_epu8(bytes, max_control), bytes);
+        const __m128i hits = _mm_or_si128(control, _mm_or_si128(_mm_cmpeq_epi8(bytes, quote),
+                                                                 _mm_cmpeq_epi8(bytes, backslash)));
+        // The sign bits are the non-ASCII bytes
+        const auto mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_or_si128(hits, bytes)));
+        if (mask != 0) {
+            return i + static_cast<size_t>(std::countr_zero(mask));
+        }
+    }
+#elif defined(SPECKIT_JSON_NEON)
+    const uint8x16_t quote = vdupq_n_u8('"');
+    const uint8x16_t backslash = vdupq_n_u8('\\');
+    const uint8x16_t space = vdupq_n_u8(0x20);
+    const uint8x16_t delete_char = vdupq_n_u8(0x7f);
+    for (; i + 16 <= text.size(); i += 16) {
+        const uint8x16_t bytes = vld1q_u8(reinterpret_cast<const uint8_t*>(data + i));
+        const uint8x16_t outside = vorrq_u8(vcltq_u8(bytes, space), vcgtq_u8(bytes, delete_char));
+        const uint8x16_t hits = vorrq_u8(outside,
+                                         vorrq_u8(vceqq_u8(bytes, quote), vceqq_u8(bytes, backslash)));
+        if (vmaxvq_u8(hits) != 0) {
+            break;  // The scalar loop finds the exact byte within this block
+        }
+    }
+#endif
+
+    for (; i < text.size(); ++i) {
+        if (needsEscape(data[i])) {
+            return i;
+        }
+    }
+    return text.size();
+}
+
+/// Length of the well-formed UTF-8 sequence starting at @p pos, or 0 if it is not one
+/// Overlong forms, surrogates and code points above U+10FFFF are not well-formed.
+size_t utf8SequenceLength(std::string_view text, size_t pos) {
+    const auto byte = [&](size_t i) { return static_cast<unsigned char>(text[pos + i]); };
+    const unsigned char lead = byte(0);
+    size_t length = 0;
+    unsigned char low = 0x80;   // Range of the second byte
+    unsigned char high = 0xbf;
+    if (lead >= 0xc2 && lead <= 0xdf) {
+        length = 2;
+    } else if (lead >= 0xe0 && lead <= 0xef) {
+        length = 3;
+        low = lead == 0xe0 ? 0xa0 : 0x80;
+        high = lead == 0xed ? 0x9f : 0xbf;
+    } else if (lead >= 0xf0 && lead <= 0xf4) {
+        length = 4;
+        low = lead == 0xf0 ? 0x90 : 0x80;
+        high = lead == 0xf4 ? 0x8f : 0xbf;
+    } else {
+        return 0;
+    }
+    if (text.size() - pos < length || byte(1) < low || byte(1) > high) {
+        return 0;
+    }
+    for (size_t i = 2; i < length; ++i) {
+        if (byte(i) < 0x80 || byte(i) > 0xbf) {
+            return 0;
+        }
+    }
+    return length;
+}
+
+void appendEscapedChar(std::string& out, char c) {
+    switch (c) {
+    case '"':  out.append("\\\""); break;
+    case '\\': out.append("\\\\"); break;
+    case '\n': out.append("\\n"); break;
+    case '\r': out.append("\\r"); break;
+    case '\t': out.append("\\t"); break;
+    case '\b': out.append("\\b"); break;
+    case '\f': out.append("\\f"); break;
+    default:
+        std::format_to(std::back_inserter(out), "\\u{:04x}", static_cast<unsigned char>(c));
+        break;
+    }
+}
+
+void appendJsonString(std::string& out, std::string_view text) {
+    out.push_back('"');
+    speckit::log::appendJsonEscaped(out, text);
+    out.push_back('"');
+}
+
+void appendJsonFields(std::string& out, std::string_view encoded) {
+    LogFieldReader reader(encoded);
+    std::string_view key;
+    speckit::log::FieldValue value;
+    bool first = true;
+    while (reader.next(key, value)) {
+        out.push_back(first ? '{' : ',');
+        first = false;
+        appendJsonString(out, key);
+        out.push_back(':');
+
+        if (const auto* text = std::get_if<std::string_view>(&value)) {
+            appendJsonString(out, *text);
+        } else if (const auto* b = std::get_if<bool>(&value)) {
+            out.append(*b ? "true" : "false");
+        } else if (const auto* d = std::get_if<double>(&value)) {
+            if (std::isfinite(*d)) {
+                std::format_to(std::back_inserter(out), "{}", *d);
+            } else {
+                out.append("null");  // JSON has no NaN or infinity
+            }
+        } else if (const auto* i = std::get_if<int64_t>(&value)) {
+            std::format_to(std::back_inserter(out), "{}", *i);
+        } else {
+            std::format_to(std::back_inserter(out), "{}", std::get<uint64_t>(value));
+        }
+    }
+    out.append(first ? "{}" : "}");
+}
+
+}  // namespace
+
+std::string formatLogEntryJson(const LogEntry& entry) {
+    std::string rendered;
+    std::string_view message = entry.message;
+    if (entry.deferred) {
+        rendered = speckit::log::renderPrintf(entry.message);
+        message = rendered;
+    }
+
+    std::string out;
+    out.reserve(96 + entry.tag.size() + message.size() + entry.fields.size());
+    std::format_to(std::back_inserter(out), "{{\"ts\":{},\"level\":\"{}\",\"pid\":{},\"tid\":",
+                   entry.timestamp_ms, levelToString(entry.level), entry.process_id);
+    appendJsonString(out, threadIdToString(entry.thread_id));
+    out.append(",\"tag\":");
+    appendJsonString(out, entry.tag);
+    out.append(",\"msg\":");
+    appendJsonString(out, message);
+    if (!entry.fields.empty()) {
+        out.append(",\"fields\":");
+        appendJsonFields(out, entry.fields);
+    }
+    out.append("}\n");
+    return out;
+}
+
+namespace speckit {
+namespace log {
+
+void appendJsonEscaped(std::string& out, std::string_view text) {
+    size_t start = 0;
+    while (start < text.size()) {
+        const size_t pos = findEscape(text, start);
+        out.append(text.substr(start, pos - start));
+        if (pos == text.size()) {
+            break;
+        }
+        if (static_cast<unsigned char>(text[pos]) < 0x80) {
+            appendEscapedChar(out, text[pos]);
+            start = pos + 1;
+        } else if (const size_t length = utf8SequenceLength(text, pos); length > 0) {
+            out.append(text.substr(pos, length));
+            start = pos + length;
+        } else {
+            out.append("\xef\xbf\xbd");  // U+FFFD for each byte that starts no valid sequence
+            start = pos + 1;
+        }
+    }
+}
+
+}  // namespace log
+}  // namespace speckit
@@ -0,0 +1,43 @@
+// Priority/bulk lane merge implementation
+
+#include "speckit/log/lane_merger.h"
+#include <utility>
+
+LaneMerger::LaneMerger(TunedAsyncQueue& priority, TunedAsyncQueue& bulk)
+    : priority_(priority), bulk_(bulk) {}
+
+size_t LaneMerger::drainInto(std::span<LogEntry> out) {
+    const size_t urgent = priority_.drainInto(out);
+    const size_t total = urgent + bulk_.drainInto(out.subspan(urgent));
+    if (urgent == 0 || urgent == total) {
+        return total;  // One lane only: already in order
+    }
+
+    // Set the priority entries aside, then merge both runs back into the front of out.
+    // The write position never passes the next unread bulk entry.
+    if (merge_buffer_.size() < urgent) {
+        merge_buffer_.resize(out.size());
+    }
+    for (size_t i = 0; i < urgent; ++i) {
+        merge_buffer_[i] = std::move(out[i]);
+    }
+
+    size_t next = 0;
+    size_t bulk = urgent;
+    for (size_t i = 0; i < urgent; ++next) {
+        if (bulk < total && out[bulk].timestamp_ms <= merge_buffer_[i].timestamp_ms) {
+            out[next] = std::move(out[bulk++]);
+        } else {
+            out[next] = std::move(merge_buffer_[i++]);
+        }
+    }
+    return total;
+}
+
+size_t LaneMerger::size() const {
+    return priority_.size() + bulk_.size();
+}
+
+bool LaneMerger::isEmpty() const {
+    return priority_.isEmpty() && bulk_.isEmpty();
+}
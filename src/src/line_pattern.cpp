@@ -0,0 +1,61 @@
+// Compile-time line pattern formatter runtime helpers
+
+#include "speckit/log/line_pattern.h"
+#include <charconv>
+
+namespace speckit {
+namespace log {
+
+const PatternTime& patternLocalTime(int64_t timestamp_ms) {
+    thread_local int64_t cached_seconds = INT64_MIN;
+    thread_local PatternTime cached{};
+
+    // Same split as formatLogEntry
+    const int64_t seconds = timestamp_ms / 1000;
+    cached.millis = static_cast<int>(timestamp_ms % 1000);
+    if (seconds != cached_seconds) {
+        std::time_t time_t_value = static_cast<std::time_t>(seconds);
+#ifdef SPECKIT_PLATFORM_WINDOWS
+        localtime_s(&cached.tm, &time_t_value);
+#else
+        localtime_r(&time_t_value, &cached.tm);
+#endif
+        cached_seconds = seconds;
+    }
+    return cached;
+}
+
+void appendPaddedDecimal(std::string& out, unsigned value, int width) {
+    char buffer[16];
+    auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    for (auto digits = result.ptr - buffer; digits < width; ++digits) {
+        out.push_back('0');
+    }
+    out.append(buffer, result.ptr);
+}
+
+void appendDecimal(std::string& out, uint64_t value) {
+    char buffer[24];
+    auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    out.append(buffer, result.ptr);
+}
+
+void appendThreadId(std::string& out, ThreadIdType thread_id) {
+#ifdef SPECKIT_PLATFORM_WINDOWS
+    // DWORD: printed as a plain number
+    appendDecimal(out, static_cast<uint64_t>(thread_id));
+#else
+    // std::thread::id is only printable through a stream; entries from the same
+    // thread arrive in runs, so remember the last one
+    thread_local ThreadIdType cached_id{};
+    thread_local std::string cached_text = threadIdToString(ThreadIdType{});
+    if (thread_id != cached_id) {
+        cached_text = threadIdToString(thread_id);
+        cached_id = thread_id;
+    }
+    out.append(cached_text);
+#endif
+}
+
+}  // namespace log
+}  // namespace speckit
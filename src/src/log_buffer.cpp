@@ -42,32 +42,17 @@ bool RingBuffer::tryPush(LogEntry&& entry) {
 }
 
 std::vector<LogEntry> RingBuffer::popAll() {
-    // Atomically swap size to 0 and get old value
-    size_t old_size = size_.exchange(0, std::memory_order_acq_rel);
-
-    if (old_size == 0) {
-        return std::vector<LogEntry>();  // Return empty vector if no entries
-    }
-
-    // Get current tail and calculate new tail
-    size_t current_tail = tail_.load(std::memory_order_acquire);
-    size_t new_tail = (current_tail + old_size) % capacity_;
-
-    // Collect all entries from tail to head
     std::vector<LogEntry> entries;
-    entries.reserve(old_size);
-
-    for (size_t i = 0; i < old_size; ++i) {
-        size_t index = (current_tail + i) % capacity_;
-        entries.emplace_back(std::move(buffer_[index]));
-    }
-
-    // Update tail atomically
-    tail_.store(new_tail, std::memory_order_release);
-
+    entries.reserve(size());
+    drain([&entries](LogEntry& entry) { entries.emplace_back(std::move(entry)); });
     return entries;
 }
 
+size_t RingBuffer::drainInto(std::span<LogEntry> out) {
+    size_t count = 0;
+    return drain([&out, &count](LogEntry& entry) { out[count++] = std::move(entry); }, out.size());
+}
+
 bool RingBuffer::isEmpty() const {
     return size_.load(std::memory_order_acquire) == 0;
 }
@@ -2,6 +2,8 @@
 
 #include "speckit/log/log_entry.h"
 #include "speckit/log/log_level.h"
+#include "speckit/log/printf_capture.h"
+#include "speckit/log/log_fields.h"
 #include <chrono>
 #include <ctime>
 #include <format>
@@ -11,11 +13,22 @@
 
 
 
-std::string formatLogEntry(const LogEntry& entry) {
+std::string threadIdToString(ThreadIdType thread_id) {
+#ifdef SPECKIT_PLATFORM_WINDOWS
+    return std::to_string(thread_id);
+#else
+    std::ostringstream oss;
+    oss << thread_id;
+    return oss.str();
+#endif
+}
+
+std::string formatLogLine(LogLevel level, int64_t timestamp_ms, ProcessIdType process_id,
+                          std::string_view thread_id, std::string_view tag, std::string_view message) {
     // Format: [LEVEL] YYYY-MM-DD HH:MM:SS.mmm [PID, TID] [TAG]: Message
 
     // Convert timestamp to local time
-    auto ms_since_epoch = entry.timestamp_ms;
+    auto ms_since_epoch = timestamp_ms;
     auto seconds = ms_since_epoch / 1000;
     auto milliseconds = ms_since_epoch % 1000;
 
@@ -39,25 +52,35 @@ std::string formatLogEntry(const LogEntry& entry) {
         milliseconds
     );
 
-    // Convert thread_id to string
-    std::string thread_id_str;
-#ifdef SPECKIT_PLATFORM_WINDOWS
-    thread_id_str = std::to_string(entry.thread_id);
-#else
-    std::ostringstream oss;
-    oss << entry.thread_id;
-    thread_id_str = oss.str();
-#endif
-
     // Format: [LEVEL] timestamp [PID, TID] [TAG]: Message
     return std::format(
         "[{}] {} [{}, {}] [{}]: {}\n",
-        levelToString(entry.level),
+        levelToString(level),
         timestamp,
-        entry.process_id,
-        thread_id_str,
-        entry.tag.data(),
-        entry.message.data()
+        process_id,
+        thread_id,
+        tag,
+        message
     );
 }
 
+std::string_view resolveMessage(const LogEntry& entry, std::string& scratch) {
+    // printf-style entries are rendered here, on the writer thread
+    if (!entry.deferred && entry.fields.empty()) {
+        return entry.message;
+    }
+    if (entry.deferred) {
+        scratch = speckit::log::renderPrintf(entry.message);
+    } else {
+        scratch.assign(entry.message);
+    }
+    speckit::log::appendFieldsText(scratch, entry.fields);
+    return scratch;
+}
+
+std::string formatLogEntry(const LogEntry& entry) {
+    std::string scratch;
+    const std::string_view message = resolveMessage(entry, scratch);
+    return formatLogLine(entry.level, entry.timestamp_ms, entry.process_id,
+                         threadIdToString(entry.thread_id), entry.tag, message);
+}
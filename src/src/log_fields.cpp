@@ -0,0 +1,173 @@
+// Structured field encoding and text rendering
+
+#include "speckit/log/log_fields.h"
+#include <bit>
+#include <cstring>
+#include <format>
+#include <iterator>
+#include <type_traits>
+
+namespace {
+
+enum : uint8_t {
+    kTypeSigned = 0,
+    kTypeUnsigned = 1,
+    kTypeDouble = 2,
+    kTypeFalse = 3,
+    kTypeTrue = 4,
+    kTypeString = 5
+};
+
+void appendBytes(std::string& out, std::string_view bytes) {
+    speckit::log::appendVarint(out, bytes.size());
+    out.append(bytes);
+}
+
+bool readBytes(std::string_view& in, std::string_view& bytes) {
+    uint64_t length = 0;
+    if (!speckit::log::readVarint(in, length) || length > in.size()) {
+        return false;
+    }
+    bytes = in.substr(0, static_cast<size_t>(length));
+    in.remove_prefix(static_cast<size_t>(length));
+    return true;
+}
+
+bool needsQuotes(std::string_view text) {
+    return text.empty() || text.find_first_of(" \"\\=") != std::string_view::npos;
+}
+
+}  // namespace
+
+bool LogFieldReader::next(std::string_view& key, speckit::log::FieldValue& value) {
+    if (rest_.empty() || failed_) {
+        return false;
+    }
+
+    const auto type = static_cast<uint8_t>(rest_.front());
+    rest_.remove_prefix(1);
+    if (!readBytes(rest_, key)) {
+        failed_ = true;
+        return false;
+    }
+
+    uint64_t raw = 0;
+    switch (type) {
+    case kTypeSigned:
+        if (!speckit::log::readVarint(rest_, raw)) break;
+        value = static_cast<int64_t>(raw >> 1) ^ -static_cast<int64_t>(raw & 1);
+        return true;
+    case kTypeUnsigned:
+        if (!speckit::log::readVarint(rest_, raw)) break;
+        value = raw;
+        return true;
+    case kTypeDouble:
+        if (rest_.size() < sizeof(raw)) break;
+        std::memcpy(&raw, rest_.data(), sizeof(raw));
+        rest_.remove_prefix(sizeof(raw));
+        value = std::bit_cast<double>(raw);
+        return true;
+    case kTypeFalse:
+    case kTypeTrue:
+        value = (type == kTypeTrue);
+        return true;
+    case kTypeString: {
+        std::string_view text;
+        if (!readBytes(rest_, text)) break;
+        value = text;
+        return true;
+    }
+    default:
+        break;
+    }
+    failed_ = true;
+    return false;
+}
+
+namespace speckit {
+namespace log {
+
+void appendVarint(std::string& out, uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<char>((value & 0x7f) | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<char>(value));
+}
+
+bool readVarint(std::string_view& in, uint64_t& value) {
+    value = 0;
+    for (size_t i = 0; i < in.size() && i < 10; ++i) {
+        const auto byte = static_cast<uint8_t>(in[i]);
+        value |= static_cast<uint64_t>(byte & 0x7f) << (7 * i);
+        if ((byte & 0x80) == 0) {
+            in.remove_prefix(i + 1);
+            return true;
+        }
+    }
+    return false;
+}
+
+void encodeFields(std::initializer_list<LogField> fields, std::string& out) {
+    for (const auto& field : fields) {
+        const size_t type_pos = out.size();
+        out.push_back(0);
+        appendBytes(out, field.key);
+
+        uint8_t type = kTypeString;
+        if (const auto* i = std::get_if<int64_t>(&field.value)) {
+            type = kTypeSigned;
+            appendVarint(out, (static_cast<uint64_t>(*i) << 1) ^ static_cast<uint64_t>(*i >> 63));
+        } else if (const auto* u = std::get_if<uint64_t>(&field.value)) {
+            type = kTypeUnsigned;
+            appendVarint(out, *u);
+        } else if (const auto* d = std::get_if<double>(&field.value)) {
+            type = kTypeDouble;
+            const auto bits = std::bit_cast<uint64_t>(*d);
+            out.append(reinterpret_cast<const char*>(&bits), sizeof(bits));
+        } else if (const auto* b = std::get_if<bool>(&field.value)) {
+            type = *b ? kTypeTrue : kTypeFalse;
+        } else {
+            appendBytes(out, std::get<std::string_view>(field.value));
+        }
+        out[type_pos] = static_cast<char>(type);
+    }
+}
+
+void appendFieldsText(std::string& out, std::string_view encoded) {
+    LogFieldReader reader(encoded);
+    std::string_view key;
+    FieldValue value;
+    while (reader.next(key, value)) {
+        out.push_back(' ');
+        out.append(key);
+        out.push_back('=');
+
+        if (const auto* text = std::get_if<std::string_view>(&value)) {
+            if (!needsQuotes(*text)) {
+                out.append(*text);
+                continue;
+            }
+            out.push_back('"');
+            for (char c : *text) {
+                if (c == '"' || c == '\\') {
+                    out.push_back('\\');
+                }
+                out.push_back(c);
+            }
+            out.push_back('"');
+        } else if (const auto* b = std::get_if<bool>(&value)) {
+            out.append(*b ? "true" : "false");
+        } else {
+            std::visit([&out](auto number) {
+                if constexpr (!std::is_same_v<decltype(number), std::string_view> &&
+                              !std::is_same_v<decltype(number), bool>) {
+                    std::format_to(std::back_inserter(out), "{}", number);
+                }
+            }, value);
+        }
+    }
+}
+
+}  // namespace log
+}  // namespace speckit
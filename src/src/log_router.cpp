@@ -0,0 +1,94 @@
+// Log routing table implementation
+
+#include "speckit/log/log_router.h"
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <unordered_set>
+
+namespace {
+
+/// Per-thread result of the last tag-to-id lookup
+struct TagIdCache {
+    uint64_t serial = 0;
+    std::string tag;
+    uint32_t id = 0;
+};
+
+thread_local TagIdCache t_tag_id;
+
+std::atomic<uint64_t> g_next_serial{1};
+
+/// "<base>.<name>.log" must not look like a rotated "<base>.<n>.log", nor leave the directory
+bool validName(const std::string& name) {
+    const bool numeric = std::all_of(name.begin(), name.end(),
+                                     [](unsigned char c) { return std::isdigit(c) != 0; });
+    return !name.empty() && !numeric && name.find_first_of("/\\") == std::string::npos;
+}
+
+}  // namespace
+
+std::unique_ptr<LogRouter> LogRouter::compile(std::span<const RouteTarget> targets) {
+    if (targets.size() > kMaxTargets) {
+        return nullptr;
+    }
+    std::unordered_set<std::string_view> names;
+    for (const auto& target : targets) {
+        if (!validName(target.name) || !names.insert(target.name).second) {
+            return nullptr;
+        }
+    }
+
+    auto router = std::unique_ptr<LogRouter>(new LogRouter());
+    router->targets_.assign(targets.begin(), targets.end());
+    router->serial_ = g_next_serial.fetch_add(1, std::memory_order_relaxed);
+    for (const auto& target : targets) {
+        for (const auto& tag : target.tags) {
+            router->tag_ids_.try_emplace(tag, static_cast<uint32_t>(router->tag_ids_.size() + 1));
+        }
+    }
+
+    // Id 0 (unnamed tags) matches only targets without a tag list
+    const size_t ids = router->tag_ids_.size() + 1;
+    router->masks_.assign(ids * kLogLevelCount, 0);
+    for (size_t bit = 0; bit < targets.size(); ++bit) {
+        const RouteTarget& target = targets[bit];
+        for (size_t id = 0; id < ids; ++id) {
+            if (!target.tags.empty()) {
+                bool named = false;
+                for (const auto& tag : target.tags) {
+                    named = named || router->tag_ids_.at(tag) == id;
+                }
+                if (!named) {
+                    continue;
+                }
+            }
+            for (size_t level = static_cast<size_t>(target.min_level); level < kLogLevelCount; ++level) {
+                router->masks_[id * kLogLevelCount + level] |= uint32_t{1} << bit;
+            }
+        }
+    }
+    return router;
+}
+
+uint32_t LogRouter::route(std::string_view tag, LogLevel level) const {
+    return masks_[tagId(tag) * kLogLevelCount + static_cast<size_t>(level)];
+}
+
+uint32_t LogRouter::tagId(std::string_view tag) const {
+    if (tag_ids_.empty()) {
+        return 0;
+    }
+    TagIdCache& cache = t_tag_id;
+    if (cache.serial != serial_ || cache.tag != tag) {
+        auto it = tag_ids_.find(tag);
+        cache.serial = serial_;
+        cache.tag.assign(tag);
+        cache.id = it != tag_ids_.end() ? it->second : 0;
+    }
+    return cache.id;
+}
+
+const std::vector<RouteTarget>& LogRouter::targets() const {
+    return targets_;
+}
@@ -0,0 +1,169 @@
+// Built-in log sinks
+
+#include "speckit/log/log_sink.h"
+#include "speckit/log/platform.h"
+#include <cstdio>
+#include <cstring>
+
+#ifndef SPECKIT_PLATFORM_WINDOWS
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+LogSink::LogSink(LogLevel min_level) : min_level_(min_level) {}
+
+void LogSink::setLevel(LogLevel level) {
+    min_level_.store(level, std::memory_order_relaxed);
+}
+
+LogLevel LogSink::getLevel() const {
+    return min_level_.load(std::memory_order_relaxed);
+}
+
+std::shared_ptr<FileSink> FileSink::create(const std::string& base_name, LogLevel min_level) {
+    auto sink = std::shared_ptr<FileSink>(new FileSink(base_name, min_level));
+#ifdef SPECKIT_PLATFORM_WINDOWS
+    const ProcessIdType process_id = GetCurrentProcessId();
+#else
+    const ProcessIdType process_id = getpid();
+#endif
+    if (!sink->file_manager_.Initialize(process_id)) {
+        return nullptr;
+    }
+    return sink;
+}
+
+FileSink::FileSink(const std::string& base_name, LogLevel min_level)
+    : LogSink(min_level), file_manager_(base_name) {}
+
+void FileSink::write(const SinkBatch& batch) {
+    bool wrote = false;
+    forEachRun(batch, [&](std::string_view run) {
+        if (run.size() == batch.text.size()) {
+            file_manager_.Write(batch.text);  // Every line passes: no copy
+        } else {
+            run_.assign(run);
+            file_manager_.Write(run_);
+        }
+        wrote = true;
+    });
+    if (!wrote) {
+        return;
+    }
+    file_manager_.FlushBuffer();
+    if (file_manager_.NeedsRotation()) {
+        file_manager_.Rotate();
+    }
+}
+
+FileManager& FileSink::getFileManager() {
+    return file_manager_;
+}
+
+std::string FileSink::getLogFileName() const {
+    return file_manager_.GetLogFileName();
+}
+
+ConsoleSink::ConsoleSink(ConsoleStream stream, LogLevel min_level)
+    : LogSink(min_level), stream_(stream) {}
+
+void ConsoleSink::write(const SinkBatch& batch) {
+    std::FILE* out = stream_ == ConsoleStream::kStdout ? stdout : stderr;
+    bool wrote = false;
+    forEachRun(batch, [&](std::string_view run) {
+        std::fwrite(run.data(), 1, run.size(), out);
+        wrote = true;
+    });
+    if (wrote) {
+        std::fflush(out);
+    }
+}
+
+MemoryRingSink::MemoryRingSink(size_t capacity_bytes, LogLevel min_level)
+    : LogSink(min_level), capacity_bytes_(capacity_bytes) {}
+
+void MemoryRingSink::write(const SinkBatch& batch) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    forEachLine(batch, [&](std::string_view line, LogLevel) {
+        if (line.size() > capacity_bytes_) {
+            return;  // Would evict everything and still not fit
+        }
+        while (size_bytes_ + line.size() > capacity_bytes_) {
+            size_bytes_ -= lines_.front().size();
+            lines_.pop_front();
+        }
+        lines_.emplace_back(line);
+        size_bytes_ += line.size();
+    });
+}
+
+std::vector<std::string> MemoryRingSink::getLines() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return std::vector<std::string>(lines_.begin(), lines_.end());
+}
+
+size_t MemoryRingSink::getSizeBytes() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return size_bytes_;
+}
+
+std::shared_ptr<UnixDatagramSink> UnixDatagramSink::create(const std::string& socket_path,
+                                                           LogLevel min_level) {
+#ifdef SPECKIT_PLATFORM_WINDOWS
+    (void)socket_path;
+    (void)min_level;
+    return nullptr;  // No AF_UNIX datagram sockets
+#else
+    if (socket_path.empty() || socket_path.size() >= sizeof(sockaddr_un{}.sun_path)) {
+        return nullptr;
+    }
+    const int fd = ::socket(AF_UNIX, SOCK_DGRAM, 0);
+    if (fd < 0) {
+        return nullptr;
+    }
+    // A stalled receiver must cost a dropped line, never a blocked sink thread
+    ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL) | O_NONBLOCK);
+    ::fcntl(fd, F_SETFD, FD_CLOEXEC);
+    return std::shared_ptr<UnixDatagramSink>(new UnixDatagramSink(fd, socket_path, min_level));
+#endif
+}
+
+UnixDatagramSink::UnixDatagramSink(int fd, const std::string& socket_path, LogLevel min_level)
+    : LogSink(min_level), fd_(fd), socket_path_(socket_path) {}
+
+UnixDatagramSink::~UnixDatagramSink() {
+#ifndef SPECKIT_PLATFORM_WINDOWS
+    ::close(fd_);
+#endif
+}
+
+void UnixDatagramSink::write(const SinkBatch& batch) {
+#ifndef SPECKIT_PLATFORM_WINDOWS
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    std::memcpy(address.sun_path, socket_path_.data(), socket_path_.size());
+
+    forEachLine(batch, [&](std::string_view line, LogLevel) {
+        // Unconnected sends, so a receiver that restarts is picked up again
+        if (::sendto(fd_, line.data(), line.size(), 0, reinterpret_cast<const sockaddr*>(&address),
+                     sizeof(address)) < 0) {
+            send_failures_.fetch_add(1, std::memory_order_relaxed);
+        }
+    });
+#else
+    (void)batch;
+#endif
+}
+
+uint64_t UnixDatagramSink::getSendFailures() const {
+    return send_failures_.load(std::memory_order_relaxed);
+}
+
+CallbackSink::CallbackSink(Callback callback, LogLevel min_level)
+    : LogSink(min_level), callback_(std::move(callback)) {}
+
+void CallbackSink::write(const SinkBatch& batch) {
+    forEachLine(batch, [&](std::string_view line, LogLevel level) { callback_(level, line); });
+}
@@ -0,0 +1,290 @@
+// Runtime metrics implementation
+
+#include "speckit/log/metrics.h"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <filesystem>
+#include <format>
+#include <fstream>
+
+namespace {
+
+// Lock-free monotonic min/max updates
+void updateMin(std::atomic<uint64_t>& target, uint64_t value) {
+    uint64_t current = target.load(std::memory_order_relaxed);
+    while (value < current &&
+           !target.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+    }
+}
+
+void updateMax(std::atomic<uint64_t>& target, uint64_t value) {
+    uint64_t current = target.load(std::memory_order_relaxed);
+    while (value > current &&
+           !target.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+    }
+}
+
+uint64_t toNanos(std::chrono::nanoseconds duration) {
+    return duration.count() > 0 ? static_cast<uint64_t>(duration.count()) : 0;
+}
+
+std::string formatSummary(const char* name, const HistogramSummary& s) {
+    return std::format("{} count={} min={} p50={} p90={} p99={} p999={} max={} mean={:.1f}\n",
+                       name, s.count, s.min, s.p50, s.p90, s.p99, s.p999, s.max, s.mean);
+}
+
+}  // namespace
+
+size_t Histogram::bucketIndex(uint64_t value) {
+    if (value < kSubBucketCount) {
+        return static_cast<size_t>(value);  // Exact buckets for small values
+    }
+    const unsigned msb = 63 - static_cast<unsigned>(std::countl_zero(value));
+    const unsigned shift = msb - kSubBucketBits;
+    const uint64_t sub = (value >> shift) & (kSubBucketCount - 1);
+    return static_cast<size_t>(kSubBucketCount + shift * kSubBucketCount + sub);
+}
+
+uint64_t Histogram::bucketUpperBound(size_t index) {
+    if (index < kSubBucketCount) {
+        return index;
+    }
+    const uint64_t shift = (index - kSubBucketCount) / kSubBucketCount;
+    const uint64_t sub = (index - kSubBucketCount) % kSubBucketCount;
+    const uint64_t lower = (kSubBucketCount + sub) << shift;
+    return lower + ((1ULL << shift) - 1);
+}
+
+void Histogram::record(uint64_t value) {
+    buckets_[bucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+    count_.fetch_add(1, std::memory_order_relaxed);
+    sum_.fetch_add(value, std::memory_order_relaxed);
+    updateMin(min_, value);
+    updateMax(max_, value);
+}
+
+void Histogram::merge(const Histogram& other) {
+    for (size_t i = 0; i < kBucketCount; ++i) {
+        uint64_t n = other.buckets_[i].load(std::memory_order_relaxed);
+        if (n != 0) {
+            buckets_[i].fetch_add(n, std::memory_order_relaxed);
+        }
+    }
+    count_.fetch_add(other.count_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    sum_.fetch_add(other.sum_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    updateMin(min_, other.min_.load(std::memory_order_relaxed));
+    updateMax(max_, other.max_.load(std::memory_order_relaxed));
+}
+
+void Histogram::reset() {
+    for (auto& bucket : buckets_) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+    count_.store(0, std::memory_order_relaxed);
+    sum_.store(0, std::memory_order_relaxed);
+    min_.store(UINT64_MAX, std::memory_order_relaxed);
+    max_.store(0, std::memory_order_relaxed);
+}
+
+uint64_t Histogram::count() const {
+    return count_.load(std::memory_order_relaxed);
+}
+
+uint64_t Histogram::percentile(double pct) const {
+    const uint64_t total = count();
+    if (total == 0) {
+        return 0;
+    }
+
+    pct = std::clamp(pct, 0.0, 100.0);
+    uint64_t target = static_cast<uint64_t>(std::ceil(pct / 100.0 * static_cast<double>(total)));
+    target = std::max<uint64_t>(target, 1);
+
+    const uint64_t max_value = max_.load(std::memory_order_relaxed);
+    uint64_t seen = 0;
+    for (size_t i = 0; i < kBucketCount; ++i) {
+        seen += buckets_[i].load(std::memory_order_relaxed);
+        if (seen >= target) {
+            return std::min(bucketUpperBound(i), max_value);
+        }
+    }
+    return max_value;
+}
+
+HistogramSummary Histogram::summarize() const {
+    HistogramSummary summary;
+    summary.count = count();
+    if (summary.count == 0) {
+        return summary;
+    }
+    summary.min = min_.load(std::memory_order_relaxed);
+    summary.max = max_.load(std::memory_order_relaxed);
+    summary.mean = static_cast<double>(sum_.load(std::memory_order_relaxed)) /
+                   static_cast<double>(summary.count);
+    summary.p50 = percentile(50.0);
+    summary.p90 = percentile(90.0);
+    summary.p99 = percentile(99.0);
+    summary.p999 = percentile(99.9);
+    return summary;
+}
+
+size_t LoggerMetrics::shardIndex() {
+    static std::atomic<size_t> next_shard{0};
+    thread_local const size_t shard =
+        next_shard.fetch_add(1, std::memory_order_relaxed) % kShardCount;
+    return shard;
+}
+
+void LoggerMetrics::add(Counter counter, uint64_t amount) {
+    shards_[shardIndex()].values[static_cast<size_t>(counter)].fetch_add(
+        amount, std::memory_order_relaxed);
+}
+
+uint64_t LoggerMetrics::value(Counter counter) const {
+    uint64_t total = 0;
+    for (const auto& shard : shards_) {
+        total += shard.values[static_cast<size_t>(counter)].load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+void LoggerMetrics::observeQueueDepth(uint64_t depth) {
+    updateMax(queue_high_water_, depth);
+}
+
+void LoggerMetrics::recordBatch(uint64_t entries) {
+    add(Counter::kBatches);
+    batch_size_.record(entries);
+}
+
+void LoggerMetrics::recordFlushLatency(std::chrono::nanoseconds latency) {
+    flush_latency_.record(toNanos(latency));
+}
+
+void LoggerMetrics::recordFsyncLatency(std::chrono::nanoseconds latency) {
+    fsync_latency_.record(toNanos(latency));
+}
+
+void LoggerMetrics::recordRotation(std::chrono::nanoseconds duration) {
+    add(Counter::kRotations);
+    rotation_.record(toNanos(duration));
+}
+
+void LoggerMetrics::addDropped(LogLevel level) {
+    const size_t index = std::min(static_cast<size_t>(level), kLogLevelCount - 1);
+    Shard& shard = shards_[shardIndex()];
+    shard.values[static_cast<size_t>(Counter::kEntriesDropped)].fetch_add(1, std::memory_order_relaxed);
+    shard.values[static_cast<size_t>(Counter::kDroppedDebug) + index].fetch_add(1, std::memory_order_relaxed);
+}
+
+std::array<uint64_t, kLogLevelCount> LoggerMetrics::droppedByLevel() const {
+    std::array<uint64_t, kLogLevelCount> dropped{};
+    for (size_t i = 0; i < kLogLevelCount; ++i) {
+        dropped[i] = value(static_cast<Counter>(static_cast<size_t>(Counter::kDroppedDebug) + i));
+    }
+    return dropped;
+}
+
+MetricsSnapshot LoggerMetrics::snapshot() const {
+    MetricsSnapshot snapshot;
+    snapshot.entries_enqueued = value(Counter::kEntriesEnqueued);
+    snapshot.entries_dropped = value(Counter::kEntriesDropped);
+    snapshot.dropped_by_level = droppedByLevel();
+    snapshot.entries_rate_limited = value(Counter::kEntriesRateLimited);
+    snapshot.repeats_collapsed = value(Counter::kRepeatsCollapsed);
+    snapshot.entries_sampled_out = value(Counter::kEntriesSampledOut);
+    snapshot.entries_written = value(Counter::kEntriesWritten);
+    snapshot.bytes_written = value(Counter::kBytesWritten);
+    snapshot.emergency_bytes_unstaged = value(Counter::kEmergencyBytesUnstaged);
+    snapshot.queue_high_water = queue_high_water_.load(std::memory_order_relaxed);
+    snapshot.batches = value(Counter::kBatches);
+    snapshot.rotations = value(Counter::kRotations);
+    snapshot.writer_parks = value(Counter::kWriterParks);
+    snapshot.batch_size = batch_size_.summarize();
+    snapshot.flush_latency_ns = flush_latency_.summarize();
+    snapshot.fsync_latency_ns = fsync_latency_.summarize();
+    snapshot.rotation_ns = rotation_.summarize();
+    return snapshot;
+}
+
+std::string formatMetrics(const MetricsSnapshot& snapshot) {
+    std::string out;
+    out += std::format("entries_enqueued {}\n", snapshot.entries_enqueued);
+    out += std::format("entries_dropped {}\n", snapshot.entries_dropped);
+    static constexpr const char* kLevelKeys[kLogLevelCount] = {"debug", "info", "warning", "error"};
+    for (size_t i = 0; i < kLogLevelCount; ++i) {
+        out += std::format("entries_dropped_{} {}\n", kLevelKeys[i], snapshot.dropped_by_level[i]);
+    }
+    out += std::format("entries_rate_limited {}\n", snapshot.entries_rate_limited);
+    out += std::format("repeats_collapsed {}\n", snapshot.repeats_collapsed);
+    out += std::format("entries_sampled_out {}\n", snapshot.entries_sampled_out);
+    out += std::format("entries_written {}\n", snapshot.entries_written);
+    out += std::format("bytes_written {}\n", snapshot.bytes_written);
+    out += std::format("emergency_bytes_unstaged {}\n", snapshot.emergency_bytes_unstaged);
+    out += std::format("queue_high_water {}\n", snapshot.queue_high_water);
+    out += std::format("batches {}\n", snapshot.batches);
+    out += std::format("rotations {}\n", snapshot.rotations);
+    out += std::format("writer_parks {}\n", snapshot.writer_parks);
+    out += formatSummary("batch_size", snapshot.batch_size);
+    out += formatSummary("flush_latency_ns", snapshot.flush_latency_ns);
+    out += formatSummary("fsync_latency_ns", snapshot.fsync_latency_ns);
+    out += formatSummary("rotation_ns", snapshot.rotation_ns);
+    return out;
+}
+
+MetricsDumper::~MetricsDumper() {
+    stop();
+}
+
+bool MetricsDumper::start(const LoggerMetrics& metrics, const std::string& path,
+                          std::chrono::milliseconds interval) {
+    stop();
+    if (interval.count() <= 0 || path.empty()) {
+        return false;
+    }
+
+    metrics_ = &metrics;
+    path_ = path;
+    thread_ = std::jthread([this, interval](std::stop_token stop_token) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (!stop_token.stop_requested()) {
+            // Returns early only when stop is requested
+            if (cv_.wait_for(lock, stop_token, interval, [] { return false; })) {
+                break;
+            }
+            if (stop_token.stop_requested()) {
+                break;
+            }
+            dumpToFile(*metrics_, path_);
+        }
+    });
+    return true;
+}
+
+void MetricsDumper::stop() {
+    if (!thread_.joinable()) {
+        return;
+    }
+    thread_.request_stop();
+    thread_.join();
+    dumpToFile(*metrics_, path_);
+}
+
+bool MetricsDumper::dumpToFile(const LoggerMetrics& metrics, const std::string& path) {
+    // Write to a temporary file and rename so readers never see a partial dump
+    const std::string temp_path = path + ".tmp";
+    {
+        std::ofstream out(temp_path, std::ios::trunc);
+        if (!out.is_open()) {
+            return false;
+        }
+        out << formatMetrics(metrics.snapshot());
+        if (!out.good()) {
+            return false;
+        }
+    }
+    std::error_code ec;
+    std::filesystem::rename(temp_path, path, ec);
+    return !ec;
+}
@@ -0,0 +1,145 @@
+// Slab arena implementation
+
+#include "speckit/log/payload_arena.h"
+#include <algorithm>
+#include <new>
+
+namespace {
+
+constexpr uint64_t kIndexMask = 0xffffffffu;
+
+}  // namespace
+
+thread_local PayloadArena::ThreadChunk PayloadArena::t_chunk_;
+
+PayloadArena::ThreadChunk::~ThreadChunk() {
+    if (chunk) {
+        // Payloads still queued keep the chunk until the writer releases them
+        chunk->arena->retire(chunk);
+    }
+}
+
+PayloadArena& PayloadArena::global() {
+    // Intentionally leaked: queued entries may be released after static destructors run
+    static PayloadArena* arena = new PayloadArena();
+    return *arena;
+}
+
+PayloadArena::PayloadArena() : max_chunks_(kDefaultMemoryBudget / kChunkBytes) {}
+
+PayloadAllocation PayloadArena::allocate(size_t size) {
+    if (size > kMaxPayloadBytes) {
+        oversize_allocations_.fetch_add(1, std::memory_order_relaxed);
+        return PayloadAllocation{new char[size], nullptr};
+    }
+
+    PayloadChunk* chunk = t_chunk_.chunk;
+    if (!chunk || chunk->used + size > kChunkBytes) {
+        if (chunk) {
+            retire(chunk);
+        }
+        chunk = acquireChunk();
+        t_chunk_.chunk = chunk;
+        if (!chunk) {
+            allocation_failures_.fetch_add(1, std::memory_order_relaxed);
+            return PayloadAllocation{new char[size], nullptr};
+        }
+    }
+
+    // Only this thread touches used/allocations; the reference is pre-charged by the bias
+    char* data = chunk->data() + chunk->used;
+    chunk->used += size;
+    ++chunk->allocations;
+    return PayloadAllocation{data, chunk};
+}
+
+void PayloadArena::release(PayloadChunk* chunk) noexcept {
+    if (chunk->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        chunk->arena->pushFree(chunk);
+    }
+}
+
+void PayloadArena::retire(PayloadChunk* chunk) {
+    // Return the part of the bias that no payload took
+    const uint32_t unused = kProducerBias - chunk->allocations;
+    if (chunk->refs.fetch_sub(unused, std::memory_order_acq_rel) == unused) {
+        pushFree(chunk);
+    }
+}
+
+PayloadChunk* PayloadArena::acquireChunk() {
+    PayloadChunk* chunk = popFree();
+    if (!chunk) {
+        size_t count = chunk_count_.load(std::memory_order_relaxed);
+        do {
+            if (count >= max_chunks_.load(std::memory_order_relaxed)) {
+                return nullptr;
+            }
+        } while (!chunk_count_.compare_exchange_weak(count, count + 1, std::memory_order_relaxed));
+
+        void* memory = ::operator new(sizeof(PayloadChunk) + kChunkBytes, std::nothrow);
+        if (!memory) {
+            chunk_count_.fetch_sub(1, std::memory_order_relaxed);
+            return nullptr;
+        }
+        chunk = new (memory) PayloadChunk();
+        chunk->arena = this;
+        chunk->index = static_cast<uint32_t>(count);
+        chunks_[count].store(chunk, std::memory_order_release);
+    }
+
+    chunk->used = 0;
+    chunk->allocations = 0;
+    chunk->refs.store(kProducerBias, std::memory_order_relaxed);
+    return chunk;
+}
+
+void PayloadArena::pushFree(PayloadChunk* chunk) {
+    uint64_t head = free_head_.load(std::memory_order_relaxed);
+    uint64_t next;
+    do {
+        chunk->next_free.store(static_cast<uint32_t>(head & kIndexMask), std::memory_order_relaxed);
+        next = (((head >> 32) + 1) << 32) | (chunk->index + 1);
+    } while (!free_head_.compare_exchange_weak(head, next, std::memory_order_release,
+                                               std::memory_order_relaxed));
+    free_count_.fetch_add(1, std::memory_order_relaxed);
+}
+
+PayloadChunk* PayloadArena::popFree() {
+    uint64_t head = free_head_.load(std::memory_order_acquire);
+    PayloadChunk* chunk;
+    uint64_t next;
+    do {
+        const uint64_t top = head & kIndexMask;
+        if (top == 0) {
+            return nullptr;
+        }
+        // Chunks are never freed, so reading the link of a chunk popped meanwhile is
+        // harmless; the tag makes the exchange fail in that case
+        chunk = chunks_[top - 1].load(std::memory_order_acquire);
+        next = (((head >> 32) + 1) << 32) | chunk->next_free.load(std::memory_order_relaxed);
+    } while (!free_head_.compare_exchange_weak(head, next, std::memory_order_acq_rel,
+                                               std::memory_order_acquire));
+    free_count_.fetch_sub(1, std::memory_order_relaxed);
+    return chunk;
+}
+
+void PayloadArena::setMemoryBudget(size_t bytes) {
+    max_chunks_.store(std::min(bytes / kChunkBytes, kMaxChunks), std::memory_order_relaxed);
+}
+
+size_t PayloadArena::getMemoryBudget() const {
+    return max_chunks_.load(std::memory_order_relaxed) * kChunkBytes;
+}
+
+PayloadArenaStats PayloadArena::getStats() const {
+    PayloadArenaStats stats;
+    stats.chunk_bytes = kChunkBytes;
+    stats.memory_budget = getMemoryBudget();
+    stats.chunks_allocated = chunk_count_.load(std::memory_order_relaxed);
+    const size_t free_chunks = free_count_.load(std::memory_order_relaxed);
+    stats.chunks_in_use = stats.chunks_allocated - std::min(free_chunks, stats.chunks_allocated);
+    stats.allocation_failures = allocation_failures_.load(std::memory_order_relaxed);
+    stats.oversize_allocations = oversize_allocations_.load(std::memory_order_relaxed);
+    return stats;
+}
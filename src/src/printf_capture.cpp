@@ -0,0 +1,440 @@
+// Deferred printf-style formatting implementation
+
+#include "speckit/log/printf_capture.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <type_traits>
+
+namespace speckit {
+namespace log {
+
+namespace {  // internal helpers
+
+// Record layout: [uint32 format length][format bytes][argument records...]
+// Argument record: [ArgKind][payload]; strings are [uint32 length][bytes].
+enum class ArgKind : uint8_t {
+    kSigned = 1,     ///< int64_t (also '*' width/precision and %c)
+    kUnsigned,       ///< uint64_t
+    kDouble,         ///< double
+    kLongDouble,     ///< long double
+    kPointer,        ///< uintptr_t
+    kString,         ///< Deep-copied string
+    kNullString,     ///< %s with a null pointer
+};
+
+enum class Length { kNone, kChar, kShort, kLong, kLongLong, kIntMax, kSize, kPtrDiff, kLongDouble };
+
+/// One parsed conversion specification (the part after '%')
+struct Conversion {
+    std::string_view flags;
+    std::string_view width;       ///< Digits, or "*"
+    std::string_view precision;   ///< Digits, or "*"; empty digits mean 0
+    bool has_precision = false;
+    Length length = Length::kNone;
+    char conversion = 0;
+};
+
+bool isDigit(char c) {
+    return c >= '0' && c <= '9';
+}
+
+/// Parse the conversion that starts right after a '%' at @p pos. Advances @p pos past it.
+bool parseConversion(std::string_view format, size_t& pos, Conversion& conv) {
+    auto peek = [&](size_t offset = 0) { return pos + offset < format.size() ? format[pos + offset] : '\0'; };
+
+    size_t start = pos;
+    while (std::strchr("-+ #0", peek()) && peek() != '\0') {
+        ++pos;
+    }
+    conv.flags = format.substr(start, pos - start);
+
+    start = pos;
+    if (peek() == '*') {
+        ++pos;
+    } else {
+        while (isDigit(peek())) {
+            ++pos;
+        }
+        if (peek() == '$') {
+            return false;  // Positional arguments are not supported
+        }
+    }
+    conv.width = format.substr(start, pos - start);
+
+    if (peek() == '.') {
+        ++pos;
+        conv.has_precision = true;
+        start = pos;
+        if (peek() == '*') {
+            ++pos;
+        } else {
+            while (isDigit(peek())) {
+                ++pos;
+            }
+        }
+        conv.precision = format.substr(start, pos - start);
+    }
+
+    switch (peek()) {
+    case 'h':
+        ++pos;
+        conv.length = Length::kShort;
+        if (peek() == 'h') {
+            ++pos;
+            conv.length = Length::kChar;
+        }
+        break;
+    case 'l':
+        ++pos;
+        conv.length = Length::kLong;
+        if (peek() == 'l') {
+            ++pos;
+            conv.length = Length::kLongLong;
+        }
+        break;
+    case 'j': ++pos; conv.length = Length::kIntMax; break;
+    case 'z': ++pos; conv.length = Length::kSize; break;
+    case 't': ++pos; conv.length = Length::kPtrDiff; break;
+    case 'L': ++pos; conv.length = Length::kLongDouble; break;
+    default: break;
+    }
+
+    conv.conversion = peek();
+    if (conv.conversion == '\0') {
+        return false;
+    }
+    ++pos;
+
+    // Reject length modifiers that do not apply to the conversion
+    switch (conv.conversion) {
+    case 'd': case 'i': case 'u': case 'o': case 'x': case 'X':
+        return conv.length != Length::kLongDouble;
+    case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A':
+        return conv.length == Length::kNone || conv.length == Length::kLong ||
+               conv.length == Length::kLongDouble;
+    case 'c': case 's': case 'p':
+        return conv.length == Length::kNone;  // No wide characters
+    default:
+        return false;  // Includes %n
+    }
+}
+
+template <typename T>
+void appendRaw(std::string& out, T value) {
+    char bytes[sizeof(T)];
+    std::memcpy(bytes, &value, sizeof(T));
+    out.append(bytes, sizeof(T));
+}
+
+template <typename T>
+void appendArg(std::string& out, ArgKind kind, T value) {
+    out.push_back(static_cast<char>(kind));
+    appendRaw(out, value);
+}
+
+int64_t readSigned(Length length, va_list& args) {
+    switch (length) {
+    case Length::kChar:     return static_cast<signed char>(va_arg(args, int));
+    case Length::kShort:    return static_cast<short>(va_arg(args, int));
+    case Length::kLong:     return va_arg(args, long);
+    case Length::kLongLong: return va_arg(args, long long);
+    case Length::kIntMax:   return va_arg(args, intmax_t);
+    case Length::kSize:     return va_arg(args, std::make_signed_t<size_t>);
+    case Length::kPtrDiff:  return va_arg(args, ptrdiff_t);
+    default:                return va_arg(args, int);
+    }
+}
+
+uint64_t readUnsigned(Length length, va_list& args) {
+    switch (length) {
+    case Length::kChar:     return static_cast<unsigned char>(va_arg(args, unsigned int));
+    case Length::kShort:    return static_cast<unsigned short>(va_arg(args, unsigned int));
+    case Length::kLong:     return va_arg(args, unsigned long);
+    case Length::kLongLong: return va_arg(args, unsigned long long);
+    case Length::kIntMax:   return va_arg(args, uintmax_t);
+    case Length::kSize:     return va_arg(args, size_t);
+    case Length::kPtrDiff:  return va_arg(args, std::make_unsigned_t<ptrdiff_t>);
+    default:                return va_arg(args, unsigned int);
+    }
+}
+
+/// Sequential reader over a captured record
+class Reader {
+public:
+    explicit Reader(std::string_view data) : data_(data) {}
+
+    template <typename T>
+    bool read(T& value) {
+        if (data_.size() - pos_ < sizeof(T)) return false;
+        std::memcpy(&value, data_.data() + pos_, sizeof(T));
+        pos_ += sizeof(T);
+        return true;
+    }
+
+    bool readBytes(size_t size, std::string_view& bytes) {
+        if (data_.size() - pos_ < size) return false;
+        bytes = data_.substr(pos_, size);
+        pos_ += size;
+        return true;
+    }
+
+    template <typename T>
+    bool readArg(ArgKind expected, T& value) {
+        uint8_t kind = 0;
+        return read(kind) && kind == static_cast<uint8_t>(expected) && read(value);
+    }
+
+    bool readKind(ArgKind& kind) {
+        uint8_t raw = 0;
+        if (!read(raw)) return false;
+        kind = static_cast<ArgKind>(raw);
+        return true;
+    }
+
+private:
+    std::string_view data_;
+    size_t pos_ = 0;
+};
+
+/// snprintf one conversion with up to two '*' values and append the result
+template <typename T>
+void appendFormatted(std::string& out, const std::string& spec, const int* stars, int star_count, T value) {
+    char stack_buffer[256];
+    auto print = [&](char* buffer, size_t size) {
+        switch (star_count) {
+        case 0:  return std::snprintf(buffer, size, spec.c_str(), value);
+        case 1:  return std::snprintf(buffer, size, spec.c_str(), stars[0], value);
+        default: return std::snprintf(buffer, size, spec.c_str(), stars[0], stars[1], value);
+        }
+    };
+
+    int length = print(stack_buffer, sizeof(stack_buffer));
+    if (length < 0) {
+        return;
+    }
+    if (static_cast<size_t>(length) < sizeof(stack_buffer)) {
+        out.append(stack_buffer, static_cast<size_t>(length));
+        return;
+    }
+    const size_t offset = out.size();
+    out.resize(offset + static_cast<size_t>(length) + 1);
+    print(out.data() + offset, static_cast<size_t>(length) + 1);
+    out.resize(offset + static_cast<size_t>(length));
+}
+
+}  // namespace
+
+bool capturePrintf(const char* format, va_list args, std::string& out) {
+    if (!format) {
+        return false;
+    }
+
+    const size_t original_size = out.size();
+    const std::string_view fmt(format);
+    appendRaw(out, static_cast<uint32_t>(fmt.size()));
+    out.append(fmt);
+
+    va_list ap;
+    va_copy(ap, args);
+    bool ok = true;
+    size_t pos = 0;
+    while (ok && (pos = fmt.find('%', pos)) != std::string_view::npos) {
+        ++pos;
+        if (pos < fmt.size() && fmt[pos] == '%') {
+            ++pos;
+            continue;
+        }
+
+        Conversion conv;
+        if (!parseConversion(fmt, pos, conv)) {
+            ok = false;
+            break;
+        }
+
+        if (conv.width == "*") {
+            appendArg(out, ArgKind::kSigned, static_cast<int64_t>(va_arg(ap, int)));
+        }
+        int64_t precision = -1;
+        if (conv.has_precision) {
+            if (conv.precision == "*") {
+                precision = va_arg(ap, int);
+                appendArg(out, ArgKind::kSigned, precision);
+            } else {
+                precision = 0;
+                for (char c : conv.precision) {
+                    precision = precision * 10 + (c - '0');
+                }
+            }
+        }
+
+        switch (conv.conversion) {
+        case 'd': case 'i':
+            appendArg(out, ArgKind::kSigned, readSigned(conv.length, ap));
+            break;
+        case 'u': case 'o': case 'x': case 'X':
+            appendArg(out, ArgKind::kUnsigned, readUnsigned(conv.length, ap));
+            break;
+        case 'c':
+            appendArg(out, ArgKind::kSigned, static_cast<int64_t>(va_arg(ap, int)));
+            break;
+        case 'p':
+            appendArg(out, ArgKind::kPointer, reinterpret_cast<uintptr_t>(va_arg(ap, void*)));
+            break;
+        case 's': {
+            const char* str = va_arg(ap, const char*);
+            if (!str) {
+                out.push_back(static_cast<char>(ArgKind::kNullString));
+                break;
+            }
+            // With a precision the string need not be NUL-terminated
+            size_t length = 0;
+            if (precision >= 0) {
+                while (length < static_cast<size_t>(precision) && str[length] != '\0') {
+                    ++length;
+                }
+            } else {
+                length = std::strlen(str);
+            }
+            appendArg(out, ArgKind::kString, static_cast<uint32_t>(length));
+            out.append(str, length);
+            break;
+        }
+        default:  // Floating point
+            if (conv.length == Length::kLongDouble) {
+                appendArg(out, ArgKind::kLongDouble, va_arg(ap, long double));
+            } else {
+                appendArg(out, ArgKind::kDouble, va_arg(ap, double));
+            }
+            break;
+        }
+    }
+    va_end(ap);
+
+    if (!ok) {
+        out.resize(original_size);
+    }
+    return ok;
+}
+
+std::string renderPrintf(std::string_view captured) {
+    Reader reader(captured);
+    uint32_t format_size = 0;
+    std::string_view fmt;
+    if (!reader.read(format_size) || !reader.readBytes(format_size, fmt)) {
+        return std::string();
+    }
+
+    std::string out;
+    out.reserve(fmt.size() + 32);
+    std::string spec;
+    size_t pos = 0;
+    while (pos < fmt.size()) {
+        size_t percent = fmt.find('%', pos);
+        out.append(fmt.substr(pos, percent == std::string_view::npos ? std::string_view::npos : percent - pos));
+        if (percent == std::string_view::npos) {
+            break;
+        }
+        pos = percent + 1;
+        if (pos < fmt.size() && fmt[pos] == '%') {
+            out.push_back('%');
+            ++pos;
+            continue;
+        }
+
+        Conversion conv;
+        if (!parseConversion(fmt, pos, conv)) {
+            break;  // capturePrintf() never stores such a format
+        }
+
+        int stars[2] = {0, 0};
+        int star_count = 0;
+        int64_t star = 0;
+        if (conv.width == "*") {
+            if (!reader.readArg(ArgKind::kSigned, star)) break;
+            stars[star_count++] = static_cast<int>(star);
+        }
+        if (conv.has_precision && conv.precision == "*") {
+            if (!reader.readArg(ArgKind::kSigned, star)) break;
+            stars[star_count++] = static_cast<int>(star);
+        }
+
+        // Rebuild the spec with a length modifier matching the stored type
+        spec.assign("%");
+        spec.append(conv.flags);
+        spec.append(conv.width);
+        if (conv.has_precision) {
+            spec.push_back('.');
+            spec.append(conv.precision);
+        }
+
+        bool ok = true;
+        switch (conv.conversion) {
+        case 'd': case 'i': {
+            int64_t value = 0;
+            ok = reader.readArg(ArgKind::kSigned, value);
+            spec.append("ll").push_back(conv.conversion);
+            if (ok) appendFormatted(out, spec, stars, star_count, static_cast<long long>(value));
+            break;
+        }
+        case 'u': case 'o': case 'x': case 'X': {
+            uint64_t value = 0;
+            ok = reader.readArg(ArgKind::kUnsigned, value);
+            spec.append("ll").push_back(conv.conversion);
+            if (ok) appendFormatted(out, spec, stars, star_count, static_cast<unsigned long long>(value));
+            break;
+        }
+        case 'c': {
+            int64_t value = 0;
+            ok = reader.readArg(ArgKind::kSigned, value);
+            spec.push_back('c');
+            if (ok) appendFormatted(out, spec, stars, star_count, static_cast<int>(value));
+            break;
+        }
+        case 'p': {
+            uintptr_t value = 0;
+            ok = reader.readArg(ArgKind::kPointer, value);
+            spec.push_back('p');
+            if (ok) appendFormatted(out, spec, stars, star_count, reinterpret_cast<void*>(value));
+            break;
+        }
+        case 's': {
+            ArgKind kind;
+            ok = reader.readKind(kind);
+            spec.push_back('s');
+            if (!ok) break;
+            if (kind == ArgKind::kNullString) {
+                appendFormatted(out, spec, stars, star_count, "(null)");
+                break;
+            }
+            uint32_t length = 0;
+            std::string_view bytes;
+            ok = kind == ArgKind::kString && reader.read(length) && reader.readBytes(length, bytes);
+            if (ok) appendFormatted(out, spec, stars, star_count, std::string(bytes).c_str());
+            break;
+        }
+        default:  // Floating point
+            if (conv.length == Length::kLongDouble) {
+                long double value = 0;
+                ok = reader.readArg(ArgKind::kLongDouble, value);
+                spec.push_back('L');
+                spec.push_back(conv.conversion);
+                if (ok) appendFormatted(out, spec, stars, star_count, value);
+            } else {
+                double value = 0;
+                ok = reader.readArg(ArgKind::kDouble, value);
+                spec.push_back(conv.conversion);
+                if (ok) appendFormatted(out, spec, stars, star_count, value);
+            }
+            break;
+        }
+        if (!ok) {
+            break;
+        }
+    }
+    return out;
+}
+
+}  // namespace log
+}  // namespace speckit
@@ -0,0 +1,93 @@
+// Per-call-site rate limiter implementation
+
+#include "speckit/log/rate_limiter.h"
+#include <algorithm>
+#include <chrono>
+#include <functional>
+
+using namespace speckit::log;
+
+namespace {
+
+constexpr uint64_t kPerSecondMask = CallSiteRateLimiter::kMaxPerSecond;
+constexpr unsigned kBurstShift = 20;
+constexpr unsigned kGenerationShift = 32;
+constexpr unsigned kCheckShift = 48;
+
+/// Mix the site's file pointer, line and tag into a 64-bit hash (splitmix64 finalizer)
+uint64_t hashSite(const std::source_location& site, std::string_view tag) {
+    uint64_t h = reinterpret_cast<uintptr_t>(site.file_name());
+    h ^= (static_cast<uint64_t>(site.line()) << 32) ^ site.column();
+    h ^= std::hash<std::string_view>{}(tag) * 0x9e3779b97f4a7c15ull;
+    h = (h ^ (h >> 30)) * 0xbf58476d1ce4e5b9ull;
+    h = (h ^ (h >> 27)) * 0x94d049bb133111ebull;
+    return h ^ (h >> 31);
+}
+
+}  // namespace
+
+bool CallSiteRateLimiter::tryAcquire(const std::source_location& site, std::string_view tag,
+                                     const TagFilter& filter) {
+    const uint64_t hash = hashSite(site, tag);
+    const uint64_t key = ((hash >> kCheckShift) << kCheckShift) |
+                         (static_cast<uint64_t>(filter.generation() & 0xffff) << kGenerationShift);
+    auto resolve = [&] {
+        const RateLimit limit = filter.getTagRateLimit(tag);
+        const uint64_t burst = std::clamp<uint32_t>(limit.burst, 1, kMaxBurst);
+        return key | (burst << kBurstShift) | std::min(limit.per_second, kMaxPerSecond);
+    };
+
+    // Find the site's slot, or claim a free one (rule 0; a set rule has burst >= 1)
+    const size_t home = hash % kSlotCount;
+    Slot* slot = nullptr;
+    uint64_t rule = 0;
+    for (size_t probe = 0; probe < kProbeLength && !slot; ++probe) {
+        Slot& candidate = slots_[(home + probe) % kSlotCount];
+        uint64_t current = candidate.rule.load(std::memory_order_relaxed);
+        if (current == 0) {
+            const uint64_t claimed = resolve();
+            if (candidate.rule.compare_exchange_strong(current, claimed, std::memory_order_relaxed)) {
+                return takeToken(candidate, claimed);
+            }
+            // Another site got it first; current now holds its rule
+        }
+        if ((current >> kCheckShift) == (key >> kCheckShift)) {
+            slot = &candidate;
+            rule = current;
+        }
+    }
+
+    if (!slot) {
+        // Every probed slot is taken: share the first one's bucket with this site's
+        // own limit, leaving the owner's rule alone
+        return takeToken(slots_[home], resolve());
+    }
+    if ((rule & ~0xffffffffull) != key) {
+        // The filter changed: resolve the tag's limit again, with a full burst
+        rule = resolve();
+        slot->next_ns.store(0, std::memory_order_relaxed);
+        slot->rule.store(rule, std::memory_order_relaxed);
+    }
+    return takeToken(*slot, rule);
+}
+
+bool CallSiteRateLimiter::takeToken(Slot& slot, uint64_t rule) {
+    const uint64_t per_second = rule & kPerSecondMask;
+    if (per_second == 0) {
+        return true;  // Unlimited
+    }
+    const int64_t interval = 1'000'000'000 / static_cast<int64_t>(per_second);
+    const int64_t tolerance = interval * static_cast<int64_t>(((rule >> kBurstShift) & kMaxBurst) - 1);
+    const int64_t now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+
+    int64_t next = slot.next_ns.load(std::memory_order_relaxed);
+    int64_t desired;
+    do {
+        if (next - tolerance > now) {
+            return false;  // Over the limit; nothing written
+        }
+        desired = std::max(next, now) + interval;
+    } while (!slot.next_ns.compare_exchange_weak(next, desired, std::memory_order_relaxed));
+    return true;
+}
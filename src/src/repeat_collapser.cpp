@@ -0,0 +1,71 @@
+// Repeat collapsing implementation
+
+#include "speckit/log/repeat_collapser.h"
+#include <format>
+#include <utility>
+
+CollapseResult RepeatCollapser::collapse(std::span<LogEntry> batch,
+                                         const speckit::log::TagFilter& filter) {
+    CollapseResult result;
+    size_t out = 0;
+    for (LogEntry& entry : batch) {
+        if (has_last_ && isRepeat(entry)) {
+            ++repeats_;
+            ++result.removed;
+            last_.timestamp_ms = entry.timestamp_ms;  // The marker shows the last repeat's time
+            entry.storage.reset();
+            continue;
+        }
+
+        // Every repeat since the last marker freed a slot before this one
+        if (repeats_ > 0) {
+            batch[out++] = makeMarker();
+            repeats_ = 0;
+        }
+        has_last_ = collapses(entry.tag, filter);
+        if (has_last_) {
+            remember(entry);
+        }
+        if (&batch[out] != &entry) {
+            batch[out] = std::move(entry);
+        }
+        ++out;
+    }
+
+    if (repeats_ > 0) {
+        batch[out++] = makeMarker();
+        repeats_ = 0;
+    }
+    result.size = out;
+    return result;
+}
+
+bool RepeatCollapser::isRepeat(const LogEntry& entry) const {
+    return entry.level == last_.level && entry.deferred == last_.deferred &&
+           entry.message == last_message_ && entry.tag == last_tag_ && entry.fields == last_fields_;
+}
+
+void RepeatCollapser::remember(const LogEntry& entry) {
+    last_.level = entry.level;
+    last_.timestamp_ms = entry.timestamp_ms;
+    last_.process_id = entry.process_id;
+    last_.thread_id = entry.thread_id;
+    last_.deferred = entry.deferred;
+    last_tag_.assign(entry.tag);
+    last_message_.assign(entry.message);
+    last_fields_.assign(entry.fields);
+}
+
+LogEntry RepeatCollapser::makeMarker() const {
+    return LogEntry::createOwned(last_.level, last_.timestamp_ms, last_.process_id, last_.thread_id,
+                                 last_tag_, std::format("last message repeated {} times", repeats_));
+}
+
+bool RepeatCollapser::collapses(std::string_view tag, const speckit::log::TagFilter& filter) {
+    if (tag != cached_tag_ || filter.generation() != cached_generation_) {
+        cached_tag_.assign(tag);
+        cached_generation_ = filter.generation();
+        cached_collapses_ = filter.isTagCollapsingRepeats(tag);
+    }
+    return cached_collapses_;
+}
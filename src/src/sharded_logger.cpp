@@ -0,0 +1,163 @@
+// Sharded multi-writer logger implementation
+
+#include "speckit/log/sharded_logger.h"
+#include "speckit/log/platform.h"
+#include <atomic>
+#include <format>
+
+#if defined(__linux__)
+#include <sched.h>
+#endif
+
+namespace {
+
+/// Process-wide ordinal of the calling thread, assigned on first use
+size_t threadOrdinal() {
+    static std::atomic<size_t> next{0};
+    thread_local size_t ordinal = next.fetch_add(1, std::memory_order_relaxed);
+    return ordinal;
+}
+
+/// CPU the calling thread is running on, or -1 if the platform cannot tell
+int currentCpu() {
+#if defined(SPECKIT_PLATFORM_WINDOWS)
+    return static_cast<int>(GetCurrentProcessorNumber());
+#elif defined(__linux__)
+    return sched_getcpu();
+#else
+    return -1;
+#endif
+}
+
+}  // namespace
+
+std::unique_ptr<ShardedLogger> ShardedLogger::create(const std::string& base_name,
+                                                     size_t shard_count,
+                                                     size_t queue_size,
+                                                     ShardMapping mapping) {
+    if (shard_count == 0) {
+        return nullptr;
+    }
+
+    std::vector<std::unique_ptr<AsyncLogger>> shards;
+    shards.reserve(shard_count);
+    for (size_t i = 0; i < shard_count; ++i) {
+        auto shard = AsyncLogger::create(std::format("{}.shard{}", base_name, i), queue_size);
+        if (!shard) {
+            return nullptr;  // Already created shards drain and stop on destruction
+        }
+        shards.push_back(std::move(shard));
+    }
+    return std::unique_ptr<ShardedLogger>(new ShardedLogger(std::move(shards), mapping));
+}
+
+ShardedLogger::ShardedLogger(std::vector<std::unique_ptr<AsyncLogger>> shards, ShardMapping mapping)
+    : shards_(std::move(shards)), mapping_(mapping) {
+}
+
+AsyncLogger& ShardedLogger::currentShard() {
+    if (mapping_ == ShardMapping::kCpu) {
+        int cpu = currentCpu();
+        if (cpu >= 0) {
+            return *shards_[static_cast<size_t>(cpu) % shards_.size()];
+        }
+    }
+    return *shards_[threadOrdinal() % shards_.size()];
+}
+
+void ShardedLogger::log(LogLevel level, std::string_view tag, std::string_view message,
+                        std::source_location site) {
+    currentShard().log(level, tag, message, site);
+}
+
+void ShardedLogger::log(LogLevel level, std::string_view tag, std::string_view message,
+                        std::initializer_list<LogField> fields, std::source_location site) {
+    currentShard().log(level, tag, message, fields, site);
+}
+
+bool ShardedLogger::vlogf(LogLevel level, std::string_view tag, const char* format, va_list args,
+                          std::source_location site) {
+    return currentShard().vlogf(level, tag, format, args, site);
+}
+
+void ShardedLogger::setLogLevel(LogLevel level) {
+    for (auto& shard : shards_) {
+        shard->setLogLevel(level);
+    }
+}
+
+LogLevel ShardedLogger::getLogLevel() const {
+    return shards_.front()->getLogLevel();
+}
+
+void ShardedLogger::setWaitStrategy(WaitStrategy strategy) {
+    for (auto& shard : shards_) {
+        shard->setWaitStrategy(strategy);
+    }
+}
+
+void ShardedLogger::setOverflowPolicy(const OverflowPolicy& policy) {
+    for (auto& shard : shards_) {
+        shard->setOverflowPolicy(policy);
+    }
+}
+
+void ShardedLogger::setLineFormatter(FormatPipeline::EntryFormatter formatter) {
+    for (auto& shard : shards_) {
+        shard->setLineFormatter(formatter);
+    }
+}
+
+void ShardedLogger::setTagFilter(const speckit::log::TagFilter* filter) {
+    for (auto& shard : shards_) {
+        shard->setTagFilter(filter);
+    }
+}
+
+void ShardedLogger::flush() {
+    for (auto& shard : shards_) {
+        shard->flush();
+    }
+}
+
+void ShardedLogger::deinitialize() {
+    for (auto& shard : shards_) {
+        shard->deinitialize();
+    }
+}
+
+size_t ShardedLogger::shardCount() const {
+    return shards_.size();
+}
+
+size_t ShardedLogger::crashReplayShardCount() const {
+    size_t count = 0;
+    for (const auto& shard : shards_) {
+        if (shard->hasCrashReplay()) {
+            ++count;
+        }
+    }
+    return count;
+}
+
+AsyncLogger& ShardedLogger::shard(size_t index) {
+    return *shards_.at(index);
+}
+
+std::vector<std::string> ShardedLogger::getLogFileNames() const {
+    std::vector<std::string> names;
+    names.reserve(shards_.size());
+    for (const auto& shard : shards_) {
+        names.push_back(shard->getLogFileName());
+    }
+    return names;
+}
+
+std::vector<MetricsSnapshot> ShardedLogger::getShardMetrics() const {
+    std::vector<MetricsSnapshot> metrics;
+    metrics.reserve(shards_.size());
+    for (const auto& shard : shards_) {
+        metrics.push_back(shard->getMetrics());
+    }
+    return metrics;
+}
@@ -0,0 +1,175 @@
+// Sink fan-out implementation
+
+#include "speckit/log/sink_fanout.h"
+
+namespace {
+
+/// Sink threads detached by destroyed fan-outs
+std::atomic<uint64_t> g_abandoned_sinks{0};
+
+}  // namespace
+
+SinkFanout::SinkFanout(std::chrono::milliseconds stop_timeout)
+    : pool_(std::make_shared<BatchPool>()), shared_(std::make_shared<Shared>()), stop_timeout_(stop_timeout) {
+    shared_->ring.resize(kRingBatches);
+}
+
+SinkFanout::~SinkFanout() {
+    const auto deadline = std::chrono::steady_clock::now() + stop_timeout_;
+    std::vector<bool> exited;
+    {
+        std::unique_lock<std::mutex> lock(shared_->mutex);
+        shared_->stopping = true;
+        shared_->published_cv.notify_all();
+        shared_->idle_cv.wait_until(lock, deadline, [this]() {
+            for (const auto& worker : shared_->workers) {
+                if (!worker->exited) {
+                    return false;
+                }
+            }
+            return true;
+        });
+        for (const auto& worker : shared_->workers) {
+            exited.push_back(worker->exited);
+        }
+    }
+
+    // A sink still inside write() keeps the shared state alive until it returns
+    for (size_t i = 0; i < exited.size(); ++i) {
+        if (exited[i]) {
+            shared_->workers[i]->thread.join();
+        } else {
+            shared_->workers[i]->thread.detach();
+            g_abandoned_sinks.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+}
+
+void SinkFanout::addSink(std::shared_ptr<LogSink> sink) {
+    if (!sink) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(shared_->mutex);
+    auto worker = std::make_unique<Worker>();
+    worker->sink = std::move(sink);
+    worker->cursor = shared_->published;
+    worker->completed = shared_->published;
+    Worker* started = worker.get();
+    shared_->workers.push_back(std::move(worker));
+    started->thread = std::thread([shared = shared_, started]() { sinkThread(shared, *started); });
+    has_sinks_.store(true, std::memory_order_release);
+}
+
+bool SinkFanout::hasSinks() const {
+    return has_sinks_.load(std::memory_order_acquire);
+}
+
+std::shared_ptr<SinkBatch> SinkFanout::acquireBatch() {
+    std::unique_ptr<SinkBatch> batch;
+    {
+        std::lock_guard<std::mutex> lock(pool_->mutex);
+        if (!pool_->free.empty()) {
+            batch = std::move(pool_->free.back());
+            pool_->free.pop_back();
+        } else {
+            ++pool_->allocated;
+        }
+    }
+    if (!batch) {
+        batch = std::make_unique<SinkBatch>();
+    }
+    batch->text.clear();
+    batch->lines.clear();
+
+    // The last reference returns the batch, buffers and all, to the pool
+    return std::shared_ptr<SinkBatch>(batch.release(), [pool = pool_](SinkBatch* released) {
+        std::lock_guard<std::mutex> lock(pool->mutex);
+        pool->free.emplace_back(released);
+    });
+}
+
+void SinkFanout::publish(std::shared_ptr<SinkBatch> batch) {
+    std::shared_ptr<const SinkBatch> overwritten;
+    {
+        std::lock_guard<std::mutex> lock(shared_->mutex);
+        std::shared_ptr<const SinkBatch>& slot = shared_->ring[shared_->published % kRingBatches];
+        overwritten = std::move(slot);
+        slot = std::move(batch);
+        ++shared_->published;
+    }
+    shared_->published_cv.notify_all();
+    // overwritten is released here, outside the lock
+}
+
+bool SinkFanout::waitIdle(std::chrono::milliseconds timeout) {
+    std::unique_lock<std::mutex> lock(shared_->mutex);
+    const uint64_t target = shared_->published;
+    const bool idle = shared_->idle_cv.wait_for(lock, timeout, [this, target]() {
+        for (const auto& worker : shared_->workers) {
+            if (worker->completed < target) {
+                return false;
+            }
+        }
+        return true;
+    });
+    if (!idle) {
+        for (const auto& worker : shared_->workers) {
+            if (worker->completed < target) {
+                ++worker->stats.wait_timeouts;
+            }
+        }
+    }
+    return idle;
+}
+
+std::vector<SinkStats> SinkFanout::getStats() const {
+    std::lock_guard<std::mutex> lock(shared_->mutex);
+    std::vector<SinkStats> stats;
+    stats.reserve(shared_->workers.size());
+    for (const auto& worker : shared_->workers) {
+        stats.push_back(worker->stats);
+    }
+    return stats;
+}
+
+size_t SinkFanout::getBatchesAllocated() const {
+    std::lock_guard<std::mutex> lock(pool_->mutex);
+    return pool_->allocated;
+}
+
+uint64_t SinkFanout::getAbandonedSinks() {
+    return g_abandoned_sinks.load(std::memory_order_relaxed);
+}
+
+void SinkFanout::sinkThread(const std::shared_ptr<Shared>& shared, Worker& worker) {
+    std::unique_lock<std::mutex> lock(shared->mutex);
+    while (true) {
+        shared->published_cv.wait(lock, [&shared, &worker]() {
+            return shared->stopping || worker.cursor < shared->published;
+        });
+        if (worker.cursor == shared->published) {
+            // Stopping and everything is written
+            worker.exited = true;
+            shared->idle_cv.notify_all();
+            return;
+        }
+
+        // Lapped: the oldest batch still in the ring is where this sink continues
+        if (shared->published - worker.cursor > kRingBatches) {
+            const uint64_t oldest = shared->published - kRingBatches;
+            worker.stats.batches_skipped += oldest - worker.cursor;
+            worker.cursor = oldest;
+        }
+        std::shared_ptr<const SinkBatch> batch = shared->ring[worker.cursor % kRingBatches];
+        ++worker.cursor;
+
+        lock.unlock();
+        worker.sink->write(*batch);
+        batch.reset();
+        lock.lock();
+
+        ++worker.stats.batches_written;
+        worker.completed = worker.cursor;
+        shared->idle_cv.notify_all();
+    }
+}
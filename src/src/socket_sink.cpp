@@ -0,0 +1,284 @@
+// Batched stream socket sink implementation
+
+#include "speckit/log/socket_sink.h"
+#include <algorithm>
+#include <cstring>
+
+#ifndef SPECKIT_PLATFORM_WINDOWS
+#include <arpa/inet.h>
+#include <cerrno>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+#ifndef SPECKIT_PLATFORM_WINDOWS
+
+namespace {
+
+// Linux has no SO_NOSIGPIPE; a closed peer must not raise SIGPIPE either way
+#ifdef MSG_NOSIGNAL
+constexpr int kSendFlags = MSG_NOSIGNAL;
+#else
+constexpr int kSendFlags = 0;
+#endif
+
+// frame_bytes and record_count
+constexpr size_t kFrameHeaderBytes = 2 * sizeof(uint32_t);
+
+}  // namespace
+
+std::shared_ptr<SocketSink> SocketSink::createUnix(const std::string& socket_path,
+                                                   const SocketSinkOptions& options, LogLevel min_level) {
+    sockaddr_un address{};
+    if (socket_path.empty() || socket_path.size() >= sizeof(address.sun_path)) {
+        return nullptr;
+    }
+    address.sun_family = AF_UNIX;
+    std::memcpy(address.sun_path, socket_path.data(), socket_path.size());
+
+    auto sink = std::shared_ptr<SocketSink>(new SocketSink(options, min_level));
+    std::memcpy(&sink->address_, &address, sizeof(address));
+    sink->address_length_ = sizeof(address);
+    return sink->openSpill() ? sink : nullptr;
+}
+
+std::shared_ptr<SocketSink> SocketSink::createTcp(const std::string& address, uint16_t port,
+                                                  const SocketSinkOptions& options, LogLevel min_level) {
+    sockaddr_in ipv4{};
+    ipv4.sin_family = AF_INET;
+    ipv4.sin_port = htons(port);
+    if (::inet_pton(AF_INET, address.c_str(), &ipv4.sin_addr) != 1) {
+        return nullptr;
+    }
+
+    auto sink = std::shared_ptr<SocketSink>(new SocketSink(options, min_level));
+    std::memcpy(&sink->address_, &ipv4, sizeof(ipv4));
+    sink->address_length_ = sizeof(ipv4);
+    return sink->openSpill() ? sink : nullptr;
+}
+
+SocketSink::SocketSink(const SocketSinkOptions& options, LogLevel min_level)
+    : LogSink(min_level), options_(options) {
+    // Reserved up front: iov_ points into prefixes_
+    prefixes_.reserve(kMaxFrameRecords);
+    iov_.reserve(1 + 2 * kMaxFrameRecords);
+    send_iov_.reserve(1 + 2 * kMaxFrameRecords);
+}
+
+SocketSink::~SocketSink() {
+    disconnect();
+    if (spill_fd_ >= 0) {
+        ::close(spill_fd_);
+    }
+}
+
+bool SocketSink::openSpill() {
+    if (options_.spill_path.empty()) {
+        return true;
+    }
+    // Starts empty: a frame cut short by a crash would corrupt everything after it
+    spill_fd_ = ::open(options_.spill_path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_APPEND | O_CLOEXEC, 0644);
+    return spill_fd_ >= 0;
+}
+
+bool SocketSink::ensureConnected() {
+    if (socket_fd_ >= 0) {
+        return true;
+    }
+    if (std::chrono::steady_clock::now() < next_attempt_) {
+        return false;
+    }
+
+    const int fd = ::socket(address_.ss_family, SOCK_STREAM, 0);
+    if (fd >= 0) {
+        ::fcntl(fd, F_SETFD, FD_CLOEXEC);
+#ifdef SO_NOSIGPIPE
+        const int on = 1;
+        ::setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &on, sizeof(on));
+#endif
+        timeval timeout{};
+        timeout.tv_sec = static_cast<time_t>(options_.send_timeout.count() / 1000);
+        timeout.tv_usec = static_cast<suseconds_t>(options_.send_timeout.count() % 1000 * 1000);
+        ::setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+
+        if (::connect(fd, reinterpret_cast<const sockaddr*>(&address_), address_length_) == 0) {
+            socket_fd_ = fd;
+            backoff_ = std::chrono::milliseconds(0);
+            connects_.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+        ::close(fd);
+    }
+
+    connect_failures_.fetch_add(1, std::memory_order_relaxed);
+    backOff();
+    return false;
+}
+
+void SocketSink::backOff() {
+    backoff_ = backoff_.count() == 0 ? options_.initial_backoff
+                                     : std::min(backoff_ * 2, options_.max_backoff);
+    next_attempt_ = std::chrono::steady_clock::now() + backoff_;
+}
+
+void SocketSink::disconnect() {
+    if (socket_fd_ >= 0) {
+        ::close(socket_fd_);
+        socket_fd_ = -1;
+    }
+}
+
+bool SocketSink::sendAll(iovec* iov, size_t count) {
+    while (count > 0) {
+        msghdr message{};
+        message.msg_iov = iov;
+        message.msg_iovlen = static_cast<decltype(message.msg_iovlen)>(count);
+        ssize_t sent = ::sendmsg(socket_fd_, &message, kSendFlags);
+        if (sent < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;  // Peer gone, or stalled past send_timeout
+        }
+        while (count > 0 && static_cast<size_t>(sent) >= iov->iov_len) {
+            sent -= static_cast<ssize_t>(iov->iov_len);
+            ++iov;
+            --count;
+        }
+        if (count > 0) {
+            iov->iov_base = static_cast<char*>(iov->iov_base) + sent;
+            iov->iov_len -= static_cast<size_t>(sent);
+        }
+    }
+    return true;
+}
+
+void SocketSink::write(const SinkBatch& batch) {
+    size_t records = 0;
+    iov_.clear();
+    prefixes_.clear();
+    iov_.push_back(iovec{header_, sizeof(header_)});
+
+    forEachLine(batch, [&](std::string_view line, LogLevel) {
+        if (!line.empty() && line.back() == '\n') {
+            line.remove_suffix(1);
+        }
+        prefixes_.push_back(htonl(static_cast<uint32_t>(line.size())));
+        iov_.push_back(iovec{&prefixes_.back(), sizeof(uint32_t)});
+        iov_.push_back(iovec{const_cast<char*>(line.data()), line.size()});
+        if (++records == kMaxFrameRecords) {
+            deliver(records);
+            records = 0;
+            iov_.resize(1);
+            prefixes_.clear();
+        }
+    });
+    if (records > 0) {
+        deliver(records);
+    }
+}
+
+void SocketSink::deliver(size_t records) {
+    size_t frame_bytes = kFrameHeaderBytes;
+    for (size_t i = 1; i < iov_.size(); ++i) {
+        frame_bytes += iov_[i].iov_len;
+    }
+    header_[0] = htonl(static_cast<uint32_t>(frame_bytes - sizeof(uint32_t)));
+    header_[1] = htonl(static_cast<uint32_t>(records));
+
+    if (ensureConnected() && replaySpill()) {
+        // sendAll() advances the iovecs it is given; iov_ stays intact for the spill
+        send_iov_.assign(iov_.begin(), iov_.end());
+        if (sendAll(send_iov_.data(), send_iov_.size())) {
+            frames_sent_.fetch_add(1, std::memory_order_relaxed);
+            records_sent_.fetch_add(records, std::memory_order_relaxed);
+            return;
+        }
+        disconnect();
+        backOff();
+    }
+
+    if (spill_fd_ < 0 || spill_end_ + frame_bytes > options_.max_spill_bytes) {
+        frames_dropped_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    const ssize_t written = ::writev(spill_fd_, iov_.data(), static_cast<int>(iov_.size()));
+    if (written != static_cast<ssize_t>(frame_bytes)) {
+        // Keep the file a whole number of frames, or stop spilling if that fails
+        if (::ftruncate(spill_fd_, static_cast<off_t>(spill_end_)) != 0) {
+            ::close(spill_fd_);
+            spill_fd_ = -1;
+        }
+        frames_dropped_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    spill_end_ += frame_bytes;
+    frames_spilled_.fetch_add(1, std::memory_order_relaxed);
+}
+
+bool SocketSink::replaySpill() {
+    if (spill_fd_ < 0 || spill_read_offset_ == spill_end_) {
+        return true;
+    }
+    while (spill_read_offset_ < spill_end_) {
+        uint32_t header[2];
+        if (::pread(spill_fd_, header, sizeof(header), static_cast<off_t>(spill_read_offset_)) !=
+            static_cast<ssize_t>(sizeof(header))) {
+            break;  // Unreadable: give up on the rest rather than send garbage
+        }
+        const size_t frame_bytes = sizeof(uint32_t) + ntohl(header[0]);
+        replay_buffer_.resize(frame_bytes);
+        if (::pread(spill_fd_, replay_buffer_.data(), frame_bytes, static_cast<off_t>(spill_read_offset_)) !=
+            static_cast<ssize_t>(frame_bytes)) {
+            break;
+        }
+        iovec frame{replay_buffer_.data(), frame_bytes};
+        if (!sendAll(&frame, 1)) {
+            disconnect();
+            backOff();
+            return false;
+        }
+        frames_sent_.fetch_add(1, std::memory_order_relaxed);
+        records_sent_.fetch_add(ntohl(header[1]), std::memory_order_relaxed);
+        spill_read_offset_ += frame_bytes;
+    }
+
+    // Everything is out; appends start over at the beginning
+    if (::ftruncate(spill_fd_, 0) == 0) {
+        spill_read_offset_ = spill_end_ = 0;
+    }
+    return true;
+}
+
+#else  // SPECKIT_PLATFORM_WINDOWS
+
+std::shared_ptr<SocketSink> SocketSink::createUnix(const std::string&, const SocketSinkOptions&, LogLevel) {
+    return nullptr;
+}
+
+std::shared_ptr<SocketSink> SocketSink::createTcp(const std::string&, uint16_t, const SocketSinkOptions&,
+                                                  LogLevel) {
+    return nullptr;
+}
+
+SocketSink::SocketSink(const SocketSinkOptions& options, LogLevel min_level)
+    : LogSink(min_level), options_(options) {}
+
+SocketSink::~SocketSink() = default;
+
+void SocketSink::write(const SinkBatch&) {}
+
+#endif
+
+SocketSinkStats SocketSink::getStats() const {
+    SocketSinkStats stats;
+    stats.frames_sent = frames_sent_.load(std::memory_order_relaxed);
+    stats.records_sent = records_sent_.load(std::memory_order_relaxed);
+    stats.frames_spilled = frames_spilled_.load(std::memory_order_relaxed);
+    stats.frames_dropped = frames_dropped_.load(std::memory_order_relaxed);
+    stats.connects = connects_.load(std::memory_order_relaxed);
+    stats.connect_failures = connect_failures_.load(std::memory_order_relaxed);
+    return stats;
+}
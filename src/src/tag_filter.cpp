@@ -1,15 +1,57 @@
 #include "../include/speckit/log/tag_filter.h"
+#include <chrono>
 
 using namespace speckit::log;
 
-TagFilter::TagFilter() {}
+namespace {
+
+/// Per-thread sampling state: xorshift64 generator and the last tag looked up
+/// Generations are unique across filters, so a filter built at a destroyed one's
+/// address never matches the cached entry.
+struct SampleCache {
+    uint64_t rng = 0;
+    const TagFilter* filter = nullptr;
+    uint32_t generation = 0;
+    std::string tag;
+    uint32_t one_in_n = 1;
+};
+
+thread_local SampleCache t_sample;
+
+/// Generations come from one process-wide counter, so two filters (or a filter built
+/// where a destroyed one lived) never share one and cached lookups cannot go stale
+std::atomic<uint32_t> g_next_generation{1};
+
+uint32_t nextGeneration() {
+    return g_next_generation.fetch_add(1, std::memory_order_relaxed);
+}
+
+uint64_t nextRandom(SampleCache& cache) {
+    if (cache.rng == 0) {
+        // Distinct per thread: the state's address mixed with the clock
+        cache.rng = (reinterpret_cast<uintptr_t>(&cache) ^
+                     static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count())) |
+                    1;
+    }
+    cache.rng ^= cache.rng << 13;
+    cache.rng ^= cache.rng >> 7;
+    cache.rng ^= cache.rng << 17;
+    return cache.rng;
+}
+
+}  // namespace
+
+TagFilter::TagFilter() : generation_(nextGeneration()) {}
 
 void TagFilter::setTagEnabled(const std::string& tag, bool enabled) {
     std::lock_guard<std::mutex> lock(mutex_);
     enabled_[tag] = enabled;
+    has_rules_.store(true, std::memory_order_release);
+    generation_.store(nextGeneration(), std::memory_order_release);
 }
 
-bool TagFilter::isTagEnabled(const std::string& tag) const {
+bool TagFilter::isTagEnabled(std::string_view tag) const {
+    if (!has_rules_.load(std::memory_order_acquire)) return true;
     std::lock_guard<std::mutex> lock(mutex_);
     auto it = enabled_.find(tag);
     if (it == enabled_.end()) return true; // default enabled
@@ -19,11 +61,79 @@ bool TagFilter::isTagEnabled(const std::string& tag) const {
 void TagFilter::setTagLevel(const std::string& tag, LogLevel level) {
     std::lock_guard<std::mutex> lock(mutex_);
     levels_[tag] = level;
+    has_rules_.store(true, std::memory_order_release);
+    generation_.store(nextGeneration(), std::memory_order_release);
 }
 
-LogLevel TagFilter::getTagLevel(const std::string& tag) const {
+LogLevel TagFilter::getTagLevel(std::string_view tag) const {
+    if (!has_rules_.load(std::memory_order_acquire)) return LogLevel::kLogLevelDebug;
     std::lock_guard<std::mutex> lock(mutex_);
     auto it = levels_.find(tag);
     if (it == levels_.end()) return LogLevel::kLogLevelDebug;
     return it->second;
 }
+
+void TagFilter::setTagRateLimit(const std::string& tag, RateLimit limit) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    rate_limits_[tag] = limit;
+    has_rate_limits_.store(true, std::memory_order_release);
+    generation_.store(nextGeneration(), std::memory_order_release);
+}
+
+RateLimit TagFilter::getTagRateLimit(std::string_view tag) const {
+    if (!has_rate_limits_.load(std::memory_order_acquire)) return RateLimit{};
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = rate_limits_.find(tag);
+    if (it == rate_limits_.end()) return RateLimit{}; // default unlimited
+    return it->second;
+}
+
+void TagFilter::setTagCollapseRepeats(const std::string& tag, bool collapse) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    collapse_[tag] = collapse;
+    has_collapse_rules_.store(true, std::memory_order_release);
+    generation_.store(nextGeneration(), std::memory_order_release);
+}
+
+void TagFilter::setTagSampleRate(const std::string& tag, uint32_t one_in_n) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    sample_rates_[tag] = one_in_n;
+    has_sampling_.store(true, std::memory_order_release);
+    generation_.store(nextGeneration(), std::memory_order_release);
+}
+
+uint32_t TagFilter::getTagSampleRate(std::string_view tag) const {
+    if (!has_sampling_.load(std::memory_order_acquire)) return 1;
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = sample_rates_.find(tag);
+    if (it == sample_rates_.end() || it->second == 0) return 1; // default keep all
+    return it->second;
+}
+
+bool TagFilter::sample(std::string_view tag, LogLevel level) const {
+    if (level >= LogLevel::kLogLevelWarning || !has_sampling_.load(std::memory_order_relaxed)) {
+        return true;
+    }
+
+    SampleCache& cache = t_sample;
+    const uint32_t generation = generation_.load(std::memory_order_acquire);
+    if (cache.filter != this || cache.generation != generation || cache.tag != tag) {
+        cache.filter = this;
+        cache.generation = generation;
+        cache.tag.assign(tag);
+        cache.one_in_n = getTagSampleRate(tag);
+    }
+    if (cache.one_in_n <= 1) {
+        return true;
+    }
+    // Multiply-shift maps the top 32 random bits onto [0, one_in_n) without a division
+    return ((nextRandom(cache) >> 32) * cache.one_in_n >> 32) == 0;
+}
+
+bool TagFilter::isTagCollapsingRepeats(std::string_view tag) const {
+    if (!has_collapse_rules_.load(std::memory_order_acquire)) return false;
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = collapse_.find(tag);
+    if (it == collapse_.end()) return false; // default off
+    return it->second;
+}
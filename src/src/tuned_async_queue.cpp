@@ -0,0 +1,113 @@
+#include "speckit/log/tuned_async_queue.h"
+#include "speckit/log/wait_strategy.h"
+#include <bit>
+#include <cassert>
+#include <thread>
+
+namespace {
+
+/// Spins before falling back to yield(); covers a producer between ticket and publish
+constexpr int kSpinsBeforeYield = 64;
+
+}  // namespace
+
+TunedAsyncQueue::TunedAsyncQueue(size_t capacity)
+    : buffer_(nullptr),
+      capacity_(std::bit_ceil(capacity > 0 ? capacity : size_t{1})),
+      mask_(capacity_ - 1) {
+    assert(capacity > 0);
+    buffer_ = std::make_unique<Cell[]>(capacity_);
+
+    // Initialize per-slot sequence numbers to their index
+    for (size_t i = 0; i < capacity_; ++i) {
+        buffer_[i].seq.store(i, std::memory_order_relaxed);
+    }
+}
+
+void TunedAsyncQueue::waitForSeq(const Cell& cell, size_t expected) {
+    int spins = 0;
+    while (cell.seq.load(std::memory_order_acquire) != expected) {
+        if (spins < kSpinsBeforeYield) {
+            ++spins;
+            speckit::log::cpuRelax();
+        } else {
+            std::this_thread::yield();
+        }
+    }
+}
+
+bool TunedAsyncQueue::tryPush(LogEntry& entry) {
+    size_t ticket = tail_.load(std::memory_order_relaxed);
+    Cell* cell;
+    while (true) {
+        cell = &buffer_[ticket & mask_];
+        const size_t seq = cell->seq.load(std::memory_order_acquire);
+        const auto lag = static_cast<std::ptrdiff_t>(seq - ticket);
+        if (lag == 0) {
+            // Cell is free for this ticket; claim it
+            if (tail_.compare_exchange_weak(ticket, ticket + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (lag < 0) {
+            // Still holds the entry from one lap ago: full
+            return false;
+        } else {
+            // Another producer took this ticket
+            ticket = tail_.load(std::memory_order_relaxed);
+        }
+    }
+
+    cell->storage.emplace(std::move(entry));
+
+    // Publish slot as ready: seq = ticket + 1
+    cell->seq.store(ticket + 1, std::memory_order_release);
+    return true;
+}
+
+bool TunedAsyncQueue::tryPush(LogEntry&& entry) {
+    return tryPush(static_cast<LogEntry&>(entry));
+}
+
+bool TunedAsyncQueue::tryPopOldest(LogEntry& out) {
+    size_t head = head_.load(std::memory_order_acquire);
+    do {
+        if (tail_.load(std::memory_order_acquire) == head) {
+            return false;
+        }
+    } while (!head_.compare_exchange_weak(head, head + 1, std::memory_order_acq_rel,
+                                          std::memory_order_acquire));
+
+    Cell& cell = buffer_[head & mask_];
+    waitForSeq(cell, head + 1);
+    out = std::move(*cell.storage);
+    cell.storage.reset();
+    cell.seq.store(head + capacity_, std::memory_order_release);
+    return true;
+}
+
+std::vector<LogEntry> TunedAsyncQueue::popAll() {
+    std::vector<LogEntry> result;
+    result.reserve(size());
+    drain([&result](LogEntry& entry) { result.push_back(std::move(entry)); });
+    return result;
+}
+
+size_t TunedAsyncQueue::drainInto(std::span<LogEntry> out) {
+    size_t count = 0;
+    return drain([&out, &count](LogEntry& entry) { out[count++] = std::move(entry); }, out.size());
+}
+
+bool TunedAsyncQueue::isEmpty() const {
+    return size() == 0;
+}
+
+size_t TunedAsyncQueue::size() const {
+    // Load head first so a concurrent pop can only make the result larger, never wrap
+    const size_t head = head_.load(std::memory_order_acquire);
+    const size_t tail = tail_.load(std::memory_order_acquire);
+    return tail - head;
+}
+
+size_t TunedAsyncQueue::capacity() const {
+    return capacity_;
+}
@@ -0,0 +1,282 @@
+// Load generator for performance tests
+// Drives an AsyncLogger from N producer threads and records latency percentiles
+
+#pragma once
+
+#include "speckit/log/async_logger.h"
+#include "speckit/log/metrics.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace perf {
+
+/// Load shape for one run
+struct LoadConfig {
+    int producers = 1;                      ///< Number of producer threads
+    uint64_t messages_per_producer = 10000; ///< Messages each producer sends
+    double rate_per_producer = 0.0;         ///< Messages/second per producer; 0 = closed loop (flat out)
+    size_t message_size = 64;               ///< Bytes per message, including the sequence prefix
+    bool end_to_end = true;                 ///< Tail the log file and measure enqueue-to-disk latency
+    std::chrono::seconds drain_timeout{30}; ///< Upper bound for waiting on the file after producers finish
+};
+
+/// Outcome of one run
+struct LoadResult {
+    HistogramSummary call_ns;        ///< Latency of log() as seen by the producer
+    HistogramSummary response_ns;    ///< Open loop: intended send time to log() returning
+    HistogramSummary end_to_end_ns;  ///< Enqueue to readable in the log file
+    uint64_t sent = 0;               ///< log() calls made
+    uint64_t dropped = 0;            ///< Entries the logger reported as dropped
+    uint64_t received = 0;           ///< Distinct sequence numbers found in the file
+    uint64_t duplicates = 0;         ///< Sequence numbers found more than once
+    double elapsed_s = 0.0;          ///< Wall time from first send to last send
+    double throughput = 0.0;         ///< Sent messages per second
+};
+
+/// Runs producers against a logger and measures per-call and end-to-end latency.
+///
+/// Every message starts with "seq=<n> " where n is unique for the run. Producers
+/// record the enqueue time per sequence number; a tailer thread reads the log file
+/// as it grows and records the time each sequence number becomes visible. It
+/// follows the logger across rotations.
+///
+/// Open loop (rate_per_producer > 0) schedules each send at a fixed interval and also
+/// measures response time from the intended send time, so stalls are not hidden by the
+/// producer slowing down (coordinated omission). That includes how late the producer
+/// woke up, so call_ns, measured from the actual send, is the one to hold to a bound.
+class LoadGenerator {
+public:
+    LoadGenerator(AsyncLogger& logger, LoadConfig config)
+        : logger_(logger), config_(config) {}
+
+    LoadResult run() {
+        const uint64_t total = static_cast<uint64_t>(config_.producers) * config_.messages_per_producer;
+        enqueue_ns_ = std::make_unique<std::atomic<int64_t>[]>(total);
+        seen_ = std::make_unique<std::atomic<uint8_t>[]>(total);
+        for (uint64_t i = 0; i < total; ++i) {
+            enqueue_ns_[i].store(0, std::memory_order_relaxed);
+            seen_[i].store(0, std::memory_order_relaxed);
+        }
+
+        const uint64_t dropped_before = logger_.getMetrics().entries_dropped;
+
+        std::jthread tailer;
+        if (config_.end_to_end) {
+            // Skip output of earlier runs on the same logger
+            logger_.flush();
+            file_.open(logger_.getLogFileName(), std::ios::binary);
+            file_.seekg(0, std::ios::end);
+            rotations_seen_ = logger_.getMetrics().rotations;
+            tailer = std::jthread([this, total](std::stop_token st) { tail(st, total); });
+        }
+
+        std::atomic<int> ready{0};
+        std::atomic<bool> go{false};
+        std::vector<std::thread> producers;
+        for (int p = 0; p < config_.producers; ++p) {
+            producers.emplace_back([&, p]() {
+                ready.fetch_add(1);
+                while (!go.load(std::memory_order_acquire)) {
+                    std::this_thread::yield();
+                }
+                produce(static_cast<uint64_t>(p));
+            });
+        }
+        while (ready.load() != config_.producers) {
+            std::this_thread::yield();
+        }
+
+        const auto start = Clock::now();
+        go.store(true, std::memory_order_release);
+        for (auto& producer : producers) {
+            producer.join();
+        }
+        const auto end = Clock::now();
+
+        logger_.flush();
+
+        LoadResult result;
+        result.sent = total;
+        result.elapsed_s = std::chrono::duration<double>(end - start).count();
+        result.throughput = result.elapsed_s > 0 ? static_cast<double>(total) / result.elapsed_s : 0.0;
+
+        if (config_.end_to_end) {
+            // Wait until every accepted entry is visible, bounded by drain_timeout
+            const auto deadline = Clock::now() + config_.drain_timeout;
+            while (Clock::now() < deadline) {
+                result.dropped = logger_.getMetrics().entries_dropped - dropped_before;
+                if (received_.load() + result.dropped >= total) {
+                    break;
+                }
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+            tailer.request_stop();
+            tailer.join();
+            file_.close();
+        }
+
+        result.dropped = logger_.getMetrics().entries_dropped - dropped_before;
+        result.received = received_.load();
+        result.duplicates = duplicates_.load();
+        result.call_ns = call_latency_.summarize();
+        result.response_ns = response_latency_.summarize();
+        result.end_to_end_ns = end_to_end_.summarize();
+        return result;
+    }
+
+    /// Print a one-run report
+    static void print(const std::string& name, const LoadResult& r) {
+        auto line = [](const char* label, const HistogramSummary& s) {
+            std::cout << "  " << label << " p50=" << s.p50 << " p99=" << s.p99
+                      << " p99.9=" << s.p999 << " max=" << s.max << " ns" << std::endl;
+        };
+        std::cout << name << ": sent=" << r.sent << " received=" << r.received
+                  << " dropped=" << r.dropped << " duplicates=" << r.duplicates
+                  << " throughput=" << static_cast<uint64_t>(r.throughput) << " msg/s" << std::endl;
+        line("call      ", r.call_ns);
+        if (r.response_ns.count > 0) {
+            line("response  ", r.response_ns);
+        }
+        line("end-to-end", r.end_to_end_ns);
+    }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    static int64_t nowNs() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            Clock::now().time_since_epoch()).count();
+    }
+
+    void produce(uint64_t producer) {
+        const uint64_t count = config_.messages_per_producer;
+        const uint64_t first_seq = producer * count;
+        const bool open_loop = config_.rate_per_producer > 0.0;
+        const auto interval = open_loop
+            ? std::chrono::duration_cast<Clock::duration>(
+                  std::chrono::duration<double>(1.0 / config_.rate_per_producer))
+            : Clock::duration::zero();
+
+        std::string message;
+        message.reserve(config_.message_size + 32);
+        const auto start = Clock::now();
+
+        for (uint64_t i = 0; i < count; ++i) {
+            const uint64_t seq = first_seq + i;
+            message = "seq=" + std::to_string(seq) + " ";
+            if (message.size() < config_.message_size) {
+                message.append(config_.message_size - message.size(), 'x');
+            }
+
+            const auto intended = start + interval * static_cast<int64_t>(i);
+            if (open_loop && Clock::now() < intended) {
+                std::this_thread::sleep_until(intended);
+            }
+
+            const auto sent = Clock::now();
+            enqueue_ns_[seq].store(nowNs(), std::memory_order_release);
+            logger_.log(LogLevel::kLogLevelInfo, "Load", message);
+            const auto done = Clock::now();
+            call_latency_.record(static_cast<uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(done - sent).count()));
+            if (open_loop) {
+                response_latency_.record(static_cast<uint64_t>(
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(done - intended).count()));
+            }
+        }
+    }
+
+    /// Follow the log file and match sequence numbers to their enqueue time
+    void tail(std::stop_token st, uint64_t total) {
+        std::string pending;
+        std::vector<char> buffer(64 * 1024);
+
+        while (true) {
+            size_t n = 0;
+            if (file_.is_open()) {
+                file_.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+                n = static_cast<size_t>(file_.gcount());
+                if (file_.eof()) {
+                    file_.clear();  // Keep following the growing file
+                }
+            }
+
+            if (n == 0) {
+                // At the end of a rotated-away file; continue with the new one
+                const uint64_t rotations = logger_.getMetrics().rotations;
+                if (rotations != rotations_seen_) {
+                    rotations_seen_ = rotations;
+                    file_.close();
+                    file_.open(logger_.getLogFileName(), std::ios::binary);
+                    continue;
+                }
+                if (st.stop_requested()) {
+                    break;
+                }
+                std::this_thread::sleep_for(std::chrono::microseconds(200));
+                continue;
+            }
+
+            const int64_t visible_ns = nowNs();
+            pending.append(buffer.data(), n);
+            size_t line_start = 0;
+            size_t newline;
+            while ((newline = pending.find('\n', line_start)) != std::string::npos) {
+                onLine(std::string_view(pending).substr(line_start, newline - line_start),
+                       visible_ns, total);
+                line_start = newline + 1;
+            }
+            pending.erase(0, line_start);
+        }
+    }
+
+    void onLine(std::string_view line, int64_t visible_ns, uint64_t total) {
+        const size_t pos = line.find("seq=");
+        if (pos == std::string_view::npos) {
+            return;
+        }
+        uint64_t seq = 0;
+        size_t i = pos + 4;
+        if (i >= line.size() || line[i] < '0' || line[i] > '9') {
+            return;
+        }
+        for (; i < line.size() && line[i] >= '0' && line[i] <= '9'; ++i) {
+            seq = seq * 10 + static_cast<uint64_t>(line[i] - '0');
+        }
+        if (seq >= total) {
+            return;
+        }
+
+        if (seen_[seq].exchange(1, std::memory_order_relaxed) != 0) {
+            duplicates_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        received_.fetch_add(1, std::memory_order_relaxed);
+
+        const int64_t enqueued = enqueue_ns_[seq].load(std::memory_order_acquire);
+        if (enqueued > 0 && visible_ns >= enqueued) {
+            end_to_end_.record(static_cast<uint64_t>(visible_ns - enqueued));
+        }
+    }
+
+    AsyncLogger& logger_;
+    LoadConfig config_;
+    std::ifstream file_;
+    uint64_t rotations_seen_ = 0;
+    std::unique_ptr<std::atomic<int64_t>[]> enqueue_ns_;
+    std::unique_ptr<std::atomic<uint8_t>[]> seen_;
+    std::atomic<uint64_t> received_{0};
+    std::atomic<uint64_t> duplicates_{0};
+    Histogram call_latency_;
+    Histogram response_latency_;
+    Histogram end_to_end_;
+};
+
+}  // namespace perf
@@ -1,21 +1,19 @@
 // Performance test for log call latency
+// Percentiles come from the load generator's HDR histograms, not single timings
 
 #include <gtest/gtest.h>
 #include "speckit/log/async_logger.h"
 #include "speckit/log/log_level.h"
-#include <chrono>
-#include <vector>
-#include <numeric>
-#include <algorithm>
+#include "load_generator.h"
 #include <filesystem>
+#include <string>
 
 using namespace std::chrono_literals;
 
 class LatencyTest : public ::testing::Test {
 protected:
     void SetUp() override {
-        // Clean up any existing test files
-        std::filesystem::remove_all("latency_test*.log");
+        removeLogFiles();
 
         // Get absolute path for current directory
         std::filesystem::path current_path = std::filesystem::current_path();
@@ -26,115 +24,99 @@ protected:
         ASSERT_NE(logger_, nullptr);
         logger_->setLogLevel(LogLevel::kLogLevelInfo);
     }
-    
+
     void TearDown() override {
-        // Clean up test files
-        std::filesystem::remove_all("latency_test*.log");
-        std::filesystem::remove_all("latency_test*.log.d");  // Remove crash buffer files
+        logger_.reset();
+        removeLogFiles();
+    }
+
+    static void removeLogFiles() {
+        for (const auto& entry : std::filesystem::directory_iterator(std::filesystem::current_path())) {
+            if (entry.path().filename().string().rfind("latency_test", 0) == 0) {
+                std::filesystem::remove_all(entry.path());
+            }
+        }
     }
-    
+
     std::unique_ptr<AsyncLogger> logger_;
 };
 
-TEST_F(LatencyTest, SingleLogCall_LessThan1ms) {
-    // Measure single log call latency
-    auto start = std::chrono::high_resolution_clock::now();
-    logger_->log(LogLevel::kLogLevelInfo, "Test", "Latency test message");
-    auto end = std::chrono::high_resolution_clock::now();
-    
-    auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start);
-    
-    // Verify <1ms requirement (1,000,000 nanoseconds)
-    EXPECT_LT(duration.count(), 1000000);
-    
-    std::cout << "Single log call latency: " << duration.count() << " ns" << std::endl;
+TEST_F(LatencyTest, ClosedLoop_SingleProducer_P99LessThan1ms) {
+    perf::LoadConfig config;
+    config.producers = 1;
+    config.messages_per_producer = 10000;
+
+    auto result = perf::LoadGenerator(*logger_, config).run();
+    perf::LoadGenerator::print("Closed loop, 1 producer", result);
+
+    // Verify <1ms requirement at the tail, not just on average
+    EXPECT_LT(result.call_ns.p99, 1000000u);
+    EXPECT_LT(result.call_ns.p50, 100000u) << "Median latency should be <100µs";
+    EXPECT_EQ(result.received + result.dropped, result.sent);
+    EXPECT_EQ(result.duplicates, 0u);
 }
 
-TEST_F(LatencyTest, MultipleLogCalls_AllLessThan1ms) {
-    const int NUM_CALLS = 1000;
-    std::vector<int64_t> latencies;
-    latencies.reserve(NUM_CALLS);
-    
-    // Measure latency for multiple calls
-    for (int i = 0; i < NUM_CALLS; ++i) {
-        auto start = std::chrono::high_resolution_clock::now();
-        logger_->log(LogLevel::kLogLevelInfo, "Test", "Message " + std::to_string(i));
-        auto end = std::chrono::high_resolution_clock::now();
-        
-        auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start);
-        latencies.push_back(duration.count());
-    }
-    
-    // Calculate statistics
-    int64_t avg = std::accumulate(latencies.begin(), latencies.end(), 0LL) / NUM_CALLS;
-    int64_t max = *std::max_element(latencies.begin(), latencies.end());
-    int64_t min = *std::min_element(latencies.begin(), latencies.end());
-    
-    // Verify all calls are <1ms
-    bool all_under_1ms = std::all_of(latencies.begin(), latencies.end(),
-        [](int64_t latency) { return latency < 1000000; });
-    
-    EXPECT_TRUE(all_under_1ms) << "Not all log calls were <1ms";
-    EXPECT_LT(avg, 100000) << "Average latency should be <100µs";
-    
-    std::cout << "Log call latency statistics:" << std::endl;
-    std::cout << "  Average: " << avg << " ns" << std::endl;
-    std::cout << "  Min: " << min << " ns" << std::endl;
-    std::cout << "  Max: " << max << " ns" << std::endl;
-    std::cout << "  All <1ms: " << (all_under_1ms ? "Yes" : "No") << std::endl;
+TEST_F(LatencyTest, OpenLoop_FixedRate_P99LessThan1ms) {
+    perf::LoadConfig config;
+    config.producers = 4;
+    config.messages_per_producer = 2000;
+    config.rate_per_producer = 10000.0;  // 40k msg/s total
+
+    auto result = perf::LoadGenerator(*logger_, config).run();
+    perf::LoadGenerator::print("Open loop, 4 producers @ 10k/s", result);
+
+    // The call itself is bounded; response time also counts how late the producer woke
+    // up, which is up to the OS scheduler, so it is only reported
+    EXPECT_LT(result.call_ns.p99, 1000000u);
+    EXPECT_EQ(result.response_ns.count, result.sent);
+    EXPECT_LE(result.call_ns.p50, result.response_ns.p50);
+    EXPECT_EQ(result.received + result.dropped, result.sent);
 }
 
-TEST_F(LatencyTest, HighFrequency_Calls_MaintainLowLatency) {
-    const int NUM_CALLS = 10000;
-    std::vector<int64_t> latencies;
-    latencies.reserve(NUM_CALLS);
-    
-    // Measure latency for high-frequency calls
-    for (int i = 0; i < NUM_CALLS; ++i) {
-        auto start = std::chrono::high_resolution_clock::now();
-        logger_->log(LogLevel::kLogLevelInfo, "Test", "Message " + std::to_string(i));
-        auto end = std::chrono::high_resolution_clock::now();
-        
-        auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start);
-        latencies.push_back(duration.count());
+TEST_F(LatencyTest, Contention_ManyProducers_ReportsPercentiles) {
+    for (int producers : {1, 4, 16}) {
+        perf::LoadConfig config;
+        config.producers = producers;
+        config.messages_per_producer = 20000 / static_cast<uint64_t>(producers);
+
+        auto result = perf::LoadGenerator(*logger_, config).run();
+        perf::LoadGenerator::print("Closed loop, " + std::to_string(producers) + " producers", result);
+
+        EXPECT_EQ(result.received + result.dropped, result.sent);
+        EXPECT_LE(result.call_ns.p50, result.call_ns.p99);
+        EXPECT_LE(result.call_ns.p99, result.call_ns.max);
     }
-    
-    // Calculate 95th percentile
-    std::sort(latencies.begin(), latencies.end());
-    size_t p95_index = NUM_CALLS * 95 / 100;
-    int64_t p95 = latencies[p95_index];
-    
-    // Verify 95th percentile is <1ms
-    EXPECT_LT(p95, 1000000) << "95th percentile should be <1ms";
-    
-    std::cout << "High-frequency log call statistics:" << std::endl;
-    std::cout << "  Total calls: " << NUM_CALLS << std::endl;
-    std::cout << "  95th percentile: " << p95 << " ns" << std::endl;
-    std::cout << "  95th percentile <1ms: " << (p95 < 1000000 ? "Yes" : "No") << std::endl;
 }
 
-TEST_F(LatencyTest, LogCall_WithDifferentLevels_AllFast) {
-    std::vector<int64_t> latencies;
-    std::vector<LogLevel> levels = {LogLevel::kLogLevelDebug, LogLevel::kLogLevelInfo, LogLevel::kLogLevelWarning, LogLevel::kLogLevelError};
-    
-    // Measure latency for different log levels
-    for (int i = 0; i < 1000; ++i) {
-        LogLevel level = levels[i % levels.size()];
-        
-        auto start = std::chrono::high_resolution_clock::now();
-        logger_->log(level, "Test", "Message " + std::to_string(i));
-        auto end = std::chrono::high_resolution_clock::now();
-        
-        auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start);
-        latencies.push_back(duration.count());
+TEST_F(LatencyTest, EndToEnd_EveryEntryReachesDisk) {
+    perf::LoadConfig config;
+    config.producers = 2;
+    config.messages_per_producer = 5000;
+    config.rate_per_producer = 20000.0;
+
+    auto result = perf::LoadGenerator(*logger_, config).run();
+    perf::LoadGenerator::print("End-to-end, 2 producers @ 20k/s", result);
+
+    // Below capacity nothing should be dropped, and every sequence number lands once
+    EXPECT_EQ(result.dropped, 0u);
+    EXPECT_EQ(result.received, result.sent);
+    EXPECT_EQ(result.duplicates, 0u);
+    EXPECT_EQ(result.end_to_end_ns.count, result.sent);
+}
+
+TEST_F(LatencyTest, LogCall_WithDifferentLevels_FilteredCallsFast) {
+    // Filtered calls never reach the queue; they should stay in the tens of ns
+    Histogram filtered;
+    for (int i = 0; i < 10000; ++i) {
+        auto start = std::chrono::steady_clock::now();
+        logger_->log(LogLevel::kLogLevelDebug, "Test", "Filtered message");
+        auto end = std::chrono::steady_clock::now();
+        filtered.record(static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count()));
     }
-    
-    // Calculate average
-    int64_t avg = std::accumulate(latencies.begin(), latencies.end(), 0LL) / latencies.size();
-    
-    // Verify all levels are fast
-    EXPECT_LT(avg, 100000) << "Average latency should be <100µs";
-    
-    std::cout << "Log call latency by level:" << std::endl;
-    std::cout << "  Average: " << avg << " ns" << std::endl;
+
+    HistogramSummary summary = filtered.summarize();
+    std::cout << "Filtered log call: p50=" << summary.p50 << " p99=" << summary.p99
+              << " max=" << summary.max << " ns" << std::endl;
+    EXPECT_LT(summary.p99, 100000u);
 }
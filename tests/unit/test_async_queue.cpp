@@ -2,6 +2,7 @@
 
 #include <gtest/gtest.h>
 #include "speckit/log/async_queue.h"
+#include "speckit/log/log_buffer.h"
 #include "speckit/log/log_level.h"
 
 
@@ -160,3 +161,70 @@ TEST_F(AsyncQueueTest, EmptyQueue_PopReturnsEmptyVector) {
     EXPECT_TRUE(entries.empty());
     EXPECT_TRUE(queue.isEmpty());
 }
+
+TEST_F(AsyncQueueTest, Drain_RespectsMaxAndKeepsOrder) {
+    AsyncQueue queue(TEST_CAPACITY);
+    for (int i = 0; i < 10; ++i) {
+        queue.tryPush(LogEntry::createOwned(LogLevel::kLogLevelInfo, 12345, 1234, ThreadIdType{}, "Test", std::to_string(i)));
+    }
+
+    std::vector<std::string> seen;
+    auto collect = [&seen](LogEntry& entry) { seen.emplace_back(entry.message); };
+
+    EXPECT_EQ(queue.drain(collect, 4), 4u);
+    EXPECT_EQ(queue.size(), 6u);
+    EXPECT_EQ(queue.drain(collect), 6u);
+    EXPECT_TRUE(queue.isEmpty());
+    EXPECT_EQ(queue.drain(collect), 0u);
+
+    ASSERT_EQ(seen.size(), 10u);
+    for (int i = 0; i < 10; ++i) {
+        EXPECT_EQ(seen[i], std::to_string(i));
+    }
+}
+
+TEST_F(AsyncQueueTest, DrainInto_FillsReusableBuffer) {
+    AsyncQueue queue(TEST_CAPACITY);
+    std::vector<LogEntry> buffer(4);
+
+    for (int round = 0; round < 3; ++round) {
+        for (int i = 0; i < 6; ++i) {
+            queue.tryPush(LogEntry::createOwned(LogLevel::kLogLevelInfo, 12345, 1234, ThreadIdType{}, "Test", std::to_string(i)));
+        }
+        ASSERT_EQ(queue.drainInto(buffer), 4u);
+        EXPECT_EQ(buffer[0].message, "0");
+        EXPECT_EQ(buffer[3].message, "3");
+
+        ASSERT_EQ(queue.drainInto(buffer), 2u);
+        EXPECT_EQ(buffer[0].message, "4");
+        EXPECT_EQ(buffer[1].message, "5");
+        EXPECT_TRUE(queue.isEmpty());
+    }
+}
+
+TEST(RingBufferTest, Drain_RespectsMaxAndKeepsOrder) {
+    RingBuffer ring(8);
+
+    std::vector<std::string> seen;
+    auto collect = [&seen](LogEntry& entry) { seen.emplace_back(entry.message); };
+
+    // Two laps so the drained range wraps
+    for (int round = 0; round < 2; ++round) {
+        for (int i = 0; i < 6; ++i) {
+            ASSERT_TRUE(ring.tryPush(LogEntry::createOwned(LogLevel::kLogLevelInfo, 12345, 1234, ThreadIdType{}, "Test",
+                                                           std::to_string(round * 6 + i))));
+        }
+        EXPECT_EQ(ring.drain(collect, 5), 5u);
+        EXPECT_EQ(ring.size(), 1u);
+
+        std::vector<LogEntry> buffer(4);
+        ASSERT_EQ(ring.drainInto(buffer), 1u);
+        seen.emplace_back(buffer[0].message);
+        EXPECT_TRUE(ring.isEmpty());
+    }
+
+    ASSERT_EQ(seen.size(), 12u);
+    for (int i = 0; i < 12; ++i) {
+        EXPECT_EQ(seen[i], std::to_string(i));
+    }
+}
@@ -0,0 +1,171 @@
+// Unit tests for the binary log format and binary AsyncLogger output
+
+#include <gtest/gtest.h>
+#include "speckit/log/binary_log_format.h"
+#include "speckit/log/async_logger.h"
+#include "speckit/log/printf_capture.h"
+#include "speckit/log/log_fields.h"
+#include <cstdarg>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+std::string capture(const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    std::string captured;
+    EXPECT_TRUE(speckit::log::capturePrintf(format, args, captured));
+    va_end(args);
+    return captured;
+}
+
+/// Decode @p bytes; stops at the first error
+std::vector<std::string> decodeAll(const std::string& bytes, BinaryLogDecoder::Status* last = nullptr) {
+    std::istringstream in(bytes);
+    BinaryLogDecoder decoder(in);
+    std::vector<std::string> lines;
+    std::string line;
+    BinaryLogDecoder::Status status;
+    while ((status = decoder.next(line)) == BinaryLogDecoder::Status::kLine) {
+        lines.push_back(line);
+    }
+    if (last) {
+        *last = status;
+    }
+    return lines;
+}
+
+/// Header plus encoded entries, and the text formatLogEntry gives for them
+struct EncodedFile {
+    std::string bytes;
+    std::vector<std::string> expected;
+
+    EncodedFile(ProcessIdType pid, const std::vector<const LogEntry*>& entries) {
+        BinaryFileHeader header = BinaryFileHeader::now(pid);
+        header.encode(bytes);
+        BinaryLogEncoder encoder;
+        encoder.reset(header);
+        for (const LogEntry* entry : entries) {
+            encoder.encode(*entry, bytes);
+            expected.push_back(formatLogEntry(*entry));
+        }
+    }
+};
+
+}  // namespace
+
+TEST(BinaryLogFormatTest, RoundTrip_MatchesFormatLogEntry) {
+    const ProcessIdType pid = 4242;
+    const std::string deferred_record = capture("id=%d name=%s", 7, "disk");
+
+    LogEntry first(LogLevel::kLogLevelInfo, 1700000000000, pid, ThreadIdType{}, "Network", "connected");
+    LogEntry same_tag(LogLevel::kLogLevelError, 1700000000005, pid, ThreadIdType{}, "Network", "reset");
+    LogEntry earlier(LogLevel::kLogLevelDebug, 1699999999000, pid, ThreadIdType{}, "UI", "");  // Negative delta
+    LogEntry other_pid(LogLevel::kLogLevelWarning, 1700000001000, pid + 1, ThreadIdType{}, "UI", "forked");
+    LogEntry deferred(LogLevel::kLogLevelInfo, 1700000001001, pid, ThreadIdType{}, "Disk", deferred_record);
+    deferred.deferred = true;
+    LogEntry binary_payload(LogLevel::kLogLevelInfo, 1700000001002, pid, ThreadIdType{}, "Raw",
+                            std::string_view("a\0b\nc", 5));
+    std::string fields;
+    speckit::log::encodeFields({{"user_id", 42}, {"path", "/tmp/x y"}}, fields);
+    LogEntry with_fields = LogEntry::createOwned(LogLevel::kLogLevelInfo, 1700000001003, pid, ThreadIdType{},
+                                                 "Auth", "login", fields);
+
+    EncodedFile file(pid, {&first, &same_tag, &earlier, &other_pid, &deferred, &binary_payload, &with_fields});
+
+    BinaryLogDecoder::Status status;
+    const auto lines = decodeAll(file.bytes, &status);
+    EXPECT_EQ(status, BinaryLogDecoder::Status::kEnd);
+    EXPECT_EQ(lines, file.expected);
+    EXPECT_NE(lines[4].find("id=7 name=disk"), std::string::npos);
+
+    // Repeated tags and threads are sent once
+    size_t text_bytes = 0;
+    for (const auto& line : file.expected) {
+        text_bytes += line.size();
+    }
+    EXPECT_LT(file.bytes.size(), text_bytes);
+}
+
+TEST(BinaryLogFormatTest, AppendedHeader_ResetsPerFileState) {
+    LogEntry a(LogLevel::kLogLevelInfo, 1700000000000, 1, ThreadIdType{}, "A", "first process");
+    LogEntry b(LogLevel::kLogLevelWarning, 1700000000100, 2, ThreadIdType{}, "B", "second process");
+
+    // A second process appending to the file starts over with its own header and ids
+    EncodedFile part1(1, {&a});
+    EncodedFile part2(2, {&b});
+    const auto lines = decodeAll(part1.bytes + part2.bytes);
+    ASSERT_EQ(lines.size(), 2u);
+    EXPECT_EQ(lines[0], part1.expected[0]);
+    EXPECT_EQ(lines[1], part2.expected[0]);
+}
+
+TEST(BinaryLogFormatTest, MalformedInput_ReportsError) {
+    LogEntry entry(LogLevel::kLogLevelInfo, 1700000000000, 1, ThreadIdType{}, "Tag", "message body");
+    EncodedFile file(1, {&entry});
+
+    BinaryLogDecoder::Status status;
+    decodeAll(file.bytes.substr(0, file.bytes.size() - 3), &status);
+    EXPECT_EQ(status, BinaryLogDecoder::Status::kError);
+
+    decodeAll("not a binary log", &status);
+    EXPECT_EQ(status, BinaryLogDecoder::Status::kError);
+
+    decodeAll("", &status);
+    EXPECT_EQ(status, BinaryLogDecoder::Status::kError);
+}
+
+class BinaryLoggerTest : public ::testing::Test {
+protected:
+    std::filesystem::path dir_;
+
+    void SetUp() override {
+        dir_ = std::filesystem::current_path() / "binary_logger_test";
+        std::filesystem::remove_all(dir_);
+        std::filesystem::create_directories(dir_);
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(dir_);
+    }
+};
+
+TEST_F(BinaryLoggerTest, BinaryFile_DecodesToLoggedLines) {
+    auto logger = AsyncLogger::create((dir_ / "bin").string());
+    ASSERT_NE(logger, nullptr);
+    logger->log(LogLevel::kLogLevelInfo, "Text", "before the switch");
+
+    ASSERT_TRUE(logger->setOutputFormat(LogFileFormat::kBinary));
+    EXPECT_EQ(logger->getOutputFormat(), LogFileFormat::kBinary);
+    const std::string file_name = logger->getLogFileName();
+    EXPECT_EQ(std::filesystem::path(file_name).extension(), ".slog");
+
+    constexpr int kEntries = 1000;
+    for (int i = 0; i < kEntries; ++i) {
+        logger->log(i % 10 == 0 ? LogLevel::kLogLevelWarning : LogLevel::kLogLevelInfo,
+                    i % 2 ? "Odd" : "Even", "entry " + std::to_string(i));
+    }
+    logger->deinitialize();
+
+    std::ifstream in(file_name, std::ios::binary);
+    std::stringstream bytes;
+    bytes << in.rdbuf();
+    BinaryLogDecoder::Status status;
+    const auto lines = decodeAll(bytes.str(), &status);
+    EXPECT_EQ(status, BinaryLogDecoder::Status::kEnd);
+    ASSERT_EQ(lines.size(), static_cast<size_t>(kEntries));
+
+    size_t text_bytes = 0;
+    for (int i = 0; i < kEntries; ++i) {
+        const std::string expected = (i % 2 ? "[Odd]: entry " : "[Even]: entry ") + std::to_string(i) + "\n";
+        ASSERT_GE(lines[i].size(), expected.size());
+        EXPECT_EQ(lines[i].substr(lines[i].size() - expected.size()), expected);
+        EXPECT_EQ(lines[i].rfind(i % 10 == 0 ? "[WARNING]" : "[INFO]", 0), 0u) << lines[i];
+        text_bytes += lines[i].size();
+    }
+    EXPECT_LT(bytes.str().size() * 3, text_bytes);  // Well under a third of the text size
+}
@@ -0,0 +1,189 @@
+// Unit tests for ByteRingQueue
+
+#include <gtest/gtest.h>
+#include "speckit/log/byte_ring_queue.h"
+#include "speckit/log/log_level.h"
+#include <atomic>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+std::vector<std::string> drainStrings(ByteRingQueue& queue, size_t max = std::numeric_limits<size_t>::max()) {
+    std::vector<std::string> records;
+    queue.drain([&records](std::string_view record) { records.emplace_back(record); }, max);
+    return records;
+}
+
+}  // namespace
+
+TEST(ByteRingQueueTest, Capacity_IsPowerOfTwoByteBudget) {
+    EXPECT_EQ(ByteRingQueue(1).capacityBytes(), ByteRingQueue::kMinCapacity);
+    EXPECT_EQ(ByteRingQueue(1000).capacityBytes(), 1024u);
+    EXPECT_EQ(ByteRingQueue(4096).capacityBytes(), 4096u);
+    EXPECT_EQ(ByteRingQueue(4096).maxRecordBytes(), 2048u - ByteRingQueue::kHeaderSize);
+
+    ByteRingQueue queue(1024);
+    EXPECT_TRUE(queue.isEmpty());
+    EXPECT_EQ(queue.sizeBytes(), 0u);
+}
+
+TEST(ByteRingQueueTest, VariableLengthRecords_KeepOrderAndContent) {
+    ByteRingQueue queue(1024);
+    ASSERT_TRUE(queue.tryPush("a"));
+    ASSERT_TRUE(queue.tryPush(""));
+    ASSERT_TRUE(queue.tryPush(std::string(300, 'x')));
+    ASSERT_TRUE(queue.tryPush("tail"));
+
+    // Short records only take their own size, not a fixed slot
+    EXPECT_EQ(queue.sizeBytes(), ByteRingQueue::recordBytes(1) + ByteRingQueue::recordBytes(0) +
+                                     ByteRingQueue::recordBytes(300) + ByteRingQueue::recordBytes(4));
+
+    auto first = drainStrings(queue, 2);
+    ASSERT_EQ(first.size(), 2u);
+    EXPECT_EQ(first[0], "a");
+    EXPECT_EQ(first[1], "");
+
+    auto rest = drainStrings(queue);
+    ASSERT_EQ(rest.size(), 2u);
+    EXPECT_EQ(rest[0], std::string(300, 'x'));
+    EXPECT_EQ(rest[1], "tail");
+    EXPECT_TRUE(queue.isEmpty());
+}
+
+TEST(ByteRingQueueTest, Full_RejectsByBytes) {
+    ByteRingQueue queue(256);
+    const std::string record(56, 'r');  // 64 ring bytes each
+
+    for (int i = 0; i < 4; ++i) {
+        ASSERT_TRUE(queue.tryPush(record)) << i;
+    }
+    EXPECT_FALSE(queue.tryPush(record));
+    EXPECT_FALSE(queue.tryPush("x"));
+
+    // Too large to ever fit contiguously
+    ByteRingQueue empty(256);
+    EXPECT_FALSE(empty.tryPush(std::string(empty.maxRecordBytes() + 1, 'y')));
+    EXPECT_TRUE(empty.tryPush(std::string(empty.maxRecordBytes(), 'y')));
+}
+
+TEST(ByteRingQueueTest, WrapAround_InsertsPaddingRecord) {
+    ByteRingQueue queue(256);
+
+    // Advance to offset 192, then free the space
+    for (int i = 0; i < 3; ++i) {
+        ASSERT_TRUE(queue.tryPush(std::string(56, 'a')));
+    }
+    ASSERT_EQ(drainStrings(queue).size(), 3u);
+
+    // 100 bytes do not fit in the last 64: 64 bytes of padding, then the record at 0
+    const std::string big(100, 'b');
+    ASSERT_TRUE(queue.tryPush(big));
+    EXPECT_EQ(queue.sizeBytes(), 64u + ByteRingQueue::recordBytes(100));
+
+    auto records = drainStrings(queue);
+    ASSERT_EQ(records.size(), 1u);  // Padding is skipped
+    EXPECT_EQ(records[0], big);
+    EXPECT_TRUE(queue.isEmpty());
+}
+
+TEST(ByteRingQueueTest, ManyLaps_MixedSizes) {
+    ByteRingQueue queue(1024);
+    int next_push = 0;
+    int next_pop = 0;
+    for (int round = 0; round < 200; ++round) {
+        for (int i = 0; i < 3; ++i) {
+            std::string record = std::to_string(next_push) + ":" + std::string((next_push * 37) % 120, 'z');
+            ASSERT_TRUE(queue.tryPush(record)) << next_push;
+            ++next_push;
+        }
+        for (const auto& record : drainStrings(queue)) {
+            EXPECT_EQ(record.substr(0, record.find(':')), std::to_string(next_pop));
+            EXPECT_EQ(record.size() - record.find(':') - 1, static_cast<size_t>((next_pop * 37) % 120));
+            ++next_pop;
+        }
+    }
+    EXPECT_EQ(next_pop, next_push);
+}
+
+TEST(ByteRingQueueTest, UncommittedRecord_BlocksLaterRecords) {
+    ByteRingQueue queue(1024);
+    char* payload = queue.reserve(5);
+    ASSERT_NE(payload, nullptr);
+    ASSERT_TRUE(queue.tryPush("second"));
+
+    // Reservation order is preserved: nothing is visible until the first commit
+    EXPECT_TRUE(drainStrings(queue).empty());
+
+    std::memcpy(payload, "first", 5);
+    queue.commit(payload);
+    auto records = drainStrings(queue);
+    ASSERT_EQ(records.size(), 2u);
+    EXPECT_EQ(records[0], "first");
+    EXPECT_EQ(records[1], "second");
+}
+
+TEST(ByteRingQueueTest, Entries_RoundTripInPlace) {
+    ByteRingQueue queue(4096);
+    LogEntry entry(LogLevel::kLogLevelWarning, 1700000000123, 4242, ThreadIdType{}, "Network", "socket closed");
+    entry.deferred = true;
+    ASSERT_TRUE(queue.tryPushEntry(entry));
+
+    int seen = 0;
+    queue.drainEntries([&seen](const LogEntry& decoded) {
+        EXPECT_EQ(decoded.level, LogLevel::kLogLevelWarning);
+        EXPECT_EQ(decoded.timestamp_ms, 1700000000123);
+        EXPECT_EQ(decoded.process_id, static_cast<ProcessIdType>(4242));
+        EXPECT_EQ(decoded.tag, "Network");
+        EXPECT_EQ(decoded.message, "socket closed");
+        EXPECT_TRUE(decoded.deferred);
+        EXPECT_EQ(decoded.storage, nullptr);  // Views point into the ring
+        ++seen;
+    });
+    EXPECT_EQ(seen, 1);
+}
+
+TEST(ByteRingQueueTest, ConcurrentProducers_NothingLostOrReordered) {
+    ByteRingQueue queue(4096);  // Small so producers keep wrapping and hitting full
+    constexpr int kThreads = 8;
+    constexpr int kPerThread = 5000;
+
+    std::atomic<int> running{kThreads};
+    std::vector<std::thread> producers;
+    for (int t = 0; t < kThreads; ++t) {
+        producers.emplace_back([&queue, &running, t]() {
+            for (int i = 0; i < kPerThread; ++i) {
+                std::string record = std::to_string(t) + ":" + std::to_string(i) + std::string(i % 50, '.');
+                while (!queue.tryPush(record)) {
+                    std::this_thread::yield();
+                }
+            }
+            running.fetch_sub(1);
+        });
+    }
+
+    std::vector<int> next(kThreads, 0);
+    int received = 0;
+    auto check = [&](std::string_view record) {
+        const size_t colon = record.find(':');
+        const int t = std::stoi(std::string(record.substr(0, colon)));
+        const int i = std::stoi(std::string(record.substr(colon + 1)));
+        EXPECT_EQ(i, next[t]) << "producer " << t;
+        EXPECT_EQ(record.size(), colon + 1 + std::to_string(i).size() + i % 50);
+        next[t] = i + 1;
+        ++received;
+    };
+    while (running.load() > 0 || !queue.isEmpty()) {
+        if (queue.drain(check) == 0) {
+            std::this_thread::yield();
+        }
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+
+    EXPECT_EQ(received, kThreads * kPerThread);
+}
@@ -0,0 +1,330 @@
+// Unit tests for the crash handler emergency flush path
+
+#include <gtest/gtest.h>
+#include "speckit/log/crash_handler.h"
+#include "speckit/log/async_logger.h"
+#include "speckit/log/platform.h"
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <chrono>
+
+#ifndef SPECKIT_PLATFORM_WINDOWS
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <memory>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+namespace {
+
+// Deliberately overflow the stack; only an alternate signal stack can handle this.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Winfinite-recursion"
+__attribute__((noinline)) int recurseForever(int depth) {
+    volatile char frame[1024];
+    frame[0] = static_cast<char>(depth);
+    return recurseForever(depth + 1) + frame[0];
+}
+#pragma GCC diagnostic pop
+
+// Line formatter that overflows the writer thread's stack
+std::string overflowingFormat(const LogEntry&) {
+    return std::string(1, static_cast<char>(recurseForever(0)));
+}
+
+// Lifts the file size limit, then crashes on the thread whose write hit it
+void crashOnFileSizeLimit(int) {
+    struct rlimit limit{};
+    getrlimit(RLIMIT_FSIZE, &limit);
+    limit.rlim_cur = limit.rlim_max;
+    setrlimit(RLIMIT_FSIZE, &limit);
+    raise(SIGSEGV);
+}
+
+// SIGTERM deliveries seen by the application's own handler
+volatile sig_atomic_t g_app_sigterms = 0;
+
+void countSigterm(int) {
+    g_app_sigterms = g_app_sigterms + 1;
+}
+
+}  // namespace
+
+class CrashHandlerTest : public ::testing::TestWithParam<int> {
+protected:
+    std::string log_file_;
+
+    void SetUp() override {
+        log_file_ = (std::filesystem::current_path() / "crash_test.log").string();
+        std::filesystem::remove(log_file_);
+    }
+
+    void TearDown() override {
+        std::filesystem::remove(log_file_);
+    }
+
+    std::string readLog() const {
+        std::ifstream file(log_file_);
+        return std::string((std::istreambuf_iterator<char>(file)),
+                           std::istreambuf_iterator<char>());
+    }
+
+    /// Run @p body in a forked child and return the signal that terminated it (0 if none)
+    template <typename Body>
+    int runInChild(Body body) {
+        pid_t pid = fork();
+        if (pid == 0) {
+            body();
+            _exit(0);  // Crash did not happen
+        }
+        int status = 0;
+        waitpid(pid, &status, 0);
+        return WIFSIGNALED(status) ? WTERMSIG(status) : 0;
+    }
+
+    /// Child side: stage bytes that never reach the file through the normal path
+    void stageAndCrash(int sig, const char* staged, bool commit) {
+        CrashHandler handler;
+        int fd = open(log_file_.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+        handler.attachEmergencyFile(fd);
+        close(fd);
+
+        handler.stageEmergencyBytes(staged, std::strlen(staged));
+        if (commit) {
+            handler.commitEmergencyBytes();
+        }
+
+        if (sig == SIGSEGV) {
+            volatile int* null_ptr = nullptr;
+            *null_ptr = 42;
+        } else if (sig == SIGABRT) {
+            std::abort();
+        } else {
+            raise(sig);
+        }
+    }
+};
+
+TEST_P(CrashHandlerTest, StagedBytes_WrittenOnCrash) {
+    const int sig = GetParam();
+    int term_signal = runInChild([&]() { stageAndCrash(sig, "staged before crash\n", false); });
+
+    // The original signal must still terminate the process
+    EXPECT_EQ(term_signal, sig);
+    EXPECT_NE(readLog().find("staged before crash"), std::string::npos);
+}
+
+INSTANTIATE_TEST_SUITE_P(AllHandledSignals, CrashHandlerTest,
+                         ::testing::Values(SIGSEGV, SIGBUS, SIGFPE, SIGILL, SIGABRT, SIGTERM));
+
+TEST_F(CrashHandlerTest, CommittedBytes_NotReplayed) {
+    int term_signal = runInChild([&]() { stageAndCrash(SIGSEGV, "already written\n", true); });
+
+    EXPECT_EQ(term_signal, SIGSEGV);
+    EXPECT_EQ(readLog().find("already written"), std::string::npos);
+}
+
+TEST_F(CrashHandlerTest, PartiallyWrittenBytes_ReplayedOnce) {
+    int term_signal = runInChild([&]() {
+        CrashHandler handler;
+        int fd = open(log_file_.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+        handler.attachEmergencyFile(fd);
+
+        // Half of the staged chunk reaches the file before the signal
+        const char staged[] = "written in part before crash\n";
+        handler.stageEmergencyBytes(staged, sizeof(staged) - 1);
+        if (write(fd, staged, 10) != 10) {
+            _exit(1);
+        }
+        close(fd);
+        raise(SIGTERM);
+    });
+
+    EXPECT_EQ(term_signal, SIGTERM);
+    EXPECT_EQ(readLog(), "written in part before crash\n");
+}
+
+TEST_F(CrashHandlerTest, StackOverflow_HandledOnAltStack) {
+    int term_signal = runInChild([&]() {
+        CrashHandler handler;
+        int fd = open(log_file_.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+        handler.attachEmergencyFile(fd);
+        close(fd);
+
+        const char staged[] = "before overflow\n";
+        handler.stageEmergencyBytes(staged, sizeof(staged) - 1);
+        recurseForever(0);
+    });
+
+    EXPECT_EQ(term_signal, SIGSEGV);
+    EXPECT_NE(readLog().find("before overflow"), std::string::npos);
+}
+
+TEST_F(CrashHandlerTest, WriterThreadStackOverflow_HandledOnAltStack) {
+    const std::string base = (std::filesystem::current_path() / "crash_overflow_test").string();
+    int term_signal = runInChild([&]() {
+        CrashHandler handler;
+        int fd = open(log_file_.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+        handler.attachEmergencyFile(fd);
+        close(fd);
+        const char staged[] = "before writer overflow\n";
+        handler.stageEmergencyBytes(staged, sizeof(staged) - 1);
+
+        // The overflow happens on the writer thread, not the one that built the handler
+        auto logger = AsyncLogger::create(base);
+        logger->setLineFormatter(overflowingFormat);
+        logger->log(LogLevel::kLogLevelError, "Crash", "overflow");
+        std::this_thread::sleep_for(5s);
+    });
+
+    EXPECT_EQ(term_signal, SIGSEGV);
+    EXPECT_NE(readLog().find("before writer overflow"), std::string::npos);
+    for (const auto& entry : std::filesystem::directory_iterator(std::filesystem::current_path())) {
+        if (entry.path().filename().string().rfind("crash_overflow_test", 0) == 0) {
+            std::filesystem::remove(entry.path());
+        }
+    }
+}
+
+TEST_F(CrashHandlerTest, AsyncLogger_StagedChunkReplayedOnCrash) {
+    const auto dir = std::filesystem::current_path();
+    const std::string base = (dir / "crash_logger_test").string();
+    auto isLoggerFile = [](const std::filesystem::path& p) {
+        return p.filename().string().rfind("crash_logger_test", 0) == 0 && p.extension() == ".log";
+    };
+
+    int term_signal = runInChild([&]() {
+        auto logger = AsyncLogger::create(base);
+        logger->log(LogLevel::kLogLevelError, "Crash", "first words");
+        logger->flush();
+
+        // The next write stops 10 bytes in, with its chunk still staged: SIGXFSZ
+        // crashes the writer thread inside FileManager::Write()
+        struct sigaction sa{};
+        sa.sa_handler = crashOnFileSizeLimit;
+        sigemptyset(&sa.sa_mask);
+        sigaction(SIGXFSZ, &sa, nullptr);
+        struct rlimit limit{};
+        getrlimit(RLIMIT_FSIZE, &limit);
+        limit.rlim_cur = std::filesystem::file_size(logger->getLogFileName()) + 10;
+        setrlimit(RLIMIT_FSIZE, &limit);
+
+        logger->log(LogLevel::kLogLevelError, "Crash", "last words");
+        std::this_thread::sleep_for(5s);
+    });
+
+    EXPECT_EQ(term_signal, SIGSEGV);
+
+    // The child may have written base.log or base_PID.log depending on process detection
+    std::string contents;
+    for (const auto& entry : std::filesystem::directory_iterator(dir)) {
+        if (!isLoggerFile(entry.path())) {
+            continue;
+        }
+        std::ifstream file(entry.path());
+        contents.append(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        file.close();
+        std::filesystem::remove(entry.path());
+    }
+
+    EXPECT_NE(contents.find("first words"), std::string::npos) << contents;
+    EXPECT_NE(contents.find("[Crash]: last words"), std::string::npos) << contents;
+    // The 10 bytes that reached the file before the crash are not written twice
+    const size_t words = contents.find("[Crash]: last words");
+    const size_t line_start = contents.rfind('\n', words) + 1;
+    const std::string line = contents.substr(line_start, words - line_start);
+    EXPECT_EQ(line.find(line.substr(0, 10), 1), std::string::npos) << contents;
+}
+
+TEST_F(CrashHandlerTest, ApplicationSigtermHandler_ChainedWithoutReplay) {
+    const auto dir = std::filesystem::current_path();
+    const std::string base = (dir / "crash_sigterm_test").string();
+    auto isLoggerFile = [](const std::filesystem::path& p) {
+        return p.filename().string().rfind("crash_sigterm_test", 0) == 0 && p.extension() == ".log";
+    };
+
+    int term_signal = runInChild([&]() {
+        // Installed before the logger's, so SIGTERM is the application's to handle
+        struct sigaction app{};
+        app.sa_handler = countSigterm;
+        sigemptyset(&app.sa_mask);
+        sigaction(SIGTERM, &app, nullptr);
+
+        auto logger = AsyncLogger::create(base);
+        logger->log(LogLevel::kLogLevelError, "Crash", "before term");
+        logger->flush();
+
+        // Twice: the application's handler, and ours, stay installed
+        raise(SIGTERM);
+        raise(SIGTERM);
+        if (g_app_sigterms != 2) {
+            _exit(3);
+        }
+        logger->log(LogLevel::kLogLevelError, "Crash", "after term");
+        logger->flush();
+
+        // Crash replay still works afterwards
+        struct sigaction sa{};
+        sa.sa_handler = crashOnFileSizeLimit;
+        sigemptyset(&sa.sa_mask);
+        sigaction(SIGXFSZ, &sa, nullptr);
+        struct rlimit limit{};
+        getrlimit(RLIMIT_FSIZE, &limit);
+        limit.rlim_cur = std::filesystem::file_size(logger->getLogFileName()) + 10;
+        setrlimit(RLIMIT_FSIZE, &limit);
+
+        logger->log(LogLevel::kLogLevelError, "Crash", "last words");
+        std::this_thread::sleep_for(5s);
+    });
+
+    EXPECT_EQ(term_signal, SIGSEGV);
+
+    std::string contents;
+    for (const auto& entry : std::filesystem::directory_iterator(dir)) {
+        if (!isLoggerFile(entry.path())) {
+            continue;
+        }
+        std::ifstream file(entry.path());
+        contents.append(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        file.close();
+        std::filesystem::remove(entry.path());
+    }
+
+    auto count = [&contents](const std::string& text) {
+        size_t n = 0;
+        for (size_t pos = contents.find(text); pos != std::string::npos; pos = contents.find(text, pos + 1)) {
+            ++n;
+        }
+        return n;
+    };
+    EXPECT_EQ(count("before term"), 1u) << contents;
+    EXPECT_EQ(count("after term"), 1u) << contents;
+    EXPECT_EQ(count("[Crash]: last words"), 1u) << contents;
+}
+
+TEST(CrashHandlerSlotTest, SlotsBeyondTheCap_AreReported) {
+    std::vector<std::unique_ptr<CrashHandler>> handlers;
+    while (handlers.size() <= CrashHandler::kMaxEmergencyBuffers) {
+        handlers.push_back(std::make_unique<CrashHandler>(64));
+        if (!handlers.back()->hasEmergencySlot()) {
+            break;
+        }
+    }
+    // Loggers alive elsewhere in the process may hold some of the slots
+    ASSERT_FALSE(handlers.back()->hasEmergencySlot());
+    EXPECT_LE(handlers.size() - 1, CrashHandler::kMaxEmergencyBuffers);
+
+    // A destroyed instance frees its slot
+    handlers.erase(handlers.begin());
+    EXPECT_TRUE(CrashHandler(64).hasEmergencySlot());
+}
+
+#endif  // !SPECKIT_PLATFORM_WINDOWS
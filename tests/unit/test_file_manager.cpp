@@ -104,3 +104,20 @@ TEST_F(FileNameGenerationTest, DifferentPids_GenerateDifferentFilenames) {
 }
 
 
+
+TEST_F(FileNameGenerationTest, SetOutputFormat_FailedOpenKeepsOldFile) {
+    FileManager file_manager(log_base_path_);
+    ASSERT_TRUE(file_manager.Initialize(3333));
+    std::string filename = file_manager.GetLogFileName();
+
+    // A directory where the new file would go makes the open fail
+    std::string blocked = filename.substr(0, filename.size() - 4) + ".slog";
+    std::filesystem::create_directory(blocked);
+
+    EXPECT_FALSE(file_manager.SetOutputFormat(LogFileFormat::kBinary));
+    EXPECT_EQ(file_manager.GetOutputFormat(), LogFileFormat::kText);
+    EXPECT_EQ(file_manager.GetLogFileName(), filename);
+    EXPECT_TRUE(file_manager.Write("still writing\n"));
+
+    std::filesystem::remove(blocked);
+}
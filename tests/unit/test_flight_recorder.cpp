@@ -0,0 +1,327 @@
+// Unit tests for the in-memory flight recorder
+
+#include <gtest/gtest.h>
+#include "speckit/log/async_logger.h"
+#include "speckit/log/flight_recorder.h"
+#include "speckit/log/line_pattern.h"
+#include "speckit/log/tag_filter.h"
+#include "speckit/log/platform.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdarg>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+std::string readFile(const std::string& path) {
+    std::ifstream file(path);
+    std::stringstream contents;
+    contents << file.rdbuf();
+    return contents.str();
+}
+
+std::vector<std::string> readLines(const std::string& path) {
+    std::vector<std::string> lines;
+    std::ifstream file(path);
+    for (std::string line; std::getline(file, line);) {
+        lines.push_back(line);
+    }
+    return lines;
+}
+
+// Set once slowFormat() has been called; it then takes 2 ms per line
+std::atomic<bool> g_slow_format_started{false};
+
+std::string slowFormat(const LogEntry& entry) {
+    g_slow_format_started.store(true);
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    return formatLogEntry(entry);
+}
+
+bool logPrintf(AsyncLogger& logger, LogLevel level, const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    const bool ok = logger.vlogf(level, "Printf", format, args);
+    va_end(args);
+    return ok;
+}
+
+}  // namespace
+
+class FlightRecorderTest : public ::testing::Test {
+protected:
+    std::filesystem::path dir_;
+
+    void SetUp() override {
+        dir_ = std::filesystem::current_path() / "flight_recorder_test";
+        std::filesystem::remove_all(dir_);
+        std::filesystem::create_directories(dir_);
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(dir_);
+    }
+
+    std::unique_ptr<AsyncLogger> createLogger() {
+        auto logger = AsyncLogger::create((dir_ / "app").string());
+        if (logger) {
+            logger->setLogLevel(LogLevel::kLogLevelInfo);
+        }
+        return logger;
+    }
+
+    /// Dump files written so far, oldest first
+    std::vector<std::string> dumpFiles() {
+        std::vector<std::string> files;
+        for (const auto& item : std::filesystem::directory_iterator(dir_)) {
+            if (item.path().filename().string().find(".flight.") != std::string::npos) {
+                files.push_back(item.path().string());
+            }
+        }
+        std::sort(files.begin(), files.end());
+        return files;
+    }
+
+    /// Wait up to @p timeout for @p count finished dumps
+    bool waitForDumps(const AsyncLogger& logger, uint64_t count,
+                      std::chrono::milliseconds timeout = std::chrono::milliseconds(3000)) {
+        const auto deadline = std::chrono::steady_clock::now() + timeout;
+        while (logger.getFlightRecorderStats().dumps < count) {
+            if (std::chrono::steady_clock::now() > deadline) {
+                return false;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        return true;
+    }
+};
+
+TEST_F(FlightRecorderTest, Dump_HoldsEntriesBelowTheLevelOnly) {
+    auto logger = createLogger();
+    ASSERT_NE(logger, nullptr);
+    FlightRecorderOptions options;
+    options.dump_on_level = false;
+    ASSERT_TRUE(logger->enableFlightRecorder(options));
+    EXPECT_FALSE(logger->enableFlightRecorder(options));
+
+    logger->log(LogLevel::kLogLevelDebug, "Net", "debug detail");
+    logger->log(LogLevel::kLogLevelInfo, "Net", "to the file");
+    logger->log(LogLevel::kLogLevelDebug, "Net", "request", {{"id", 7}});
+    logger->log(LogLevel::kLogLevelDebug, "Net", [] { return std::string("lazy detail"); });
+    ASSERT_TRUE(logPrintf(*logger, LogLevel::kLogLevelDebug, "retry %d of %s", 2, "three"));
+    logger->flush();
+
+    const std::string path = logger->dumpFlightRecorder();
+    ASSERT_FALSE(path.empty());
+    EXPECT_NE(path.find("app.flight."), std::string::npos) << path;
+    const auto lines = readLines(path);
+    ASSERT_EQ(lines.size(), 4u) << readFile(path);
+    EXPECT_NE(lines[0].find("[DEBUG]"), std::string::npos) << lines[0];
+    EXPECT_NE(lines[0].find("[Net]: debug detail"), std::string::npos) << lines[0];
+    EXPECT_NE(lines[1].find("request id=7"), std::string::npos) << lines[1];
+    EXPECT_NE(lines[2].find("lazy detail"), std::string::npos) << lines[2];
+    EXPECT_NE(lines[3].find("retry 2 of three"), std::string::npos) << lines[3];
+
+    // The log file gets only what passed the level
+    const std::string file = readFile(logger->getLogFileName());
+    EXPECT_NE(file.find("to the file"), std::string::npos);
+    EXPECT_EQ(file.find("debug detail"), std::string::npos);
+
+    // A dump empties the ring
+    EXPECT_TRUE(logger->dumpFlightRecorder().empty());
+    const FlightRecorderStats stats = logger->getFlightRecorderStats();
+    EXPECT_EQ(stats.entries_recorded, 4u);
+    EXPECT_EQ(stats.entries_dumped, 4u);
+    EXPECT_EQ(stats.dumps, 1u);
+    EXPECT_EQ(stats.bytes_used, 0u);
+}
+
+TEST_F(FlightRecorderTest, Dump_UsesTheLoggersLayout) {
+    auto logger = createLogger();
+    ASSERT_NE(logger, nullptr);
+    logger->setLineFormatter(LinePattern<"%L [%g] %m">::format);
+    FlightRecorderOptions options;
+    options.dump_on_level = false;
+    ASSERT_TRUE(logger->enableFlightRecorder(options));
+
+    logger->log(LogLevel::kLogLevelDebug, "Net", "patterned");
+    std::string path = logger->dumpFlightRecorder();
+    ASSERT_FALSE(path.empty());
+    EXPECT_EQ(readFile(path), "DEBUG [Net] patterned\n");
+
+    // Later layout changes reach the recorder too
+    ASSERT_TRUE(logger->setOutputFormat(LogFileFormat::kJsonLines));
+    logger->log(LogLevel::kLogLevelDebug, "Net", "as json");
+    path = logger->dumpFlightRecorder();
+    ASSERT_FALSE(path.empty());
+    const auto lines = readLines(path);
+    ASSERT_EQ(lines.size(), 1u);
+    EXPECT_EQ(lines[0].front(), '{') << lines[0];
+    EXPECT_NE(lines[0].find("\"msg\":\"as json\""), std::string::npos) << lines[0];
+}
+
+TEST_F(FlightRecorderTest, SlowDump_DoesNotStallRecording) {
+    auto logger = createLogger();
+    ASSERT_NE(logger, nullptr);
+    logger->setLineFormatter(slowFormat);
+    FlightRecorderOptions options;
+    options.budget_bytes = 64 * 1024;
+    options.dump_on_level = false;
+    ASSERT_TRUE(logger->enableFlightRecorder(options));
+
+    const std::string padding(100, 'x');
+    auto fill = [&]() {
+        for (int i = 0; i < 1000; ++i) {
+            logger->log(LogLevel::kLogLevelDebug, "Ring", "entry " + std::to_string(i) + " " + padding);
+        }
+    };
+    fill();
+    const uint64_t recorded = logger->getFlightRecorderStats().entries_recorded;
+    ASSERT_GT(logger->getFlightRecorderStats().entries_evicted, 0u);  // The ring is full
+
+    // Formatting the ring takes about a second; recording into it meanwhile must not wait
+    g_slow_format_started.store(false);
+    std::thread dumper([&]() { logger->dumpFlightRecorder(); });
+    while (!g_slow_format_started.load()) {
+        std::this_thread::yield();
+    }
+    const auto start = std::chrono::steady_clock::now();
+    fill();
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    dumper.join();
+
+    EXPECT_LT(elapsed, std::chrono::milliseconds(300));
+    EXPECT_EQ(logger->getFlightRecorderStats().entries_recorded, recorded + 1000);
+    EXPECT_EQ(logger->getFlightRecorderStats().entries_lost, 0u);
+}
+
+TEST_F(FlightRecorderTest, DisabledTags_AreNotRecorded) {
+    auto logger = createLogger();
+    ASSERT_NE(logger, nullptr);
+    speckit::log::TagFilter filter;
+    filter.setTagEnabled("Noise", false);
+    logger->setTagFilter(&filter);
+    FlightRecorderOptions options;
+    options.dump_on_level = false;
+    ASSERT_TRUE(logger->enableFlightRecorder(options));
+
+    logger->log(LogLevel::kLogLevelDebug, "Noise", "dropped");
+    logger->log(LogLevel::kLogLevelDebug, "Net", "kept");
+
+    const auto lines = readLines(logger->dumpFlightRecorder());
+    ASSERT_EQ(lines.size(), 1u);
+    EXPECT_NE(lines[0].find("kept"), std::string::npos);
+    logger->setTagFilter(nullptr);
+}
+
+TEST_F(FlightRecorderTest, FullRing_EvictsOldest) {
+    auto logger = createLogger();
+    ASSERT_NE(logger, nullptr);
+    FlightRecorderOptions options;
+    options.budget_bytes = 16 * 1024;
+    options.dump_on_level = false;
+    ASSERT_TRUE(logger->enableFlightRecorder(options));
+
+    const std::string padding(100, 'x');
+    for (int i = 0; i < 1000; ++i) {
+        logger->log(LogLevel::kLogLevelDebug, "Ring", "entry " + std::to_string(i) + " " + padding);
+    }
+
+    const FlightRecorderStats before = logger->getFlightRecorderStats();
+    EXPECT_EQ(before.entries_recorded, 1000u);
+    EXPECT_GT(before.entries_evicted, 0u);
+    EXPECT_EQ(before.entries_lost, 0u);
+    EXPECT_LE(before.bytes_used, 16u * 1024u);
+
+    const auto lines = readLines(logger->dumpFlightRecorder());
+    ASSERT_EQ(lines.size(), 1000u - before.entries_evicted);
+    EXPECT_NE(lines.back().find("entry 999 "), std::string::npos);
+    for (size_t i = 1; i < lines.size(); ++i) {
+        ASSERT_LT(std::stoi(lines[i - 1].substr(lines[i - 1].find("entry ") + 6)),
+                  std::stoi(lines[i].substr(lines[i].find("entry ") + 6)));
+    }
+}
+
+TEST_F(FlightRecorderTest, OversizedEntry_IsCountedAsLost) {
+    auto logger = createLogger();
+    ASSERT_NE(logger, nullptr);
+    FlightRecorderOptions options;
+    options.budget_bytes = 1024;
+    options.dump_on_level = false;
+    ASSERT_TRUE(logger->enableFlightRecorder(options));
+
+    logger->log(LogLevel::kLogLevelDebug, "Big", std::string(4096, 'b'));
+    EXPECT_EQ(logger->getFlightRecorderStats().entries_lost, 1u);
+    EXPECT_TRUE(logger->dumpFlightRecorder().empty());
+}
+
+TEST_F(FlightRecorderTest, ErrorLevel_DumpsOnRecorderThread) {
+    auto logger = createLogger();
+    ASSERT_NE(logger, nullptr);
+    FlightRecorderOptions options;
+    options.min_dump_interval = std::chrono::milliseconds(200);
+    ASSERT_TRUE(logger->enableFlightRecorder(options));
+
+    logger->log(LogLevel::kLogLevelDebug, "Db", "query plan A");
+    logger->log(LogLevel::kLogLevelWarning, "Db", "slow query");
+    logger->log(LogLevel::kLogLevelError, "Db", "query failed");
+    ASSERT_TRUE(waitForDumps(*logger, 1));
+    EXPECT_NE(readFile(dumpFiles()[0]).find("query plan A"), std::string::npos);
+
+    // A second error within the interval is dumped once the interval has passed
+    logger->log(LogLevel::kLogLevelDebug, "Db", "query plan B");
+    logger->log(LogLevel::kLogLevelError, "Db", "query failed again");
+    ASSERT_TRUE(waitForDumps(*logger, 2));
+    const auto files = dumpFiles();
+    EXPECT_NE(readFile(files[1]).find("query plan B"), std::string::npos);
+    EXPECT_EQ(readFile(files[1]).find("query plan A"), std::string::npos);
+}
+
+TEST_F(FlightRecorderTest, DumpOnLevelDisabled_ErrorsDoNotDump) {
+    auto logger = createLogger();
+    ASSERT_NE(logger, nullptr);
+    FlightRecorderOptions options;
+    options.dump_on_level = false;
+    ASSERT_TRUE(logger->enableFlightRecorder(options));
+
+    logger->log(LogLevel::kLogLevelDebug, "Db", "detail");
+    logger->log(LogLevel::kLogLevelError, "Db", "failure");
+    std::this_thread::sleep_for(FlightRecorder::kSignalPollInterval * 3);
+    EXPECT_TRUE(dumpFiles().empty());
+    EXPECT_EQ(logger->getFlightRecorderStats().dumps, 0u);
+}
+
+#ifndef SPECKIT_PLATFORM_WINDOWS
+TEST_F(FlightRecorderTest, Signal_RequestsDump) {
+    auto logger = createLogger();
+    ASSERT_NE(logger, nullptr);
+    FlightRecorderOptions options;
+    options.dump_on_level = false;
+    options.dump_signal = SIGUSR2;
+    options.dump_base = (dir_ / "signaled").string();
+    ASSERT_TRUE(logger->enableFlightRecorder(options));
+
+    logger->log(LogLevel::kLogLevelDebug, "Sig", "before the signal");
+    ASSERT_EQ(std::raise(SIGUSR2), 0);
+    ASSERT_TRUE(waitForDumps(*logger, 1));
+    const auto files = dumpFiles();
+    EXPECT_NE(files[0].find("signaled.flight."), std::string::npos) << files[0];
+    EXPECT_NE(readFile(files[0]).find("before the signal"), std::string::npos);
+    std::signal(SIGUSR2, SIG_DFL);
+}
+#endif
+
+TEST_F(FlightRecorderTest, NotEnabled_NothingRecorded) {
+    auto logger = createLogger();
+    ASSERT_NE(logger, nullptr);
+    logger->log(LogLevel::kLogLevelDebug, "Net", "filtered");
+    EXPECT_TRUE(logger->dumpFlightRecorder().empty());
+    EXPECT_EQ(logger->getFlightRecorderStats().entries_recorded, 0u);
+}
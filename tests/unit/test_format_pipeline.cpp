@@ -0,0 +1,154 @@
+// Unit tests for FormatPipeline and AsyncLogger with formatter threads
+
+#include <gtest/gtest.h>
+#include "speckit/log/format_pipeline.h"
+#include "speckit/log/async_logger.h"
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+/// Fill and submit one batch of owned entries numbered from @p first
+void submitNumbered(FormatPipeline& pipeline, int first, size_t count) {
+    std::span<LogEntry> batch = pipeline.acquireBatch();
+    ASSERT_GE(batch.size(), count);
+    for (size_t i = 0; i < count; ++i) {
+        batch[i] = LogEntry::createOwned(LogLevel::kLogLevelInfo, 0, 1, ThreadIdType{}, "Pipe",
+                                         "n" + std::to_string(first + static_cast<int>(i)) + ";");
+    }
+    pipeline.submitBatch(count);
+}
+
+/// Sequence numbers of all "n<k>;" messages in @p text, in order
+std::vector<int> numbersIn(const std::string& text) {
+    std::vector<int> numbers;
+    std::istringstream lines(text);
+    for (std::string line; std::getline(lines, line);) {
+        const size_t pos = line.find(": n");
+        if (pos != std::string::npos) {
+            numbers.push_back(std::stoi(line.substr(pos + 3)));
+        }
+    }
+    return numbers;
+}
+
+}  // namespace
+
+TEST(FormatPipelineTest, OutputKeepsSubmissionOrder) {
+    constexpr int kBatches = 200;
+    std::string output;
+    size_t chunks = 0;
+    {
+        // Tiny chunks so a batch spans several writes
+        FormatPipeline pipeline(4, 64, 256, [&](const std::string& chunk) {
+            EXPECT_LE(chunk.size(), 256u + 128u);
+            output += chunk;
+            ++chunks;
+        });
+        EXPECT_EQ(pipeline.formatterThreads(), 4u);
+
+        int next = 0;
+        for (int b = 0; b < kBatches; ++b) {
+            // Uneven batch sizes so formatters finish out of order
+            const size_t count = 1 + static_cast<size_t>(b * 7) % 64;
+            submitNumbered(pipeline, next, count);
+            next += static_cast<int>(count);
+        }
+        // Destruction writes everything submitted before stopping
+    }
+
+    const auto numbers = numbersIn(output);
+    for (size_t i = 0; i < numbers.size(); ++i) {
+        ASSERT_EQ(numbers[i], static_cast<int>(i));
+    }
+    EXPECT_GT(chunks, static_cast<size_t>(kBatches));
+}
+
+TEST(FormatPipelineTest, WaitIdle_AllSubmittedBatchesWritten) {
+    size_t written = 0;
+    FormatPipeline pipeline(2, 16, 1024, [&](const std::string& chunk) {
+        written += numbersIn(chunk).size();
+    });
+
+    for (int b = 0; b < 10; ++b) {
+        submitNumbered(pipeline, b * 16, 16);
+    }
+    pipeline.waitIdle();
+    EXPECT_EQ(written, 160u);
+
+    // An empty submission returns the batch without writing anything
+    pipeline.acquireBatch();
+    pipeline.submitBatch(0);
+    pipeline.waitIdle();
+    EXPECT_EQ(written, 160u);
+}
+
+class FormatterThreadsLoggerTest : public ::testing::TestWithParam<size_t> {
+protected:
+    std::filesystem::path dir_;
+
+    void SetUp() override {
+        dir_ = std::filesystem::current_path() / "format_pipeline_test";
+        std::filesystem::remove_all(dir_);
+        std::filesystem::create_directories(dir_);
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(dir_);
+    }
+};
+
+TEST_P(FormatterThreadsLoggerTest, EntriesWrittenInOrder) {
+    constexpr int kThreads = 4;
+    constexpr int kPerThread = 2000;
+
+    auto logger = AsyncLogger::create((dir_ / "fmt").string(), 1 << 14, GetParam());
+    ASSERT_NE(logger, nullptr);
+    EXPECT_EQ(logger->getFormatterThreads(), GetParam());
+
+    std::vector<std::thread> producers;
+    for (int t = 0; t < kThreads; ++t) {
+        producers.emplace_back([&logger, t]() {
+            for (int i = 0; i < kPerThread; ++i) {
+                logger->log(LogLevel::kLogLevelInfo, "Fmt", std::to_string(t) + ":" + std::to_string(i));
+            }
+        });
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+
+    // flush() returns only once the pipeline has written everything
+    logger->flush();
+    const std::string file_name = logger->getLogFileName();
+    {
+        std::ifstream file(file_name);
+        int lines = 0;
+        for (std::string line; std::getline(file, line);) {
+            lines += line.find(AsyncLogger::kLossMarkerTag) == std::string::npos;  // Not drop reports
+        }
+        EXPECT_EQ(lines + static_cast<int>(logger->getMetrics().entries_dropped), kThreads * kPerThread);
+    }
+    logger->deinitialize();
+
+    std::ifstream file(file_name);
+    std::vector<int> next(kThreads, 0);
+    for (std::string line; std::getline(file, line);) {
+        if (line.find(AsyncLogger::kLossMarkerTag) != std::string::npos) {
+            continue;
+        }
+        const size_t pos = line.find("]: ");
+        ASSERT_NE(pos, std::string::npos) << line;
+        const std::string message = line.substr(pos + 3);
+        const int t = std::stoi(message);
+        const int i = std::stoi(message.substr(message.find(':') + 1));
+        EXPECT_GE(i, next[t]) << "thread " << t;  // Drops may skip, never reorder
+        next[t] = i + 1;
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(FormatterThreads, FormatterThreadsLoggerTest, ::testing::Values(0u, 1u, 3u));
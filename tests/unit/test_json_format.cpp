@@ -0,0 +1,235 @@
+// Unit tests for structured fields and JSON Lines output
+
+#include <gtest/gtest.h>
+#include "speckit/log/json_format.h"
+#include "speckit/log/log_fields.h"
+#include "speckit/log/async_logger.h"
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+using speckit::log::appendJsonEscaped;
+using speckit::log::encodeFields;
+
+namespace {
+
+/// Length of the UTF-8 sequence at @p pos if it decodes to a valid code point in its
+/// shortest form, else 0
+size_t referenceSequenceLength(std::string_view text, size_t pos) {
+    const auto lead = static_cast<unsigned char>(text[pos]);
+    const size_t length = lead >= 0xf0 ? 4 : lead >= 0xe0 ? 3 : lead >= 0xc0 ? 2 : 0;
+    if (length == 0 || pos + length > text.size()) {
+        return 0;
+    }
+    uint32_t code_point = lead & (0x7f >> length);
+    for (size_t i = 1; i < length; ++i) {
+        const auto next = static_cast<unsigned char>(text[pos + i]);
+        if ((next & 0xc0) != 0x80) {
+            return 0;
+        }
+        code_point = (code_point << 6) | (next & 0x3f);
+    }
+    const uint32_t shortest = length == 2 ? 0x80 : length == 3 ? 0x800 : 0x10000;
+    if (code_point < shortest || code_point > 0x10ffff || (code_point >= 0xd800 && code_point <= 0xdfff)) {
+        return 0;
+    }
+    return length;
+}
+
+/// Byte-at-a-time reference for appendJsonEscaped
+std::string referenceEscape(std::string_view text) {
+    std::string out;
+    for (size_t pos = 0; pos < text.size(); ++pos) {
+        const char c = text[pos];
+        const auto byte = static_cast<unsigned char>(c);
+        if (byte >= 0x80) {
+            const size_t length = referenceSequenceLength(text, pos);
+            if (length == 0) {
+                out += "\xef\xbf\xbd";
+            } else {
+                out += text.substr(pos, length);
+                pos += length - 1;
+            }
+            continue;
+        }
+        switch (c) {
+        case '"':  out += "\\\""; break;
+        case '\\': out += "\\\\"; break;
+        case '\n': out += "\\n"; break;
+        case '\r': out += "\\r"; break;
+        case '\t': out += "\\t"; break;
+        case '\b': out += "\\b"; break;
+        case '\f': out += "\\f"; break;
+        default:
+            if (byte < 0x20) {
+                char buffer[8];
+                std::snprintf(buffer, sizeof(buffer), "\\u%04x", byte);
+                out += buffer;
+            } else {
+                out += c;
+            }
+        }
+    }
+    return out;
+}
+
+std::string escaped(std::string_view text) {
+    std::string out;
+    appendJsonEscaped(out, text);
+    return out;
+}
+
+LogEntry entryWithFields(std::string_view message, const std::string& fields) {
+    return LogEntry::createOwned(LogLevel::kLogLevelInfo, 1700000000123, 4242, ThreadIdType{},
+                                 "Auth", message, fields);
+}
+
+}  // namespace
+
+TEST(JsonEscapeTest, MatchesReferenceAcrossBlockBoundaries) {
+    EXPECT_EQ(escaped(""), "");
+    EXPECT_EQ(escaped("plain ascii text, nothing to do"), "plain ascii text, nothing to do");
+    EXPECT_EQ(escaped("a\"b\\c\n\x01\x1f"), "a\\\"b\\\\c\\n\\u0001\\u001f");
+    EXPECT_EQ(escaped("caf\xc3\xa9 \xe2\x9c\x93"), "caf\xc3\xa9 \xe2\x9c\x93");  // UTF-8 copied as is
+    EXPECT_EQ(escaped("\x7f\x80\xff"), "\x7f\xef\xbf\xbd\xef\xbf\xbd");  // Invalid bytes replaced
+    EXPECT_EQ(escaped("\xf0\x9f\x98\x80"), "\xf0\x9f\x98\x80");
+    EXPECT_EQ(escaped("\xc0\xaf"), "\xef\xbf\xbd\xef\xbf\xbd");          // Overlong '/'
+    EXPECT_EQ(escaped("\xed\xa0\x80"), "\xef\xbf\xbd\xef\xbf\xbd\xef\xbf\xbd");  // Surrogate
+    EXPECT_EQ(escaped("ab\xe2\x9c"), "ab\xef\xbf\xbd\xef\xbf\xbd");      // Truncated at the end
+
+    // Special bytes at every offset of strings spanning several 16-byte blocks
+    std::mt19937 rng(7);
+    const char specials[] = {'"', '\\', '\n', '\0', '\x1f', '\x20', '\x7f', '\x80', 'a',
+                             '\xc3', '\xa9', '\xe2', '\x9c', '\xf0', '\xff'};
+    for (size_t length = 0; length < 70; ++length) {
+        for (int trial = 0; trial < 20; ++trial) {
+            std::string text(length, 'x');
+            for (auto& c : text) {
+                if (rng() % 5 == 0) {
+                    c = specials[rng() % sizeof(specials)];
+                }
+            }
+            ASSERT_EQ(escaped(text), referenceEscape(text)) << "length " << length;
+        }
+    }
+}
+
+TEST(LogFieldsTest, TypedValues_RoundTrip) {
+    std::string encoded;
+    const std::string owned = "from std::string";
+    encodeFields({{"int", -42},
+                  {"big", std::numeric_limits<uint64_t>::max()},
+                  {"ratio", 0.25},
+                  {"yes", true},
+                  {"no", false},
+                  {"name", "disk"},
+                  {"owned", owned}},
+                 encoded);
+
+    LogFieldReader reader(encoded);
+    std::string_view key;
+    speckit::log::FieldValue value;
+    std::vector<std::string> keys;
+    while (reader.next(key, value)) {
+        keys.emplace_back(key);
+        if (key == "int") {
+            EXPECT_EQ(std::get<int64_t>(value), -42);
+        } else if (key == "big") {
+            EXPECT_EQ(std::get<uint64_t>(value), std::numeric_limits<uint64_t>::max());
+        } else if (key == "ratio") {
+            EXPECT_EQ(std::get<double>(value), 0.25);
+        } else if (key == "yes") {
+            EXPECT_TRUE(std::get<bool>(value));
+        } else if (key == "no") {
+            EXPECT_FALSE(std::get<bool>(value));
+        } else if (key == "name") {
+            EXPECT_EQ(std::get<std::string_view>(value), "disk");
+        } else if (key == "owned") {
+            EXPECT_EQ(std::get<std::string_view>(value), owned);
+        }
+    }
+    EXPECT_FALSE(reader.failed());
+    EXPECT_EQ(keys, (std::vector<std::string>{"int", "big", "ratio", "yes", "no", "name", "owned"}));
+
+    LogFieldReader truncated(std::string_view(encoded).substr(0, encoded.size() - 2));
+    while (truncated.next(key, value)) {
+    }
+    EXPECT_TRUE(truncated.failed());
+}
+
+TEST(LogFieldsTest, TextFormat_AppendsKeyValuePairs) {
+    std::string encoded;
+    encodeFields({{"user_id", 42}, {"latency_us", 1234u}, {"path", "/a b"}, {"ok", true}}, encoded);
+    const LogEntry entry = entryWithFields("login", encoded);
+
+    const std::string line = formatLogEntry(entry);
+    EXPECT_NE(line.find("[Auth]: login user_id=42 latency_us=1234 path=\"/a b\" ok=true\n"), std::string::npos)
+        << line;
+}
+
+TEST(JsonFormatTest, FormatLogEntryJson_OneObjectPerLine) {
+    std::string encoded;
+    encodeFields({{"user_id", 42}, {"ratio", 0.5}, {"nan", std::numeric_limits<double>::quiet_NaN()},
+                  {"note", "say \"hi\""}},
+                 encoded);
+    const LogEntry entry = entryWithFields("line1\nline2", encoded);
+
+    const std::string json = formatLogEntryJson(entry);
+    EXPECT_EQ(json,
+              "{\"ts\":1700000000123,\"level\":\"INFO\",\"pid\":4242,\"tid\":\"" +
+              threadIdToString(ThreadIdType{}) +
+              "\",\"tag\":\"Auth\",\"msg\":\"line1\\nline2\","
+              "\"fields\":{\"user_id\":42,\"ratio\":0.5,\"nan\":null,\"note\":\"say \\\"hi\\\"\"}}\n");
+
+    // No fields, no "fields" key
+    const LogEntry plain(LogLevel::kLogLevelError, 5, 1, ThreadIdType{}, "T", "m");
+    const std::string plain_json = formatLogEntryJson(plain);
+    EXPECT_EQ(plain_json.find("fields"), std::string::npos);
+    EXPECT_EQ(plain_json.back(), '\n');
+    EXPECT_EQ(plain_json.find('\n'), plain_json.size() - 1);
+}
+
+class JsonLinesLoggerTest : public ::testing::TestWithParam<size_t> {
+protected:
+    std::filesystem::path dir_;
+
+    void SetUp() override {
+        dir_ = std::filesystem::current_path() / "json_lines_test";
+        std::filesystem::remove_all(dir_);
+        std::filesystem::create_directories(dir_);
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(dir_);
+    }
+};
+
+TEST_P(JsonLinesLoggerTest, FieldsWrittenAsJsonLines) {
+    auto logger = AsyncLogger::create((dir_ / "json").string(), 10000, GetParam());
+    ASSERT_NE(logger, nullptr);
+    ASSERT_TRUE(logger->setOutputFormat(LogFileFormat::kJsonLines));
+    const std::string file_name = logger->getLogFileName();
+    EXPECT_EQ(std::filesystem::path(file_name).extension(), ".jsonl");
+
+    constexpr int kEntries = 300;
+    for (int i = 0; i < kEntries; ++i) {
+        logger->log(LogLevel::kLogLevelInfo, "Req", "done", {{"seq", i}, {"ok", i % 2 == 0}});
+    }
+    logger->deinitialize();
+
+    std::ifstream file(file_name);
+    int seq = 0;
+    for (std::string line; std::getline(file, line); ++seq) {
+        const std::string expected = ",\"msg\":\"done\",\"fields\":{\"seq\":" + std::to_string(seq) +
+                                     ",\"ok\":" + (seq % 2 == 0 ? "true" : "false") + "}}";
+        ASSERT_GE(line.size(), expected.size());
+        EXPECT_EQ(line.substr(line.size() - expected.size()), expected);
+        EXPECT_EQ(line.front(), '{');
+    }
+    EXPECT_EQ(seq, kEntries);
+}
+
+INSTANTIATE_TEST_SUITE_P(FormatterThreads, JsonLinesLoggerTest, ::testing::Values(0u, 2u));
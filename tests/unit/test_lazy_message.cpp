@@ -0,0 +1,136 @@
+// Unit tests for lazily built log messages
+
+#include <gtest/gtest.h>
+#include "speckit/log/async_logger.h"
+#include "speckit/log/tag_filter.h"
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <string>
+#include <vector>
+
+class LazyMessageTest : public ::testing::Test {
+protected:
+    std::filesystem::path dir_;
+    std::unique_ptr<AsyncLogger> logger_;
+    speckit::log::TagFilter filter_;
+
+    void SetUp() override {
+        dir_ = std::filesystem::current_path() / "lazy_message_test";
+        std::filesystem::remove_all(dir_);
+        std::filesystem::create_directories(dir_);
+        logger_ = AsyncLogger::create((dir_ / "lazy").string());
+        ASSERT_NE(logger_, nullptr);
+        logger_->setTagFilter(&filter_);
+    }
+
+    void TearDown() override {
+        logger_.reset();
+        std::filesystem::remove_all(dir_);
+    }
+
+    std::vector<std::string> finish() {
+        const std::string file_name = logger_->getLogFileName();
+        logger_->deinitialize();
+        std::vector<std::string> messages;
+        std::ifstream file(file_name);
+        for (std::string line; std::getline(file, line);) {
+            messages.push_back(line.substr(line.find("]: ") + 3));
+        }
+        return messages;
+    }
+};
+
+TEST_F(LazyMessageTest, Callable_OnlyRunsWhenEntryPasses) {
+    int calls = 0;
+    auto dump = [&]() {
+        ++calls;
+        return std::string("dump ") + std::to_string(calls);
+    };
+
+    logger_->setLogLevel(LogLevel::kLogLevelInfo);
+    logger_->log(LogLevel::kLogLevelDebug, "Lazy", dump);  // Below the level
+
+    filter_.setTagEnabled("Muted", false);
+    logger_->log(LogLevel::kLogLevelInfo, "Muted", dump);  // Disabled tag
+
+    filter_.setTagLevel("Strict", LogLevel::kLogLevelError);
+    logger_->log(LogLevel::kLogLevelWarning, "Strict", dump);  // Below the tag's level
+
+    filter_.setTagRateLimit("Limited", speckit::log::RateLimit{1, 1});
+    for (int i = 0; i < 3; ++i) {
+        logger_->log(LogLevel::kLogLevelInfo, "Limited", dump);  // Only the first gets a token
+    }
+    EXPECT_EQ(calls, 1);
+
+    logger_->log(LogLevel::kLogLevelInfo, "Lazy", dump);
+    logger_->log(LogLevel::kLogLevelInfo, "Lazy", [] { return "literal"; });
+    EXPECT_EQ(calls, 2);
+
+    EXPECT_EQ(finish(), (std::vector<std::string>{"dump 1", "dump 2", "literal"}));
+}
+
+TEST_F(LazyMessageTest, BufferWriter_WritesIntoReusedBuffer) {
+    int calls = 0;
+    const char* previous = nullptr;
+    bool reused = true;
+    auto write = [&](std::string& out) {
+        EXPECT_TRUE(out.empty());
+        if (previous && out.data() != previous) {
+            reused = false;
+        }
+        previous = out.data();
+        out += "item ";
+        out += std::to_string(calls++);
+    };
+
+    logger_->setLogLevel(LogLevel::kLogLevelInfo);
+    logger_->log(LogLevel::kLogLevelDebug, "Lazy", write);
+    EXPECT_EQ(calls, 0);
+
+    for (int i = 0; i < 3; ++i) {
+        logger_->log(LogLevel::kLogLevelInfo, "Lazy", write);
+    }
+    EXPECT_TRUE(reused);
+
+    // A very large message does not pin its buffer afterwards
+    logger_->log(LogLevel::kLogLevelInfo, "Lazy", [](std::string& out) {
+        out.assign(AsyncLogger::kMaxRetainedMessageBuffer * 2, 'x');
+    });
+    logger_->log(LogLevel::kLogLevelInfo, "Lazy", [](std::string& out) {
+        EXPECT_LE(out.capacity(), AsyncLogger::kMaxRetainedMessageBuffer);
+        out = "after";
+    });
+
+    const auto messages = finish();
+    ASSERT_EQ(messages.size(), 5u);
+    EXPECT_EQ(messages[0], "item 0");
+    EXPECT_EQ(messages[2], "item 2");
+    EXPECT_EQ(messages[3].size(), AsyncLogger::kMaxRetainedMessageBuffer * 2);
+    EXPECT_EQ(messages[4], "after");
+}
+
+TEST_F(LazyMessageTest, BufferWriter_NestedCallsKeepTheirBuffers) {
+    logger_->setLogLevel(LogLevel::kLogLevelInfo);
+
+    // Each level logs from inside its writer, past the per-thread buffers
+    const int levels = static_cast<int>(AsyncLogger::kMessageBufferDepth) + 2;
+    std::function<void(int)> nest = [&](int level) {
+        logger_->log(LogLevel::kLogLevelInfo, "Lazy", [&, level](std::string& out) {
+            EXPECT_TRUE(out.empty());
+            out += "outer " + std::to_string(level);
+            if (level + 1 < levels) {
+                nest(level + 1);
+            }
+            out += " done";
+        });
+    };
+    nest(0);
+
+    // Innermost entries are queued first
+    const auto messages = finish();
+    ASSERT_EQ(messages.size(), static_cast<size_t>(levels));
+    for (int level = 0; level < levels; ++level) {
+        EXPECT_EQ(messages[levels - 1 - level], "outer " + std::to_string(level) + " done");
+    }
+}
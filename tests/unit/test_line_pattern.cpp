@@ -0,0 +1,94 @@
+// Unit tests for the compile-time line pattern formatter
+
+#include <gtest/gtest.h>
+#include "speckit/log/line_pattern.h"
+#include "speckit/log/async_logger.h"
+#include "speckit/log/log_fields.h"
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+namespace {
+
+// Parsed while compiling: literals are merged, %T expands to its default layout
+constexpr auto kParsed = speckit::log::parsePattern<64>("[%L] %g%%");
+static_assert(kParsed.step_count == 5);
+static_assert(kParsed.steps[0].field == speckit::log::PatternField::kLiteral);
+static_assert(kParsed.steps[1].field == speckit::log::PatternField::kLevel);
+static_assert(kParsed.steps[4].field == speckit::log::PatternField::kLiteral);
+static_assert(!kParsed.needs_time && !kParsed.needs_message);
+static_assert(speckit::log::parsePattern<256>("%T").step_count == 13);
+
+LogEntry makeEntry(int64_t timestamp_ms, std::string_view message) {
+    return LogEntry(LogLevel::kLogLevelWarning, timestamp_ms, 4242, ThreadIdType{}, "Net", message);
+}
+
+}  // namespace
+
+TEST(LinePatternTest, DefaultPattern_MatchesFormatLogEntry) {
+    for (int64_t timestamp : {int64_t{1700000000000}, int64_t{1700000000007}, int64_t{1700000059999},
+                              int64_t{1700000060123}}) {
+        const LogEntry entry = makeEntry(timestamp, "connected");
+        EXPECT_EQ(DefaultLinePattern::format(entry), formatLogEntry(entry));
+    }
+
+    std::string fields;
+    speckit::log::encodeFields({{"port", 443}, {"host", "a b"}}, fields);
+    const LogEntry with_fields = LogEntry::createOwned(LogLevel::kLogLevelInfo, 1700000000123, 1,
+                                                       ThreadIdType{}, "Net", "open", fields);
+    EXPECT_EQ(DefaultLinePattern::format(with_fields), formatLogEntry(with_fields));
+}
+
+TEST(LinePatternTest, CustomPattern_DropsAndReordersFields) {
+    const LogEntry entry = makeEntry(1700000000042, "reset");
+    const std::string full = formatLogEntry(entry);
+    const std::string clock = full.substr(full.find(' ') + 12, 12);  // HH:MM:SS.mmm
+
+    EXPECT_EQ((LinePattern<"%L %T{%H:%M:%S.%f} [%g] %m">::format(entry)), "WARNING " + clock + " [Net] reset\n");
+    EXPECT_EQ((LinePattern<"%g|%m|%P">::format(entry)), "Net|reset|4242\n");
+    EXPECT_EQ((LinePattern<"100%% %m">::format(entry)), "100% reset\n");
+    EXPECT_EQ((LinePattern<"">::format(entry)), "\n");
+}
+
+class LinePatternLoggerTest : public ::testing::TestWithParam<size_t> {
+protected:
+    std::filesystem::path dir_;
+
+    void SetUp() override {
+        dir_ = std::filesystem::current_path() / "line_pattern_test";
+        std::filesystem::remove_all(dir_);
+        std::filesystem::create_directories(dir_);
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(dir_);
+    }
+};
+
+TEST_P(LinePatternLoggerTest, SetLineFormatter_AppliesToLaterEntries) {
+    auto logger = AsyncLogger::create((dir_ / "pattern").string(), 10000, GetParam());
+    ASSERT_NE(logger, nullptr);
+    EXPECT_EQ(logger->getLineFormatter(), &formatLogEntry);
+
+    logger->log(LogLevel::kLogLevelInfo, "Old", "default layout");
+    logger->setLineFormatter(LinePattern<"%L [%g] %m">::format);
+    EXPECT_EQ(logger->getLineFormatter(), &LinePattern<"%L [%g] %m">::format);
+    for (int i = 0; i < 100; ++i) {
+        logger->log(LogLevel::kLogLevelInfo, "New", "entry " + std::to_string(i));
+    }
+    const std::string file_name = logger->getLogFileName();
+    logger->deinitialize();
+
+    std::ifstream file(file_name);
+    std::string line;
+    ASSERT_TRUE(std::getline(file, line));
+    EXPECT_EQ(line.rfind("[INFO] ", 0), 0u) << line;
+    EXPECT_NE(line.find("[Old]: default layout"), std::string::npos);
+    for (int i = 0; i < 100; ++i) {
+        ASSERT_TRUE(std::getline(file, line));
+        EXPECT_EQ(line, "INFO [New] entry " + std::to_string(i));
+    }
+    EXPECT_FALSE(std::getline(file, line));
+}
+
+INSTANTIATE_TEST_SUITE_P(FormatterThreads, LinePatternLoggerTest, ::testing::Values(0u, 2u));
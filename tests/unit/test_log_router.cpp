@@ -0,0 +1,241 @@
+// Unit tests for per-tag and per-level file routing
+
+#include <gtest/gtest.h>
+#include "speckit/log/async_logger.h"
+#include "speckit/log/log_router.h"
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+std::vector<RouteTarget> auditAndErrors() {
+    RouteTarget audit;
+    audit.name = "audit";
+    audit.tags = {"Audit", "Security"};
+    RouteTarget errors;
+    errors.name = "error";
+    errors.min_level = LogLevel::kLogLevelError;
+    return {audit, errors};
+}
+
+std::vector<std::string> readLines(const std::string& path) {
+    std::vector<std::string> lines;
+    std::ifstream file(path);
+    for (std::string line; std::getline(file, line);) {
+        lines.push_back(line);
+    }
+    return lines;
+}
+
+}  // namespace
+
+TEST(LogRouterTest, Route_CombinesTagAndLevelRules) {
+    const auto targets = auditAndErrors();
+    auto router = LogRouter::compile(targets);
+    ASSERT_NE(router, nullptr);
+
+    EXPECT_EQ(router->route("Audit", LogLevel::kLogLevelDebug), 0b01u);
+    EXPECT_EQ(router->route("Security", LogLevel::kLogLevelInfo), 0b01u);
+    EXPECT_EQ(router->route("Security", LogLevel::kLogLevelError), 0b11u);
+    EXPECT_EQ(router->route("Net", LogLevel::kLogLevelError), 0b10u);
+    EXPECT_EQ(router->route("Net", LogLevel::kLogLevelWarning), 0u);
+    // Repeated and alternating tags go through the per-thread cache
+    EXPECT_EQ(router->route("Net", LogLevel::kLogLevelWarning), 0u);
+    EXPECT_EQ(router->route("Audit", LogLevel::kLogLevelWarning), 0b01u);
+}
+
+TEST(LogRouterTest, TaggedLevelRule_NeedsBoth) {
+    RouteTarget security_errors;
+    security_errors.name = "security-errors";
+    security_errors.tags = {"Security"};
+    security_errors.min_level = LogLevel::kLogLevelWarning;
+    auto router = LogRouter::compile(std::vector<RouteTarget>{security_errors});
+    ASSERT_NE(router, nullptr);
+
+    EXPECT_EQ(router->route("Security", LogLevel::kLogLevelWarning), 1u);
+    EXPECT_EQ(router->route("Security", LogLevel::kLogLevelInfo), 0u);
+    EXPECT_EQ(router->route("Audit", LogLevel::kLogLevelError), 0u);
+}
+
+TEST(LogRouterTest, Compile_RejectsInvalidTargets) {
+    std::vector<RouteTarget> targets(1);
+    EXPECT_EQ(LogRouter::compile(targets), nullptr);  // No name
+
+    targets[0].name = "a/b";
+    EXPECT_EQ(LogRouter::compile(targets), nullptr);
+
+    targets[0].name = "1";  // Would be the first rotated main file
+    EXPECT_EQ(LogRouter::compile(targets), nullptr);
+
+    targets[0].name = "a";
+    targets.push_back(targets[0]);
+    EXPECT_EQ(LogRouter::compile(targets), nullptr);  // Duplicate
+
+    targets.assign(LogRouter::kMaxTargets + 1, RouteTarget{});
+    for (size_t i = 0; i < targets.size(); ++i) {
+        targets[i].name = "t" + std::to_string(i);
+    }
+    EXPECT_EQ(LogRouter::compile(targets), nullptr);
+    targets.pop_back();
+    EXPECT_NE(LogRouter::compile(targets), nullptr);
+}
+
+class LoggerRouteTest : public ::testing::TestWithParam<size_t> {
+protected:
+    std::filesystem::path dir_;
+
+    void SetUp() override {
+        dir_ = std::filesystem::current_path() / "logger_route_test";
+        std::filesystem::remove_all(dir_);
+        std::filesystem::create_directories(dir_);
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(dir_);
+    }
+};
+
+TEST_P(LoggerRouteTest, RoutedFilesGetTheirLines) {
+    auto logger = AsyncLogger::create((dir_ / "app").string(), 4096, GetParam());
+    ASSERT_NE(logger, nullptr);
+    ASSERT_TRUE(logger->setRoutes(auditAndErrors()));
+
+    logger->log(LogLevel::kLogLevelInfo, "Audit", "user 1 logged in");
+    logger->log(LogLevel::kLogLevelInfo, "Net", "connected");
+    logger->log(LogLevel::kLogLevelError, "Net", "connection reset");
+    logger->log(LogLevel::kLogLevelError, "Security", "bad token");
+    logger->flush();
+
+    const auto names = logger->getRouteFileNames();
+    ASSERT_EQ(names.size(), 2u);
+    // "<base>.<name>.log", or "<base>.<name>_<pid>.log" if another logger holds the name
+    EXPECT_EQ(std::filesystem::path(names[0]).filename().string().rfind("app.audit", 0), 0u) << names[0];
+    EXPECT_EQ(std::filesystem::path(names[1]).filename().string().rfind("app.error", 0), 0u) << names[1];
+
+    const auto main_lines = readLines(logger->getLogFileName());
+    const auto audit_lines = readLines(names[0]);
+    const auto error_lines = readLines(names[1]);
+    ASSERT_EQ(main_lines.size(), 4u);
+    ASSERT_EQ(audit_lines.size(), 2u);
+    ASSERT_EQ(error_lines.size(), 2u);
+
+    // Same formatted text as the main file
+    EXPECT_EQ(audit_lines[0], main_lines[0]);
+    EXPECT_EQ(audit_lines[1], main_lines[3]);
+    EXPECT_EQ(error_lines[0], main_lines[2]);
+    EXPECT_EQ(error_lines[1], main_lines[3]);
+
+    // Removing the routes leaves the files as they are
+    ASSERT_TRUE(logger->setRoutes({}));
+    logger->log(LogLevel::kLogLevelError, "Audit", "after");
+    logger->flush();
+    EXPECT_TRUE(logger->getRouteFileNames().empty());
+    EXPECT_EQ(readLines(names[0]).size(), 2u);
+    EXPECT_EQ(readLines(names[1]).size(), 2u);
+}
+
+TEST_P(LoggerRouteTest, RoutedFile_RotatesOnItsOwnLimit) {
+    auto logger = AsyncLogger::create((dir_ / "app").string(), 4096, GetParam());
+    ASSERT_NE(logger, nullptr);
+    auto targets = auditAndErrors();
+    targets[0].max_file_size = 1024;
+    ASSERT_TRUE(logger->setRoutes(targets));
+
+    for (int i = 0; i < 100; ++i) {
+        logger->log(LogLevel::kLogLevelInfo, "Audit", "audit record " + std::to_string(i));
+        logger->flush();
+    }
+
+    EXPECT_TRUE(std::filesystem::exists(dir_ / "app.audit.1.log"));
+    EXPECT_FALSE(std::filesystem::exists(dir_ / "app.1.log"));
+    EXPECT_EQ(readLines(logger->getLogFileName()).size(), 100u);
+}
+
+INSTANTIATE_TEST_SUITE_P(FormatterThreads, LoggerRouteTest, ::testing::Values(0, 2));
+
+TEST(LoggerRouteBinaryTest, BinaryFile_RoutedFilesGetText) {
+    const auto dir = std::filesystem::current_path() / "logger_route_binary_test";
+    std::filesystem::remove_all(dir);
+    {
+        auto logger = AsyncLogger::create((dir / "app").string());
+        ASSERT_NE(logger, nullptr);
+        ASSERT_TRUE(logger->setOutputFormat(LogFileFormat::kBinary));
+        ASSERT_TRUE(logger->setRoutes(auditAndErrors()));
+        logger->log(LogLevel::kLogLevelWarning, "Audit", "binary main, text audit");
+        logger->flush();
+
+        const auto names = logger->getRouteFileNames();
+        ASSERT_EQ(names.size(), 2u);
+        const auto lines = readLines(names[0]);
+        ASSERT_EQ(lines.size(), 1u);
+        EXPECT_NE(lines[0].find("[Audit]: binary main, text audit"), std::string::npos) << lines[0];
+        EXPECT_TRUE(readLines(names[1]).empty());
+    }
+    std::filesystem::remove_all(dir);
+}
+
+TEST(LoggerRouteRulesTest, InvalidRules_KeepOldRoutes) {
+    const auto dir = std::filesystem::current_path() / "logger_route_invalid_test";
+    std::filesystem::remove_all(dir);
+    {
+        auto logger = AsyncLogger::create((dir / "app").string());
+        ASSERT_NE(logger, nullptr);
+        ASSERT_TRUE(logger->setRoutes(auditAndErrors()));
+        std::vector<RouteTarget> invalid(1);
+        EXPECT_FALSE(logger->setRoutes(invalid));
+        EXPECT_EQ(logger->getRouteFileNames().size(), 2u);
+    }
+    std::filesystem::remove_all(dir);
+}
+
+TEST(LoggerRouteRulesTest, UnopenableFile_KeepsOldRoutes) {
+    const auto dir = std::filesystem::current_path() / "logger_route_unopenable_test";
+    std::filesystem::remove_all(dir);
+    {
+        auto logger = AsyncLogger::create((dir / "app").string());
+        ASSERT_NE(logger, nullptr);
+        ASSERT_TRUE(logger->setRoutes(auditAndErrors()));
+        const auto names = logger->getRouteFileNames();
+
+        // A directory in the way of the new file
+        std::filesystem::create_directories(dir / "app.blocked.log");
+        auto targets = auditAndErrors();
+        targets.push_back(RouteTarget{});
+        targets.back().name = "blocked";
+        EXPECT_FALSE(logger->setRoutes(targets));
+        EXPECT_EQ(logger->getRouteFileNames(), names);
+
+        logger->log(LogLevel::kLogLevelError, "Audit", "still routed");
+        logger->flush();
+        EXPECT_EQ(readLines(names[0]).size(), 1u);
+        EXPECT_EQ(readLines(names[1]).size(), 1u);
+    }
+    std::filesystem::remove_all(dir);
+}
+
+TEST(LoggerRouteRulesTest, KeptName_KeepsItsFile) {
+    const auto dir = std::filesystem::current_path() / "logger_route_kept_test";
+    std::filesystem::remove_all(dir);
+    {
+        auto logger = AsyncLogger::create((dir / "app").string());
+        ASSERT_NE(logger, nullptr);
+        ASSERT_TRUE(logger->setRoutes(auditAndErrors()));
+        const auto names = logger->getRouteFileNames();
+        logger->log(LogLevel::kLogLevelInfo, "Audit", "first");
+
+        RouteTarget audit;
+        audit.name = "audit";
+        audit.min_level = LogLevel::kLogLevelWarning;
+        ASSERT_TRUE(logger->setRoutes({audit}));
+        logger->log(LogLevel::kLogLevelWarning, "Net", "second");
+        logger->flush();
+
+        const auto kept = logger->getRouteFileNames();
+        ASSERT_EQ(kept.size(), 1u);
+        EXPECT_EQ(kept[0], names[0]);
+        EXPECT_EQ(readLines(kept[0]).size(), 2u);
+    }
+    std::filesystem::remove_all(dir);
+}
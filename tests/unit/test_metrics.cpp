@@ -0,0 +1,152 @@
+// Unit tests for runtime metrics
+
+#include <gtest/gtest.h>
+#include "speckit/log/metrics.h"
+#include "speckit/log/async_logger.h"
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+TEST(HistogramTest, SmallValues_ExactBuckets) {
+    for (uint64_t v = 0; v < Histogram::kSubBucketCount; ++v) {
+        EXPECT_EQ(Histogram::bucketIndex(v), v);
+        EXPECT_EQ(Histogram::bucketUpperBound(v), v);
+    }
+}
+
+TEST(HistogramTest, BucketBounds_ContainValue) {
+    const uint64_t samples[] = {16, 17, 31, 32, 100, 1000, 123456789, UINT64_MAX / 3, UINT64_MAX};
+    for (uint64_t v : samples) {
+        size_t index = Histogram::bucketIndex(v);
+        ASSERT_LT(index, Histogram::kBucketCount);
+        EXPECT_GE(Histogram::bucketUpperBound(index), v);
+        if (index > 0) {
+            EXPECT_LT(Histogram::bucketUpperBound(index - 1), v);
+        }
+    }
+    EXPECT_EQ(Histogram::bucketUpperBound(Histogram::kBucketCount - 1), UINT64_MAX);
+}
+
+TEST(HistogramTest, Percentiles_WithinRelativeError) {
+    Histogram histogram;
+    for (uint64_t v = 1; v <= 10000; ++v) {
+        histogram.record(v);
+    }
+
+    HistogramSummary summary = histogram.summarize();
+    EXPECT_EQ(summary.count, 10000u);
+    EXPECT_EQ(summary.min, 1u);
+    EXPECT_EQ(summary.max, 10000u);
+    EXPECT_DOUBLE_EQ(summary.mean, 5000.5);
+    EXPECT_NEAR(static_cast<double>(summary.p50), 5000.0, 5000.0 * 0.07);
+    EXPECT_NEAR(static_cast<double>(summary.p99), 9900.0, 9900.0 * 0.07);
+    EXPECT_LE(summary.p999, summary.max);
+}
+
+TEST(HistogramTest, MergeAndReset) {
+    Histogram a;
+    Histogram b;
+    a.record(5);
+    b.record(500);
+    a.merge(b);
+    EXPECT_EQ(a.count(), 2u);
+    EXPECT_EQ(a.summarize().max, 500u);
+
+    a.reset();
+    EXPECT_EQ(a.count(), 0u);
+    EXPECT_EQ(a.percentile(50.0), 0u);
+}
+
+TEST(LoggerMetricsTest, ShardedCounters_MergedOnRead) {
+    LoggerMetrics metrics;
+    constexpr int kThreads = 8;
+    constexpr int kPerThread = 10000;
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([&]() {
+            for (int i = 0; i < kPerThread; ++i) {
+                metrics.add(LoggerMetrics::Counter::kEntriesEnqueued);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(metrics.value(LoggerMetrics::Counter::kEntriesEnqueued),
+              static_cast<uint64_t>(kThreads) * kPerThread);
+}
+
+TEST(LoggerMetricsTest, QueueHighWater_KeepsMaximum) {
+    LoggerMetrics metrics;
+    metrics.observeQueueDepth(10);
+    metrics.observeQueueDepth(250);
+    metrics.observeQueueDepth(3);
+    EXPECT_EQ(metrics.snapshot().queue_high_water, 250u);
+}
+
+TEST(LoggerMetricsTest, FormatMetrics_ContainsAllKeys) {
+    LoggerMetrics metrics;
+    metrics.recordBatch(4);
+    std::string text = formatMetrics(metrics.snapshot());
+    for (const char* key : {"entries_enqueued", "entries_dropped", "entries_written", "bytes_written",
+                            "emergency_bytes_unstaged", "queue_high_water", "batches 1", "rotations", "batch_size count=1",
+                            "flush_latency_ns", "fsync_latency_ns", "rotation_ns"}) {
+        EXPECT_NE(text.find(key), std::string::npos) << key;
+    }
+}
+
+class AsyncLoggerMetricsTest : public ::testing::Test {
+protected:
+    std::filesystem::path dir_;
+
+    void SetUp() override {
+        dir_ = std::filesystem::current_path() / "metrics_test";
+        std::filesystem::remove_all(dir_);
+        std::filesystem::create_directories(dir_);
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(dir_);
+    }
+};
+
+TEST_F(AsyncLoggerMetricsTest, CountsEveryEntry) {
+    constexpr int kEntries = 500;
+    auto logger = AsyncLogger::create((dir_ / "metrics").string(), 64);
+    ASSERT_NE(logger, nullptr);
+
+    for (int i = 0; i < kEntries; ++i) {
+        logger->log(LogLevel::kLogLevelInfo, "Metrics", "counted message");
+    }
+    logger->deinitialize();
+
+    MetricsSnapshot snapshot = logger->getMetrics();
+    EXPECT_EQ(snapshot.entries_enqueued + snapshot.entries_dropped, static_cast<uint64_t>(kEntries));
+    EXPECT_EQ(snapshot.entries_written, snapshot.entries_enqueued);
+    EXPECT_GT(snapshot.bytes_written, 0u);
+    EXPECT_GT(snapshot.batches, 0u);
+    EXPECT_GT(snapshot.queue_high_water, 0u);
+    EXPECT_EQ(snapshot.batch_size.count, snapshot.batches);
+    EXPECT_GT(snapshot.flush_latency_ns.count, 0u);
+}
+
+TEST_F(AsyncLoggerMetricsTest, PeriodicDump_WritesFile) {
+    const std::string dump_path = (dir_ / "metrics.txt").string();
+    auto logger = AsyncLogger::create((dir_ / "dump").string());
+    ASSERT_NE(logger, nullptr);
+    ASSERT_TRUE(logger->setMetricsDump(dump_path, 20ms));
+
+    logger->log(LogLevel::kLogLevelInfo, "Metrics", "dumped");
+    logger->deinitialize();  // Writes a final dump
+
+    std::ifstream file(dump_path);
+    ASSERT_TRUE(file.is_open());
+    std::string text((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    EXPECT_NE(text.find("entries_written 1"), std::string::npos);
+}
@@ -0,0 +1,169 @@
+// Unit tests for AsyncLogger overflow policies and loss markers
+
+#include <gtest/gtest.h>
+#include "speckit/log/async_logger.h"
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+std::atomic<bool> g_gate_open{true};
+
+/// Line formatter that holds the writer until the gate opens, so the queue fills up
+std::string gatedFormatter(const LogEntry& entry) {
+    while (!g_gate_open.load()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return formatLogEntry(entry);
+}
+
+}  // namespace
+
+class OverflowPolicyTest : public ::testing::Test {
+protected:
+    static constexpr size_t kQueueSize = 64;
+
+    std::filesystem::path dir_;
+    std::unique_ptr<AsyncLogger> logger_;
+
+    void SetUp() override {
+        dir_ = std::filesystem::current_path() / "overflow_policy_test";
+        std::filesystem::remove_all(dir_);
+        std::filesystem::create_directories(dir_);
+        logger_ = AsyncLogger::create((dir_ / "overflow").string(), kQueueSize);
+        ASSERT_NE(logger_, nullptr);
+        logger_->setLineFormatter(gatedFormatter);
+    }
+
+    void TearDown() override {
+        g_gate_open = true;
+        logger_.reset();
+        std::filesystem::remove_all(dir_);
+    }
+
+    /// Park the writer inside the formatter with an empty queue behind it
+    void stallWriter() {
+        g_gate_open = false;
+        logger_->log(LogLevel::kLogLevelInfo, "Gate", "stall");
+        while (logger_->getMetrics().entries_written == 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+
+    /// Release the writer, stop the logger and return the messages written after the stall
+    std::vector<std::string> finish(std::string* marker = nullptr) {
+        g_gate_open = true;
+        const std::string file_name = logger_->getLogFileName();
+        logger_->deinitialize();
+
+        std::vector<std::string> messages;
+        std::ifstream file(file_name);
+        for (std::string line; std::getline(file, line);) {
+            if (line.find(AsyncLogger::kLossMarkerTag) != std::string::npos) {
+                if (marker) {
+                    *marker = line;
+                }
+            } else if (line.find("[Gate]") == std::string::npos) {
+                messages.push_back(line.substr(line.find("]: ") + 3));
+            }
+        }
+        return messages;
+    }
+
+    void logNumbered(int from, int to, LogLevel level = LogLevel::kLogLevelInfo) {
+        for (int i = from; i < to; ++i) {
+            logger_->log(level, "Test", std::to_string(i));
+        }
+    }
+};
+
+TEST_F(OverflowPolicyTest, DropNewest_KeepsFirstEntriesAndReportsLoss) {
+    EXPECT_EQ(logger_->getOverflowPolicy().mode, OverflowMode::kDropNewest);
+    stallWriter();
+    logNumbered(0, 200);
+
+    const MetricsSnapshot snapshot = logger_->getMetrics();
+    EXPECT_EQ(snapshot.entries_dropped, 200 - kQueueSize);
+    EXPECT_EQ(snapshot.dropped_by_level[static_cast<size_t>(LogLevel::kLogLevelInfo)], 200 - kQueueSize);
+
+    std::string marker;
+    const auto messages = finish(&marker);
+    ASSERT_EQ(messages.size(), kQueueSize);
+    for (size_t i = 0; i < messages.size(); ++i) {
+        EXPECT_EQ(messages[i], std::to_string(i));
+    }
+    EXPECT_EQ(marker.rfind("[WARNING]", 0), 0u) << marker;
+    EXPECT_NE(marker.find("[SpeckitLog]: 136 entries dropped (INFO=136)"), std::string::npos) << marker;
+}
+
+TEST_F(OverflowPolicyTest, DropOldest_KeepsLatestEntries) {
+    logger_->setOverflowPolicy({OverflowMode::kDropOldest});
+    stallWriter();
+    logNumbered(0, 200);
+    EXPECT_EQ(logger_->getMetrics().entries_dropped, 200 - kQueueSize);
+
+    const auto messages = finish();
+    ASSERT_EQ(messages.size(), kQueueSize);
+    for (size_t i = 0; i < messages.size(); ++i) {
+        EXPECT_EQ(messages[i], std::to_string(200 - kQueueSize + i));
+    }
+}
+
+TEST_F(OverflowPolicyTest, DropBelowLevel_ReservesRoomForImportantEntries) {
+    logger_->setOverflowPolicy({OverflowMode::kDropBelowLevel, std::chrono::microseconds(0),
+                                LogLevel::kLogLevelWarning});
+    stallWriter();
+    logNumbered(0, 100, LogLevel::kLogLevelDebug);
+    logNumbered(100, 110, LogLevel::kLogLevelError);
+
+    // DEBUG stops at 3/4 of the queue; every ERROR fits in the last quarter
+    const MetricsSnapshot snapshot = logger_->getMetrics();
+    EXPECT_EQ(snapshot.dropped_by_level[static_cast<size_t>(LogLevel::kLogLevelDebug)], 100 - kQueueSize * 3 / 4);
+    EXPECT_EQ(snapshot.dropped_by_level[static_cast<size_t>(LogLevel::kLogLevelError)], 0u);
+
+    std::string marker;
+    const auto messages = finish(&marker);
+    ASSERT_EQ(messages.size(), kQueueSize * 3 / 4 + 10);
+    EXPECT_EQ(messages.back(), "109");
+    EXPECT_NE(marker.find("52 entries dropped (DEBUG=52)"), std::string::npos) << marker;
+}
+
+TEST_F(OverflowPolicyTest, Block_WaitsForRoomUpToTimeout) {
+    logger_->setOverflowPolicy({OverflowMode::kBlock, std::chrono::milliseconds(20)});
+    stallWriter();
+    logNumbered(0, kQueueSize);
+
+    // Full and the writer is held: waits out the timeout, then drops
+    const auto start = std::chrono::steady_clock::now();
+    logger_->log(LogLevel::kLogLevelInfo, "Test", "timed out");
+    EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(20));
+    EXPECT_EQ(logger_->getMetrics().dropped_by_level[static_cast<size_t>(LogLevel::kLogLevelInfo)], 1u);
+
+    // Room appears while waiting: the entry gets in
+    logger_->setOverflowPolicy({OverflowMode::kBlock, std::chrono::seconds(10)});
+    std::thread opener([]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        g_gate_open = true;
+    });
+    logger_->log(LogLevel::kLogLevelInfo, "Test", "waited");
+    opener.join();
+    EXPECT_EQ(logger_->getMetrics().entries_dropped, 1u);
+
+    std::string marker;
+    const auto messages = finish(&marker);
+    ASSERT_EQ(messages.size(), kQueueSize + 1);
+    EXPECT_EQ(messages.back(), "waited");
+    EXPECT_NE(marker.find("1 entries dropped (INFO=1)"), std::string::npos) << marker;
+}
+
+TEST_F(OverflowPolicyTest, NoDrops_NoMarker) {
+    logNumbered(0, 10);
+    std::string marker;
+    EXPECT_EQ(finish(&marker).size(), 10u);
+    EXPECT_TRUE(marker.empty()) << marker;
+}
@@ -0,0 +1,131 @@
+// Unit tests for PayloadArena
+
+#include <gtest/gtest.h>
+#include "speckit/log/payload_arena.h"
+#include "speckit/log/tuned_async_queue.h"
+#include "speckit/log/log_level.h"
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+LogEntry makeEntry(const std::string& message) {
+    return LogEntry::createOwned(LogLevel::kLogLevelInfo, 12345, 1234, ThreadIdType{}, "Arena", message);
+}
+
+/// Create @p count entries on a short-lived thread, which retires its chunk on exit
+std::vector<LogEntry> makeEntriesOnThread(int count) {
+    std::vector<LogEntry> entries;
+    std::thread([&]() {
+        for (int i = 0; i < count; ++i) {
+            entries.push_back(makeEntry(std::string(100, 'a' + i % 26) + std::to_string(i)));
+        }
+    }).join();
+    return entries;
+}
+
+}  // namespace
+
+TEST(PayloadArenaTest, ConsumedChunks_AreRecycled) {
+    PayloadArena& arena = PayloadArena::global();
+    const size_t in_use_before = arena.getStats().chunks_in_use;
+
+    // About 120 bytes per entry: several chunks
+    auto entries = makeEntriesOnThread(2000);
+    const PayloadArenaStats filled = arena.getStats();
+    EXPECT_GE(filled.chunks_in_use, in_use_before + 3);
+    for (int i = 0; i < 2000; ++i) {
+        ASSERT_NE(entries[i].storage.get_deleter().chunk, nullptr);
+        ASSERT_EQ(entries[i].message, std::string(100, 'a' + i % 26) + std::to_string(i));
+        ASSERT_EQ(entries[i].tag, "Arena");
+    }
+
+    // Released by the consumer: every chunk goes back to the free list
+    entries.clear();
+    EXPECT_EQ(arena.getStats().chunks_in_use, in_use_before);
+
+    // The next round reuses them instead of creating more
+    entries = makeEntriesOnThread(2000);
+    entries.clear();
+    EXPECT_EQ(arena.getStats().chunks_allocated, filled.chunks_allocated);
+}
+
+TEST(PayloadArenaTest, BudgetAndOversize_FallBackToHeap) {
+    PayloadArena& arena = PayloadArena::global();
+    const PayloadArenaStats before = arena.getStats();
+
+    arena.setMemoryBudget(0);
+    EXPECT_EQ(arena.getMemoryBudget(), 0u);
+    std::vector<LogEntry> entries;
+    std::thread([&]() {
+        // A new thread owns no chunk; with the free list drained it has to fail
+        for (int i = 0; i < 200; ++i) {
+            entries.push_back(makeEntry("budget"));
+        }
+    }).join();
+    arena.setMemoryBudget(PayloadArena::kDefaultMemoryBudget);
+
+    size_t heap_entries = 0;
+    for (const auto& entry : entries) {
+        EXPECT_EQ(entry.message, "budget");
+        heap_entries += entry.storage.get_deleter().chunk == nullptr;
+    }
+    const PayloadArenaStats after = arena.getStats();
+    EXPECT_EQ(after.allocation_failures - before.allocation_failures, heap_entries);
+    if (before.chunks_allocated == before.chunks_in_use) {
+        EXPECT_EQ(heap_entries, entries.size());  // Nothing was free to reuse
+    }
+
+    const LogEntry large = makeEntry(std::string(PayloadArena::kMaxPayloadBytes + 1, 'x'));
+    EXPECT_EQ(large.storage.get_deleter().chunk, nullptr);
+    EXPECT_EQ(large.message.size(), PayloadArena::kMaxPayloadBytes + 1);
+    EXPECT_EQ(arena.getStats().oversize_allocations, after.oversize_allocations + 1);
+}
+
+TEST(PayloadArenaTest, ConcurrentProducers_WriterReleases) {
+    PayloadArena& arena = PayloadArena::global();
+    const size_t in_use_before = arena.getStats().chunks_in_use;
+
+    constexpr int kProducers = 4;
+    constexpr int kPerProducer = 5000;
+    TunedAsyncQueue queue(1024);
+    std::atomic<int> done{0};
+    std::vector<std::thread> producers;
+    for (int p = 0; p < kProducers; ++p) {
+        producers.emplace_back([&, p]() {
+            for (int i = 0; i < kPerProducer; ++i) {
+                LogEntry entry = makeEntry(std::to_string(p) + ":" + std::to_string(i));
+                while (!queue.tryPush(entry)) {
+                    std::this_thread::yield();
+                }
+            }
+            done.fetch_add(1);
+        });
+    }
+
+    // Single consumer, releasing payloads as it goes
+    std::vector<int> next(kProducers, 0);
+    std::vector<LogEntry> batch(64);
+    int consumed = 0;
+    while (consumed < kProducers * kPerProducer) {
+        const size_t count = queue.drainInto(batch);
+        for (size_t i = 0; i < count; ++i) {
+            const std::string message(batch[i].message);
+            const int p = std::stoi(message.substr(0, message.find(':')));
+            ASSERT_EQ(message, std::to_string(p) + ":" + std::to_string(next[p]));
+            ++next[p];
+            batch[i].storage.reset();
+        }
+        consumed += static_cast<int>(count);
+        if (count == 0) {
+            std::this_thread::yield();
+        }
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+    EXPECT_EQ(done.load(), kProducers);
+    EXPECT_EQ(arena.getStats().chunks_in_use, in_use_before);
+}
@@ -0,0 +1,168 @@
+// Unit tests for LaneMerger and AsyncLogger priority lanes
+
+#include <gtest/gtest.h>
+#include "speckit/log/lane_merger.h"
+#include "speckit/log/async_logger.h"
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+std::atomic<bool> g_gate_open{true};
+
+/// Line formatter that holds the writer until the gate opens
+std::string gatedFormatter(const LogEntry& entry) {
+    while (!g_gate_open.load()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return formatLogEntry(entry);
+}
+
+LogEntry makeEntry(int64_t timestamp_ms, const std::string& message) {
+    return LogEntry::createOwned(LogLevel::kLogLevelInfo, timestamp_ms, 1234, ThreadIdType{}, "Lane", message);
+}
+
+/// Messages of the ERROR lines in @p file_name
+std::set<std::string> readErrorMessages(const std::string& file_name) {
+    std::set<std::string> messages;
+    std::ifstream file(file_name);
+    for (std::string line; std::getline(file, line);) {
+        if (line.rfind("[ERROR]", 0) == 0) {
+            messages.insert(line.substr(line.find("]: ") + 3));
+        }
+    }
+    return messages;
+}
+
+}  // namespace
+
+TEST(LaneMergerTest, DrainInto_MergesLanesByTimestamp) {
+    TunedAsyncQueue priority(16);
+    TunedAsyncQueue bulk(16);
+    LaneMerger lanes(priority, bulk);
+    EXPECT_TRUE(lanes.isEmpty());
+
+    for (int64_t ts : {1, 3, 5, 7}) {
+        ASSERT_TRUE(bulk.tryPush(makeEntry(ts, "b" + std::to_string(ts))));
+    }
+    for (int64_t ts : {2, 3, 8}) {
+        ASSERT_TRUE(priority.tryPush(makeEntry(ts, "p" + std::to_string(ts))));
+    }
+    EXPECT_EQ(lanes.size(), 7u);
+
+    std::vector<LogEntry> out(16);
+    ASSERT_EQ(lanes.drainInto(out), 7u);
+    const std::vector<std::string> expected = {"b1", "p2", "b3", "p3", "b5", "b7", "p8"};
+    for (size_t i = 0; i < expected.size(); ++i) {
+        EXPECT_EQ(out[i].message, expected[i]) << "position " << i;
+    }
+    EXPECT_TRUE(lanes.isEmpty());
+}
+
+TEST(LaneMergerTest, DrainInto_PriorityFirstAcrossBatches) {
+    TunedAsyncQueue priority(16);
+    TunedAsyncQueue bulk(16);
+    LaneMerger lanes(priority, bulk);
+
+    for (int64_t ts : {1, 2, 3, 4}) {
+        ASSERT_TRUE(bulk.tryPush(makeEntry(ts, "b" + std::to_string(ts))));
+    }
+    ASSERT_TRUE(priority.tryPush(makeEntry(5, "p5")));
+
+    // The batch is the reordering window: the priority entry goes out with the first one
+    std::vector<LogEntry> out(2);
+    ASSERT_EQ(lanes.drainInto(out), 2u);
+    EXPECT_EQ(out[0].message, "b1");
+    EXPECT_EQ(out[1].message, "p5");
+    ASSERT_EQ(lanes.drainInto(out), 2u);
+    EXPECT_EQ(out[0].message, "b2");
+    EXPECT_EQ(out[1].message, "b3");
+}
+
+class PriorityLaneTest : public ::testing::Test {
+protected:
+    std::filesystem::path dir_;
+
+    void SetUp() override {
+        dir_ = std::filesystem::current_path() / "priority_lane_test";
+        std::filesystem::remove_all(dir_);
+        std::filesystem::create_directories(dir_);
+    }
+
+    void TearDown() override {
+        g_gate_open = true;
+        std::filesystem::remove_all(dir_);
+    }
+};
+
+TEST_F(PriorityLaneTest, DebugFlood_WriterStalled_EveryErrorLands) {
+    auto logger = AsyncLogger::create((dir_ / "stalled").string(), 1024);
+    ASSERT_NE(logger, nullptr);
+    logger->setLineFormatter(gatedFormatter);
+
+    // Park the writer with the queue empty behind it
+    g_gate_open = false;
+    logger->log(LogLevel::kLogLevelInfo, "Gate", "stall");
+    while (logger->getMetrics().entries_written == 0) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    // The main queue fills up with DEBUG; later ERRORs still have their own lane
+    for (int i = 0; i < 10000; ++i) {
+        logger->log(LogLevel::kLogLevelDebug, "Flood", std::to_string(i));
+        if (i % 100 == 0) {
+            logger->log(LogLevel::kLogLevelError, "Alert", std::to_string(i / 100));
+        }
+    }
+    const MetricsSnapshot snapshot = logger->getMetrics();
+    // 11 ERRORs (i = 0..1000) were queued before the main queue filled up
+    EXPECT_EQ(snapshot.dropped_by_level[static_cast<size_t>(LogLevel::kLogLevelDebug)], 10000u - (1024u - 11u));
+    EXPECT_EQ(snapshot.dropped_by_level[static_cast<size_t>(LogLevel::kLogLevelError)], 0u);
+
+    g_gate_open = true;
+    const std::string file_name = logger->getLogFileName();
+    logger->deinitialize();
+
+    const auto errors = readErrorMessages(file_name);
+    EXPECT_EQ(errors.size(), 100u);
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_EQ(errors.count(std::to_string(i)), 1u) << "ERROR " << i << " missing";
+    }
+}
+
+TEST_F(PriorityLaneTest, DebugFlood_ConcurrentProducers_EveryErrorLands) {
+    auto logger = AsyncLogger::create((dir_ / "flood").string(), 256);
+    ASSERT_NE(logger, nullptr);
+
+    std::atomic<bool> flooding{true};
+    std::vector<std::thread> flooders;
+    for (int t = 0; t < 3; ++t) {
+        flooders.emplace_back([&]() {
+            std::string message(200, 'd');
+            while (flooding.load(std::memory_order_relaxed)) {
+                logger->log(LogLevel::kLogLevelDebug, "Flood", message);
+            }
+        });
+    }
+
+    constexpr int kErrors = 200;
+    for (int i = 0; i < kErrors; ++i) {
+        logger->log(LogLevel::kLogLevelError, "Alert", std::to_string(i));
+        std::this_thread::sleep_for(std::chrono::microseconds(200));
+    }
+    flooding = false;
+    for (auto& flooder : flooders) {
+        flooder.join();
+    }
+
+    EXPECT_EQ(logger->getMetrics().dropped_by_level[static_cast<size_t>(LogLevel::kLogLevelError)], 0u);
+    const std::string file_name = logger->getLogFileName();
+    logger->deinitialize();
+    EXPECT_EQ(readErrorMessages(file_name).size(), static_cast<size_t>(kErrors));
+}
@@ -0,0 +1,246 @@
+// Unit tests for per-call-site rate limiting and repeat collapsing
+
+#include <gtest/gtest.h>
+#include "speckit/log/rate_limiter.h"
+#include "speckit/log/repeat_collapser.h"
+#include "speckit/log/async_logger.h"
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <source_location>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+using speckit::log::CallSiteRateLimiter;
+using speckit::log::RateLimit;
+using speckit::log::TagFilter;
+
+namespace {
+
+std::source_location siteA() { return std::source_location::current(); }
+std::source_location siteB() { return std::source_location::current(); }
+
+LogEntry makeEntry(const std::string& tag, const std::string& message) {
+    return LogEntry::createOwned(LogLevel::kLogLevelInfo, 12345, 1234, ThreadIdType{}, tag, message);
+}
+
+std::vector<std::string> messagesOf(std::span<LogEntry> batch) {
+    std::vector<std::string> messages;
+    for (const auto& entry : batch) {
+        messages.emplace_back(entry.message);
+    }
+    return messages;
+}
+
+}  // namespace
+
+TEST(CallSiteRateLimiterTest, BurstThenThrottled_PerSite) {
+    TagFilter filter;
+    filter.setTagRateLimit("Hot", RateLimit{10, 5});  // One token every 100 ms
+    CallSiteRateLimiter limiter;
+
+    int allowed_a = 0;
+    int allowed_b = 0;
+    for (int i = 0; i < 100; ++i) {
+        allowed_a += limiter.tryAcquire(siteA(), "Hot", filter);
+        allowed_b += limiter.tryAcquire(siteB(), "Hot", filter);
+    }
+    EXPECT_EQ(allowed_a, 5);
+    EXPECT_EQ(allowed_b, 5);  // Each call site has its own bucket
+
+    // Tags without a limit are never throttled
+    for (int i = 0; i < 100; ++i) {
+        ASSERT_TRUE(limiter.tryAcquire(siteA(), "Cold", filter));
+    }
+
+    // Changing the rules takes effect at once, with a full burst
+    filter.setTagRateLimit("Hot", RateLimit{10, 2});
+    EXPECT_TRUE(limiter.tryAcquire(siteA(), "Hot", filter));
+    EXPECT_TRUE(limiter.tryAcquire(siteA(), "Hot", filter));
+    EXPECT_FALSE(limiter.tryAcquire(siteA(), "Hot", filter));
+}
+
+TEST(CallSiteRateLimiterTest, TokensRefillAtTheConfiguredRate) {
+    TagFilter filter;
+    filter.setTagRateLimit("Hot", RateLimit{100, 1});  // One token every 10 ms
+    CallSiteRateLimiter limiter;
+
+    EXPECT_TRUE(limiter.tryAcquire(siteA(), "Hot", filter));
+    EXPECT_FALSE(limiter.tryAcquire(siteA(), "Hot", filter));
+    std::this_thread::sleep_for(std::chrono::milliseconds(15));
+    EXPECT_TRUE(limiter.tryAcquire(siteA(), "Hot", filter));
+    EXPECT_FALSE(limiter.tryAcquire(siteA(), "Hot", filter));
+}
+
+TEST(CallSiteRateLimiterTest, SwappedFilter_ItsOwnLimitsApply) {
+    // Same number of setter calls on each filter
+    TagFilter strict;
+    strict.setTagRateLimit("Hot", RateLimit{1, 1});
+    TagFilter loose;
+    loose.setTagRateLimit("Hot", RateLimit{1, 5});
+    CallSiteRateLimiter limiter;
+
+    auto allowed = [&](const TagFilter& filter) {
+        int count = 0;
+        for (int i = 0; i < 20; ++i) {
+            count += limiter.tryAcquire(siteA(), "Hot", filter);
+        }
+        return count;
+    };
+    EXPECT_EQ(allowed(strict), 1);
+    EXPECT_EQ(allowed(loose), 5);
+    EXPECT_EQ(allowed(strict), 1);
+}
+
+TEST(CallSiteRateLimiterTest, CollidingSites_NeverGetANewBurst) {
+    // More sites than half the table, so many share a hash slot
+    TagFilter filter;
+    std::vector<std::string> tags;
+    for (size_t i = 0; i < CallSiteRateLimiter::kSlotCount * 3 / 4; ++i) {
+        tags.push_back("Site" + std::to_string(i));
+        filter.setTagRateLimit(tags.back(), RateLimit{1, 1});
+    }
+    CallSiteRateLimiter limiter;
+
+    size_t first_pass = 0;
+    for (const auto& tag : tags) {
+        first_pass += limiter.tryAcquire(siteA(), tag, filter);
+    }
+    // Most sites find a slot of their own within the probe
+    EXPECT_GT(first_pass, tags.size() * 3 / 4);
+
+    // Within the second nobody may log again, however the sites were placed
+    size_t second_pass = 0;
+    for (const auto& tag : tags) {
+        second_pass += limiter.tryAcquire(siteA(), tag, filter);
+    }
+    EXPECT_EQ(second_pass, 0u);
+}
+
+TEST(RepeatCollapserTest, Collapse_ReplacesRunsWithMarker) {
+    TagFilter filter;
+    filter.setTagCollapseRepeats("Loop", true);
+    RepeatCollapser collapser;
+
+    std::vector<LogEntry> batch;
+    for (const char* message : {"a", "a", "a", "b", "c", "c"}) {
+        batch.push_back(makeEntry("Loop", message));
+    }
+    CollapseResult result = collapser.collapse(batch, filter);
+    EXPECT_EQ(result.removed, 3u);
+    ASSERT_EQ(result.size, 5u);
+    EXPECT_EQ(messagesOf(std::span(batch).first(result.size)),
+              (std::vector<std::string>{"a", "last message repeated 2 times", "b", "c",
+                                        "last message repeated 1 times"}));
+    EXPECT_EQ(batch[1].tag, "Loop");
+
+    // The last entry is remembered for the next batch
+    batch.clear();
+    batch.push_back(makeEntry("Loop", "c"));
+    batch.push_back(makeEntry("Loop", "d"));
+    result = collapser.collapse(batch, filter);
+    EXPECT_EQ(messagesOf(std::span(batch).first(result.size)),
+              (std::vector<std::string>{"last message repeated 1 times", "d"}));
+}
+
+TEST(RepeatCollapserTest, Collapse_OnlyConfiguredTags) {
+    TagFilter filter;
+    filter.setTagCollapseRepeats("Loop", true);
+    RepeatCollapser collapser;
+
+    std::vector<LogEntry> batch;
+    batch.push_back(makeEntry("Other", "x"));
+    batch.push_back(makeEntry("Other", "x"));
+    batch.push_back(makeEntry("Loop", "x"));
+    batch.push_back(makeEntry("Other", "x"));
+    batch.push_back(LogEntry::createOwned(LogLevel::kLogLevelError, 1, 1, ThreadIdType{}, "Other", "x"));
+    const CollapseResult result = collapser.collapse(batch, filter);
+    EXPECT_EQ(result.removed, 0u);
+    EXPECT_EQ(result.size, batch.size());
+}
+
+class TagFilterLoggerTest : public ::testing::Test {
+protected:
+    std::filesystem::path dir_;
+
+    void SetUp() override {
+        dir_ = std::filesystem::current_path() / "rate_limit_test";
+        std::filesystem::remove_all(dir_);
+        std::filesystem::create_directories(dir_);
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(dir_);
+    }
+
+    static std::vector<std::string> readMessages(const std::string& file_name) {
+        std::vector<std::string> messages;
+        std::ifstream file(file_name);
+        for (std::string line; std::getline(file, line);) {
+            messages.push_back(line.substr(line.find("]: ") + 3));
+        }
+        return messages;
+    }
+};
+
+TEST_F(TagFilterLoggerTest, HotLoop_RateLimitedPerCallSite) {
+    TagFilter filter;
+    filter.setTagRateLimit("Hot", RateLimit{1, 20});
+    filter.setTagEnabled("Muted", false);
+    auto logger = AsyncLogger::create((dir_ / "hot").string());
+    ASSERT_NE(logger, nullptr);
+    logger->setTagFilter(&filter);
+
+    for (int i = 0; i < 100000; ++i) {
+        logger->log(LogLevel::kLogLevelInfo, "Hot", "spinning");
+    }
+    logger->log(LogLevel::kLogLevelInfo, "Hot", "other site");
+    logger->log(LogLevel::kLogLevelInfo, "Muted", "hidden");
+    logger->log(LogLevel::kLogLevelInfo, "Cold", "unlimited");
+
+    const std::string file_name = logger->getLogFileName();
+    logger->deinitialize();
+    EXPECT_EQ(logger->getMetrics().entries_rate_limited, 100000u - 20u);
+
+    const auto messages = readMessages(file_name);
+    ASSERT_EQ(messages.size(), 22u);
+    EXPECT_EQ(messages[20], "other site");
+    EXPECT_EQ(messages[21], "unlimited");
+}
+
+TEST_F(TagFilterLoggerTest, RepeatedLines_CollapsedByWriter) {
+    TagFilter filter;
+    filter.setTagCollapseRepeats("Loop", true);
+    auto logger = AsyncLogger::create((dir_ / "repeat").string());
+    ASSERT_NE(logger, nullptr);
+    logger->setTagFilter(&filter);
+
+    for (int i = 0; i < 1000; ++i) {
+        logger->log(LogLevel::kLogLevelInfo, "Loop", "same");
+    }
+    logger->log(LogLevel::kLogLevelInfo, "Loop", "done");
+
+    const std::string file_name = logger->getLogFileName();
+    logger->deinitialize();
+    const MetricsSnapshot snapshot = logger->getMetrics();
+    EXPECT_EQ(snapshot.entries_written + snapshot.repeats_collapsed, 1001u);
+
+    // Depending on how the writer batched them: "same", then one or more markers
+    const auto messages = readMessages(file_name);
+    ASSERT_GE(messages.size(), 3u);
+    EXPECT_EQ(messages.front(), "same");
+    EXPECT_EQ(messages.back(), "done");
+    uint64_t repeats = 0;
+    for (size_t i = 1; i + 1 < messages.size(); ++i) {
+        if (messages[i] == "same") {
+            continue;  // A batch boundary between two runs of the same line
+        }
+        unsigned count = 0;
+        ASSERT_EQ(std::sscanf(messages[i].c_str(), "last message repeated %u times", &count), 1) << messages[i];
+        repeats += count;
+    }
+    EXPECT_EQ(repeats, snapshot.repeats_collapsed);
+}
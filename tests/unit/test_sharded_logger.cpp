@@ -0,0 +1,115 @@
+// Unit tests for ShardedLogger
+
+#include <gtest/gtest.h>
+#include "speckit/log/sharded_logger.h"
+#include <filesystem>
+#include <fstream>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+class ShardedLoggerTest : public ::testing::Test {
+protected:
+    std::filesystem::path dir_;
+
+    void SetUp() override {
+        dir_ = std::filesystem::current_path() / "sharded_logger_test";
+        std::filesystem::remove_all(dir_);
+        std::filesystem::create_directories(dir_);
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(dir_);
+    }
+};
+
+TEST_F(ShardedLoggerTest, Create_OneFilePerShard) {
+    EXPECT_EQ(ShardedLogger::create((dir_ / "none").string(), 0), nullptr);
+
+    auto logger = ShardedLogger::create((dir_ / "files").string(), 3);
+    ASSERT_NE(logger, nullptr);
+    EXPECT_EQ(logger->shardCount(), 3u);
+
+    const auto names = logger->getLogFileNames();
+    ASSERT_EQ(names.size(), 3u);
+    EXPECT_EQ(std::set<std::string>(names.begin(), names.end()).size(), 3u);
+    for (size_t i = 0; i < names.size(); ++i) {
+        EXPECT_NE(names[i].find(".shard" + std::to_string(i)), std::string::npos) << names[i];
+    }
+
+    logger->setLogLevel(LogLevel::kLogLevelWarning);
+    EXPECT_EQ(logger->getLogLevel(), LogLevel::kLogLevelWarning);
+    for (size_t i = 0; i < logger->shardCount(); ++i) {
+        EXPECT_EQ(logger->shard(i).getLogLevel(), LogLevel::kLogLevelWarning);
+    }
+    logger->deinitialize();
+}
+
+TEST_F(ShardedLoggerTest, ShardsBeyondTheSlotCap_ReportedWithoutCrashReplay) {
+    const size_t shards = CrashHandler::kMaxEmergencyBuffers + 2;
+    auto logger = ShardedLogger::create((dir_ / "slots").string(), shards);
+    ASSERT_NE(logger, nullptr);
+
+    // Other loggers alive in the process may hold some of the slots
+    EXPECT_LE(logger->crashReplayShardCount(), CrashHandler::kMaxEmergencyBuffers);
+    EXPECT_LT(logger->crashReplayShardCount(), logger->shardCount());
+    logger->deinitialize();
+}
+
+TEST_F(ShardedLoggerTest, ThreadMapping_EachThreadInOneShardInOrder) {
+    constexpr size_t kShards = 4;
+    constexpr int kThreads = 8;
+    constexpr int kPerThread = 500;
+
+    auto logger = ShardedLogger::create((dir_ / "order").string(), kShards);
+    ASSERT_NE(logger, nullptr);
+
+    std::vector<std::thread> producers;
+    for (int t = 0; t < kThreads; ++t) {
+        producers.emplace_back([&logger, t]() {
+            for (int i = 0; i < kPerThread; ++i) {
+                logger->log(LogLevel::kLogLevelInfo, "Shard",
+                            "t" + std::to_string(t) + " i" + std::to_string(i) + " end");
+            }
+        });
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+
+    const auto names = logger->getLogFileNames();
+    logger->deinitialize();
+
+    uint64_t written = 0;
+    for (const auto& snapshot : logger->getShardMetrics()) {
+        EXPECT_EQ(snapshot.entries_dropped, 0u);
+        written += snapshot.entries_written;
+    }
+    EXPECT_EQ(written, static_cast<uint64_t>(kThreads * kPerThread));
+
+    // Every thread lands in exactly one shard file, with its lines in order
+    std::vector<int> shard_of(kThreads, -1);
+    std::vector<int> next(kThreads, 0);
+    for (size_t s = 0; s < names.size(); ++s) {
+        std::ifstream file(names[s]);
+        for (std::string line; std::getline(file, line);) {
+            const size_t t_pos = line.find(" t");
+            const size_t i_pos = line.find(" i", t_pos + 2);
+            ASSERT_NE(t_pos, std::string::npos) << line;
+            ASSERT_NE(i_pos, std::string::npos) << line;
+            const int t = std::stoi(line.substr(t_pos + 2));
+            const int i = std::stoi(line.substr(i_pos + 2));
+
+            if (shard_of[t] < 0) {
+                shard_of[t] = static_cast<int>(s);
+            }
+            EXPECT_EQ(shard_of[t], static_cast<int>(s)) << "thread " << t;
+            EXPECT_EQ(i, next[t]) << "thread " << t;
+            next[t] = i + 1;
+        }
+    }
+    for (int t = 0; t < kThreads; ++t) {
+        EXPECT_EQ(next[t], kPerThread) << "thread " << t;
+    }
+}
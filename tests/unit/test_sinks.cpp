@@ -0,0 +1,317 @@
+// Unit tests for log sinks and the sink fan-out
+
+#include <gtest/gtest.h>
+#include "speckit/log/async_logger.h"
+#include "speckit/log/log_sink.h"
+#include "speckit/log/sink_fanout.h"
+#include "speckit/log/platform.h"
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifndef SPECKIT_PLATFORM_WINDOWS
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+/// Append one line per level to @p batch
+void addLines(SinkBatch& batch, const std::vector<std::pair<LogLevel, std::string>>& lines) {
+    for (const auto& [level, text] : lines) {
+        const size_t offset = batch.text.size();
+        batch.text += text + "\n";
+        batch.lines.push_back(FormattedLine{static_cast<uint32_t>(offset),
+                                            static_cast<uint32_t>(text.size() + 1), level});
+    }
+}
+
+/// Sink that records every line and can be held inside write()
+class GatedSink : public LogSink {
+public:
+    std::atomic<bool> open{true};
+
+    void write(const SinkBatch& batch) override {
+        while (!open.load()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+        forEachLine(batch, [&](std::string_view line, LogLevel) { lines_.emplace_back(line); });
+    }
+
+    std::vector<std::string> lines() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return lines_;
+    }
+
+private:
+    std::mutex mutex_;
+    std::vector<std::string> lines_;
+};
+
+}  // namespace
+
+TEST(LogSinkTest, Level_FiltersLinesAndRuns) {
+    SinkBatch batch;
+    addLines(batch, {{LogLevel::kLogLevelDebug, "d1"},
+                     {LogLevel::kLogLevelError, "e1"},
+                     {LogLevel::kLogLevelWarning, "w1"},
+                     {LogLevel::kLogLevelInfo, "i1"},
+                     {LogLevel::kLogLevelError, "e2"}});
+
+    MemoryRingSink ring(1024, LogLevel::kLogLevelWarning);
+    ring.write(batch);
+    EXPECT_EQ(ring.getLines(), (std::vector<std::string>{"e1\n", "w1\n", "e2\n"}));
+
+    std::vector<std::string> levels;
+    CallbackSink callback([&](LogLevel level, std::string_view line) {
+        levels.push_back(std::string(levelToString(level)) + ":" + std::string(line));
+    }, LogLevel::kLogLevelInfo);
+    callback.write(batch);
+    EXPECT_EQ(levels, (std::vector<std::string>{"ERROR:e1\n", "WARNING:w1\n", "INFO:i1\n", "ERROR:e2\n"}));
+
+    callback.setLevel(LogLevel::kLogLevelError);
+    levels.clear();
+    callback.write(batch);
+    EXPECT_EQ(levels.size(), 2u);
+}
+
+TEST(LogSinkTest, MemoryRing_KeepsNewestWithinBudget) {
+    MemoryRingSink ring(10);
+    SinkBatch batch;
+    addLines(batch, {{LogLevel::kLogLevelInfo, "aaa"},
+                     {LogLevel::kLogLevelInfo, "bbb"},
+                     {LogLevel::kLogLevelInfo, "ccc"},
+                     {LogLevel::kLogLevelInfo, "far too long for the ring"}});
+    ring.write(batch);
+    EXPECT_EQ(ring.getLines(), (std::vector<std::string>{"bbb\n", "ccc\n"}));
+    EXPECT_EQ(ring.getSizeBytes(), 8u);
+}
+
+TEST(SinkFanoutTest, EverySinkSeesEveryBatchInOrder) {
+    auto all = std::make_shared<MemoryRingSink>(1 << 20);
+    auto errors = std::make_shared<MemoryRingSink>(1 << 20, LogLevel::kLogLevelError);
+    SinkFanout fanout;
+    EXPECT_FALSE(fanout.hasSinks());
+    fanout.addSink(all);
+    fanout.addSink(errors);
+    EXPECT_TRUE(fanout.hasSinks());
+
+    for (int i = 0; i < 200; ++i) {
+        auto batch = fanout.acquireBatch();
+        addLines(*batch, {{i % 10 == 0 ? LogLevel::kLogLevelError : LogLevel::kLogLevelInfo,
+                           std::to_string(i)}});
+        fanout.publish(std::move(batch));
+        if (i % 16 == 0) {
+            fanout.waitIdle();  // Stay within the ring
+        }
+    }
+    fanout.waitIdle();
+
+    const auto lines = all->getLines();
+    ASSERT_EQ(lines.size(), 200u);
+    for (int i = 0; i < 200; ++i) {
+        EXPECT_EQ(lines[i], std::to_string(i) + "\n");
+    }
+    EXPECT_EQ(errors->getLines().size(), 20u);
+    for (const SinkStats& stats : fanout.getStats()) {
+        EXPECT_EQ(stats.batches_written, 200u);
+        EXPECT_EQ(stats.batches_skipped, 0u);
+    }
+}
+
+TEST(SinkFanoutTest, SlowSink_SkipsWithoutHoldingUpOthers) {
+    auto slow = std::make_shared<GatedSink>();
+    auto fast = std::make_shared<GatedSink>();
+    SinkFanout fanout;
+    fanout.addSink(slow);
+    fanout.addSink(fast);
+    slow->open = false;
+
+    constexpr int kBatches = static_cast<int>(SinkFanout::kRingBatches) * 3;
+    for (int i = 0; i < kBatches; ++i) {
+        auto batch = fanout.acquireBatch();
+        addLines(*batch, {{LogLevel::kLogLevelInfo, std::to_string(i)}});
+        fanout.publish(std::move(batch));
+
+        // The fast sink keeps up while the slow one is stuck
+        while (fast->lines().size() < static_cast<size_t>(i + 1)) {
+            std::this_thread::yield();
+        }
+    }
+
+    slow->open = true;
+    fanout.waitIdle();
+
+    const std::vector<SinkStats> stats = fanout.getStats();
+    EXPECT_EQ(stats[1].batches_written, static_cast<uint64_t>(kBatches));
+    EXPECT_EQ(stats[1].batches_skipped, 0u);
+    EXPECT_GT(stats[0].batches_skipped, 0u);
+    EXPECT_EQ(stats[0].batches_written + stats[0].batches_skipped, static_cast<uint64_t>(kBatches));
+
+    // The slow sink resumed with the oldest batch still held and ended with the newest
+    const auto slow_lines = slow->lines();
+    ASSERT_FALSE(slow_lines.empty());
+    EXPECT_EQ(slow_lines.back(), std::to_string(kBatches - 1) + "\n");
+}
+
+TEST(SinkFanoutTest, StuckSink_BoundsWaitsAndShutdown) {
+    auto stuck = std::make_shared<GatedSink>();
+    auto healthy = std::make_shared<GatedSink>();
+    const uint64_t abandoned_before = SinkFanout::getAbandonedSinks();
+    auto fanout = std::make_unique<SinkFanout>(std::chrono::milliseconds(100));
+    fanout->addSink(stuck);
+    fanout->addSink(healthy);
+    stuck->open = false;
+
+    auto batch = fanout->acquireBatch();
+    addLines(*batch, {{LogLevel::kLogLevelInfo, "held up"}});
+    fanout->publish(std::move(batch));
+
+    EXPECT_FALSE(fanout->waitIdle(std::chrono::milliseconds(50)));
+    const std::vector<SinkStats> stats = fanout->getStats();
+    EXPECT_EQ(stats[0].wait_timeouts, 1u);
+    EXPECT_EQ(stats[1].wait_timeouts, 0u);
+    EXPECT_EQ(healthy->lines().size(), 1u);
+
+    // Destruction gives up on the stuck sink after the stop timeout
+    const auto start = std::chrono::steady_clock::now();
+    fanout.reset();
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(2));
+    EXPECT_EQ(SinkFanout::getAbandonedSinks(), abandoned_before + 1);
+
+    // The abandoned thread still finishes its write safely
+    stuck->open = true;
+    for (int i = 0; i < 1000 && stuck->lines().empty(); ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    EXPECT_EQ(stuck->lines(), std::vector<std::string>{"held up\n"});
+}
+
+TEST(SinkFanoutTest, ReleasedBatches_AreReused) {
+    auto sink = std::make_shared<MemoryRingSink>(1024);
+    SinkFanout fanout;
+    fanout.addSink(sink);
+    for (int i = 0; i < 1000; ++i) {
+        auto batch = fanout.acquireBatch();
+        EXPECT_TRUE(batch->text.empty());
+        addLines(*batch, {{LogLevel::kLogLevelInfo, "line"}});
+        fanout.publish(std::move(batch));
+        fanout.waitIdle();
+    }
+    // The ring keeps kRingBatches alive; beyond that, every batch is a recycled one
+    EXPECT_LE(fanout.getBatchesAllocated(), SinkFanout::kRingBatches + 1);
+}
+
+class LoggerSinkTest : public ::testing::TestWithParam<size_t> {
+protected:
+    std::filesystem::path dir_;
+
+    void SetUp() override {
+        dir_ = std::filesystem::current_path() / "logger_sink_test";
+        std::filesystem::remove_all(dir_);
+        std::filesystem::create_directories(dir_);
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(dir_);
+    }
+};
+
+TEST_P(LoggerSinkTest, FileAndSinksShareFormattedLines) {
+    auto logger = AsyncLogger::create((dir_ / "main").string(), 4096, GetParam());
+    ASSERT_NE(logger, nullptr);
+    auto ring = std::make_shared<MemoryRingSink>(1 << 20);
+    auto errors = FileSink::create((dir_ / "errors").string(), LogLevel::kLogLevelError);
+    ASSERT_NE(errors, nullptr);
+    logger->addSink(ring);
+    logger->addSink(errors);
+
+    for (int i = 0; i < 100; ++i) {
+        logger->log(i % 25 == 0 ? LogLevel::kLogLevelError : LogLevel::kLogLevelInfo, "Sink",
+                    "message " + std::to_string(i));
+    }
+    logger->flush();
+
+    // The ring sink gets exactly the file's lines
+    std::vector<std::string> file_lines;
+    std::ifstream file(logger->getLogFileName());
+    for (std::string line; std::getline(file, line);) {
+        file_lines.push_back(line + "\n");
+    }
+    EXPECT_EQ(ring->getLines(), file_lines);
+    EXPECT_EQ(file_lines.size(), 100u);
+
+    logger->deinitialize();
+    std::vector<std::string> error_lines;
+    std::ifstream error_file(errors->getLogFileName());
+    for (std::string line; std::getline(error_file, line);) {
+        error_lines.push_back(line);
+    }
+    ASSERT_EQ(error_lines.size(), 4u);
+    EXPECT_NE(error_lines[3].find("[ERROR]"), std::string::npos);
+    EXPECT_NE(error_lines[3].find("message 75"), std::string::npos);
+}
+
+INSTANTIATE_TEST_SUITE_P(FormatterThreads, LoggerSinkTest, ::testing::Values(0, 2));
+
+TEST(LoggerSinkBinaryTest, BinaryFile_SinksStillGetText) {
+    const auto dir = std::filesystem::current_path() / "logger_sink_binary_test";
+    std::filesystem::remove_all(dir);
+    {
+        auto logger = AsyncLogger::create((dir / "main").string());
+        ASSERT_NE(logger, nullptr);
+        ASSERT_TRUE(logger->setOutputFormat(LogFileFormat::kBinary));
+        auto ring = std::make_shared<MemoryRingSink>(1 << 20);
+        logger->addSink(ring);
+        logger->log(LogLevel::kLogLevelWarning, "Sink", "binary file, text sink");
+        logger->flush();
+        const auto lines = ring->getLines();
+        ASSERT_EQ(lines.size(), 1u);
+        EXPECT_NE(lines[0].find("[Sink]: binary file, text sink"), std::string::npos) << lines[0];
+    }
+    std::filesystem::remove_all(dir);
+}
+
+#ifndef SPECKIT_PLATFORM_WINDOWS
+TEST(UnixDatagramSinkTest, SendsOneDatagramPerLine) {
+    const std::string path = "/tmp/speckit_sink_test_" + std::to_string(getpid()) + ".sock";
+    ::unlink(path.c_str());
+    const int receiver = ::socket(AF_UNIX, SOCK_DGRAM, 0);
+    ASSERT_GE(receiver, 0);
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    std::strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+
+    auto sink = UnixDatagramSink::create(path, LogLevel::kLogLevelInfo);
+    ASSERT_NE(sink, nullptr);
+    SinkBatch batch;
+    addLines(batch, {{LogLevel::kLogLevelInfo, "before bind"}});
+    sink->write(batch);
+    EXPECT_EQ(sink->getSendFailures(), 1u);  // Nobody listening yet
+
+    ASSERT_EQ(::bind(receiver, reinterpret_cast<const sockaddr*>(&address), sizeof(address)), 0);
+    batch = SinkBatch();
+    addLines(batch, {{LogLevel::kLogLevelInfo, "first"},
+                     {LogLevel::kLogLevelDebug, "filtered"},
+                     {LogLevel::kLogLevelError, "second"}});
+    sink->write(batch);
+
+    char buffer[256];
+    ssize_t received = ::recv(receiver, buffer, sizeof(buffer), 0);
+    EXPECT_EQ(std::string(buffer, received > 0 ? received : 0), "first\n");
+    received = ::recv(receiver, buffer, sizeof(buffer), 0);
+    EXPECT_EQ(std::string(buffer, received > 0 ? received : 0), "second\n");
+    EXPECT_EQ(sink->getSendFailures(), 1u);
+
+    ::close(receiver);
+    ::unlink(path.c_str());
+}
+#endif
@@ -0,0 +1,348 @@
+// Unit tests for SocketSink against a local stand-in for the log shipper
+
+#include <gtest/gtest.h>
+#include "speckit/log/async_logger.h"
+#include "speckit/log/socket_sink.h"
+#include "speckit/log/platform.h"
+
+#ifndef SPECKIT_PLATFORM_WINDOWS
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+/// Accepts one connection at a time and decodes SocketSink frames
+/// An incomplete frame at the end of a connection is discarded, as a shipper would.
+class FrameReceiver {
+public:
+    static std::unique_ptr<FrameReceiver> listenUnix(const std::string& path) {
+        ::unlink(path.c_str());
+        const int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        sockaddr_un address{};
+        address.sun_family = AF_UNIX;
+        std::strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+        if (fd < 0 || ::bind(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0 ||
+            ::listen(fd, 4) != 0) {
+            return nullptr;
+        }
+        return std::unique_ptr<FrameReceiver>(new FrameReceiver(fd));
+    }
+
+    /// Listens on 127.0.0.1 with a port chosen by the system
+    static std::unique_ptr<FrameReceiver> listenTcp(uint16_t& port) {
+        const int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        socklen_t length = sizeof(address);
+        if (fd < 0 || ::bind(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0 ||
+            ::listen(fd, 4) != 0 || ::getsockname(fd, reinterpret_cast<sockaddr*>(&address), &length) != 0) {
+            return nullptr;
+        }
+        port = ntohs(address.sin_port);
+        return std::unique_ptr<FrameReceiver>(new FrameReceiver(fd));
+    }
+
+    ~FrameReceiver() {
+        stop_ = true;
+        thread_.join();
+        ::close(listen_fd_);
+    }
+
+    std::vector<std::string> records() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return records_;
+    }
+
+    size_t frames() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return frames_;
+    }
+
+    bool waitForRecords(size_t count) {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (records().size() < count) {
+            if (std::chrono::steady_clock::now() > deadline) {
+                return false;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return true;
+    }
+
+private:
+    explicit FrameReceiver(int listen_fd) : listen_fd_(listen_fd), thread_([this]() { run(); }) {}
+
+    /// Wait until @p fd is readable; false once stopping
+    bool waitReadable(int fd) {
+        pollfd entry{fd, POLLIN, 0};
+        while (!stop_) {
+            if (::poll(&entry, 1, 10) > 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool readFull(int fd, void* data, size_t size) {
+        char* out = static_cast<char*>(data);
+        while (size > 0) {
+            if (!waitReadable(fd)) {
+                return false;
+            }
+            const ssize_t received = ::recv(fd, out, size, 0);
+            if (received <= 0) {
+                return false;
+            }
+            out += received;
+            size -= static_cast<size_t>(received);
+        }
+        return true;
+    }
+
+    void run() {
+        while (waitReadable(listen_fd_)) {
+            const int fd = ::accept(listen_fd_, nullptr, nullptr);
+            if (fd < 0) {
+                continue;
+            }
+            std::vector<char> frame;
+            uint32_t frame_bytes = 0;
+            while (readFull(fd, &frame_bytes, sizeof(frame_bytes))) {
+                frame.resize(ntohl(frame_bytes));
+                if (!readFull(fd, frame.data(), frame.size())) {
+                    break;
+                }
+                decode(frame);
+            }
+            ::close(fd);
+        }
+    }
+
+    void decode(const std::vector<char>& frame) {
+        uint32_t count = 0;
+        std::memcpy(&count, frame.data(), sizeof(count));
+        size_t offset = sizeof(count);
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (uint32_t i = 0; i < ntohl(count); ++i) {
+            uint32_t size = 0;
+            std::memcpy(&size, frame.data() + offset, sizeof(size));
+            offset += sizeof(size);
+            records_.emplace_back(frame.data() + offset, ntohl(size));
+            offset += ntohl(size);
+        }
+        EXPECT_EQ(offset, frame.size());
+        ++frames_;
+    }
+
+    int listen_fd_;
+    std::atomic<bool> stop_{false};
+    std::mutex mutex_;
+    std::vector<std::string> records_;
+    size_t frames_ = 0;
+    std::thread thread_;
+};
+
+SinkBatch makeBatch(int from, int to, LogLevel level = LogLevel::kLogLevelInfo) {
+    SinkBatch batch;
+    for (int i = from; i < to; ++i) {
+        const size_t offset = batch.text.size();
+        batch.text += "line " + std::to_string(i) + "\n";
+        batch.lines.push_back(FormattedLine{static_cast<uint32_t>(offset),
+                                            static_cast<uint32_t>(batch.text.size() - offset), level});
+    }
+    return batch;
+}
+
+std::vector<std::string> expectedRecords(int from, int to) {
+    std::vector<std::string> records;
+    for (int i = from; i < to; ++i) {
+        records.push_back("line " + std::to_string(i));
+    }
+    return records;
+}
+
+}  // namespace
+
+class SocketSinkTest : public ::testing::Test {
+protected:
+    std::filesystem::path dir_;
+    std::string socket_path_;
+    SocketSinkOptions options_;
+
+    void SetUp() override {
+        // Short: sun_path is limited to about 100 bytes
+        dir_ = std::filesystem::path("/tmp") / ("speckit_socket_sink_" + std::to_string(getpid()));
+        std::filesystem::remove_all(dir_);
+        std::filesystem::create_directories(dir_);
+        socket_path_ = (dir_ / "shipper.sock").string();
+        options_.initial_backoff = std::chrono::milliseconds(20);
+        options_.max_backoff = std::chrono::milliseconds(80);
+        options_.spill_path = (dir_ / "spill.bin").string();
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(dir_);
+    }
+};
+
+TEST_F(SocketSinkTest, UnixSocket_SendsLinesAsOneFrame) {
+    auto receiver = FrameReceiver::listenUnix(socket_path_);
+    ASSERT_NE(receiver, nullptr);
+    auto sink = SocketSink::createUnix(socket_path_, options_, LogLevel::kLogLevelInfo);
+    ASSERT_NE(sink, nullptr);
+
+    SinkBatch batch = makeBatch(0, 3);
+    batch.lines[1].level = LogLevel::kLogLevelDebug;  // Below the sink's level
+    sink->write(batch);
+
+    ASSERT_TRUE(receiver->waitForRecords(2));
+    EXPECT_EQ(receiver->records(), (std::vector<std::string>{"line 0", "line 2"}));
+    EXPECT_EQ(receiver->frames(), 1u);
+    const SocketSinkStats stats = sink->getStats();
+    EXPECT_EQ(stats.frames_sent, 1u);
+    EXPECT_EQ(stats.records_sent, 2u);
+    EXPECT_EQ(stats.connects, 1u);
+}
+
+TEST_F(SocketSinkTest, LargeBatch_SplitsIntoFrames) {
+    auto receiver = FrameReceiver::listenUnix(socket_path_);
+    ASSERT_NE(receiver, nullptr);
+    auto sink = SocketSink::createUnix(socket_path_, options_);
+    ASSERT_NE(sink, nullptr);
+
+    constexpr int kLines = static_cast<int>(SocketSink::kMaxFrameRecords) * 2 + 88;
+    sink->write(makeBatch(0, kLines));
+
+    ASSERT_TRUE(receiver->waitForRecords(kLines));
+    EXPECT_EQ(receiver->records(), expectedRecords(0, kLines));
+    EXPECT_EQ(receiver->frames(), 3u);
+}
+
+TEST_F(SocketSinkTest, Tcp_Localhost) {
+    uint16_t port = 0;
+    auto receiver = FrameReceiver::listenTcp(port);
+    ASSERT_NE(receiver, nullptr);
+    EXPECT_EQ(SocketSink::createTcp("localhost", port, options_), nullptr);  // Numeric only
+    auto sink = SocketSink::createTcp("127.0.0.1", port, options_);
+    ASSERT_NE(sink, nullptr);
+
+    sink->write(makeBatch(0, 10));
+    ASSERT_TRUE(receiver->waitForRecords(10));
+    EXPECT_EQ(receiver->records(), expectedRecords(0, 10));
+}
+
+TEST_F(SocketSinkTest, PeerDown_SpillsThenReplaysInOrder) {
+    auto sink = SocketSink::createUnix(socket_path_, options_);
+    ASSERT_NE(sink, nullptr);
+
+    for (int i = 0; i < 5; ++i) {
+        sink->write(makeBatch(i * 10, i * 10 + 10));
+    }
+    SocketSinkStats stats = sink->getStats();
+    EXPECT_EQ(stats.frames_spilled, 5u);
+    EXPECT_EQ(stats.connect_failures, 1u);  // The rest fell within the backoff
+    EXPECT_GT(std::filesystem::file_size(options_.spill_path), 0u);
+
+    auto receiver = FrameReceiver::listenUnix(socket_path_);
+    ASSERT_NE(receiver, nullptr);
+    std::this_thread::sleep_for(options_.initial_backoff * 2);
+    sink->write(makeBatch(50, 60));
+
+    ASSERT_TRUE(receiver->waitForRecords(60));
+    EXPECT_EQ(receiver->records(), expectedRecords(0, 60));
+    stats = sink->getStats();
+    EXPECT_EQ(stats.frames_sent, 6u);
+    EXPECT_EQ(stats.frames_dropped, 0u);
+    EXPECT_EQ(std::filesystem::file_size(options_.spill_path), 0u);
+}
+
+TEST_F(SocketSinkTest, PeerRestart_Reconnects) {
+    auto receiver = FrameReceiver::listenUnix(socket_path_);
+    ASSERT_NE(receiver, nullptr);
+    auto sink = SocketSink::createUnix(socket_path_, options_);
+    ASSERT_NE(sink, nullptr);
+    sink->write(makeBatch(0, 10));
+    ASSERT_TRUE(receiver->waitForRecords(10));
+    receiver.reset();
+
+    // The send fails on the closed connection and the frame is kept
+    sink->write(makeBatch(10, 20));
+    EXPECT_EQ(sink->getStats().frames_spilled, 1u);
+
+    receiver = FrameReceiver::listenUnix(socket_path_);
+    ASSERT_NE(receiver, nullptr);
+    std::this_thread::sleep_for(options_.initial_backoff * 2);
+    sink->write(makeBatch(20, 30));
+    ASSERT_TRUE(receiver->waitForRecords(20));
+    EXPECT_EQ(receiver->records(), expectedRecords(10, 30));
+    EXPECT_EQ(sink->getStats().connects, 2u);
+}
+
+TEST_F(SocketSinkTest, Backoff_LimitsConnectAttempts) {
+    auto sink = SocketSink::createUnix(socket_path_, options_);
+    ASSERT_NE(sink, nullptr);
+
+    // 20, 40, 80, 80... ms between attempts over about 300 ms
+    const auto end = std::chrono::steady_clock::now() + std::chrono::milliseconds(300);
+    while (std::chrono::steady_clock::now() < end) {
+        sink->write(makeBatch(0, 1));
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+    const SocketSinkStats stats = sink->getStats();
+    EXPECT_GE(stats.connect_failures, 3u);
+    EXPECT_LE(stats.connect_failures, 8u);
+    EXPECT_EQ(stats.connects, 0u);
+}
+
+TEST_F(SocketSinkTest, SpillLimit_DropsFrames) {
+    options_.max_spill_bytes = 60;  // Room for two of the 28-byte frames below
+    auto sink = SocketSink::createUnix(socket_path_, options_);
+    ASSERT_NE(sink, nullptr);
+    for (int i = 0; i < 5; ++i) {
+        sink->write(makeBatch(i * 2, i * 2 + 2));
+    }
+    SocketSinkStats stats = sink->getStats();
+    EXPECT_EQ(stats.frames_spilled, 2u);
+    EXPECT_EQ(stats.frames_dropped, 3u);
+
+    options_.spill_path.clear();
+    auto unspilled = SocketSink::createUnix(socket_path_, options_);
+    ASSERT_NE(unspilled, nullptr);
+    unspilled->write(makeBatch(0, 2));
+    EXPECT_EQ(unspilled->getStats().frames_dropped, 1u);
+}
+
+TEST_F(SocketSinkTest, AsyncLogger_ShipsThroughSink) {
+    auto receiver = FrameReceiver::listenUnix(socket_path_);
+    ASSERT_NE(receiver, nullptr);
+    auto logger = AsyncLogger::create((dir_ / "app").string());
+    ASSERT_NE(logger, nullptr);
+    logger->addSink(SocketSink::createUnix(socket_path_, options_, LogLevel::kLogLevelWarning));
+
+    logger->log(LogLevel::kLogLevelInfo, "Ship", "local only");
+    logger->log(LogLevel::kLogLevelError, "Ship", "shipped");
+    logger->flush();
+
+    ASSERT_TRUE(receiver->waitForRecords(1));
+    const auto records = receiver->records();
+    ASSERT_EQ(records.size(), 1u);
+    EXPECT_EQ(records[0].rfind("[ERROR]", 0), 0u) << records[0];
+    EXPECT_NE(records[0].find("[Ship]: shipped"), std::string::npos) << records[0];
+}
+
+#endif
@@ -0,0 +1,124 @@
+// Unit tests for per-tag sampling
+
+#include <gtest/gtest.h>
+#include "speckit/log/tag_filter.h"
+#include "speckit/log/async_logger.h"
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+using speckit::log::TagFilter;
+
+TEST(TagSamplingTest, KeepsOneInN_BelowWarning) {
+    TagFilter filter;
+    EXPECT_EQ(filter.getTagSampleRate("Chatty"), 1u);
+    filter.setTagSampleRate("Chatty", 10);
+    EXPECT_EQ(filter.getTagSampleRate("Chatty"), 10u);
+
+    constexpr int kCalls = 100000;
+    int debug_kept = 0;
+    int info_kept = 0;
+    int warning_kept = 0;
+    int other_kept = 0;
+    for (int i = 0; i < kCalls; ++i) {
+        debug_kept += filter.sample("Chatty", LogLevel::kLogLevelDebug);
+        info_kept += filter.sample("Chatty", LogLevel::kLogLevelInfo);
+        warning_kept += filter.sample("Chatty", LogLevel::kLogLevelWarning);
+        other_kept += filter.sample("Quiet", LogLevel::kLogLevelDebug);
+    }
+
+    // 10000 expected, standard deviation about 95
+    EXPECT_NEAR(debug_kept, kCalls / 10, 600);
+    EXPECT_NEAR(info_kept, kCalls / 10, 600);
+    EXPECT_EQ(warning_kept, kCalls);
+    EXPECT_EQ(other_kept, kCalls);
+
+    // Rate changes are picked up by the per-thread cache
+    filter.setTagSampleRate("Chatty", 1);
+    for (int i = 0; i < 1000; ++i) {
+        ASSERT_TRUE(filter.sample("Chatty", LogLevel::kLogLevelDebug));
+    }
+}
+
+TEST(TagSamplingTest, FilterRebuiltAtSameAddress_UsesItsOwnRate) {
+    // Same address and same number of setter calls for both filters
+    std::optional<TagFilter> filter;
+    filter.emplace();
+    filter->setTagSampleRate("Chatty", 1000000);
+    int kept = 0;
+    for (int i = 0; i < 100; ++i) {
+        kept += filter->sample("Chatty", LogLevel::kLogLevelDebug);
+    }
+    EXPECT_LT(kept, 100);
+
+    filter.reset();
+    filter.emplace();
+    filter->setTagSampleRate("Chatty", 1);
+    for (int i = 0; i < 1000; ++i) {
+        ASSERT_TRUE(filter->sample("Chatty", LogLevel::kLogLevelDebug));
+    }
+}
+
+TEST(TagSamplingTest, ThreadsSampleIndependently) {
+    TagFilter filter;
+    filter.setTagSampleRate("Chatty", 4);
+
+    constexpr int kThreads = 4;
+    constexpr int kCalls = 40000;
+    std::atomic<int> kept{0};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([&]() {
+            int local = 0;
+            for (int i = 0; i < kCalls; ++i) {
+                local += filter.sample("Chatty", LogLevel::kLogLevelInfo);
+            }
+            kept.fetch_add(local);
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    EXPECT_NEAR(kept.load(), kThreads * kCalls / 4, 1500);
+}
+
+TEST(TagSamplingTest, Logger_CountsSampledOutLines) {
+    const auto dir = std::filesystem::current_path() / "tag_sampling_test";
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+
+    TagFilter filter;
+    filter.setTagSampleRate("Chatty", 100);
+    auto logger = AsyncLogger::create((dir / "sampled").string(), 1 << 16);
+    ASSERT_NE(logger, nullptr);
+    logger->setTagFilter(&filter);
+
+    for (int i = 0; i < 20000; ++i) {
+        logger->log(LogLevel::kLogLevelDebug, "Chatty", "noise");
+    }
+    logger->log(LogLevel::kLogLevelError, "Chatty", "important");
+
+    const std::string file_name = logger->getLogFileName();
+    logger->deinitialize();
+    const MetricsSnapshot snapshot = logger->getMetrics();
+    EXPECT_EQ(snapshot.entries_sampled_out + snapshot.entries_written, 20001u);
+    EXPECT_EQ(snapshot.entries_dropped, 0u);
+
+    size_t lines = 0;
+    bool important = false;
+    std::ifstream file(file_name);
+    for (std::string line; std::getline(file, line);) {
+        ++lines;
+        important |= line.find("important") != std::string::npos;
+    }
+    EXPECT_EQ(lines, snapshot.entries_written);
+    EXPECT_NEAR(static_cast<double>(lines), 201.0, 75.0);
+    EXPECT_TRUE(important);
+
+    logger.reset();
+    std::filesystem::remove_all(dir);
+}
@@ -0,0 +1,201 @@
+// Unit tests for TunedAsyncQueue
+
+#include <gtest/gtest.h>
+#include "speckit/log/tuned_async_queue.h"
+#include "speckit/log/log_level.h"
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+class TunedAsyncQueueTest : public ::testing::Test {
+protected:
+    static LogEntry createTestEntry(const std::string& tag, const std::string& message) {
+        return LogEntry::createOwned(LogLevel::kLogLevelInfo, 12345, 1234, ThreadIdType{}, tag, message);
+    }
+};
+
+TEST_F(TunedAsyncQueueTest, Capacity_RoundedUpToPowerOfTwo) {
+    EXPECT_EQ(TunedAsyncQueue(1).capacity(), 1u);
+    EXPECT_EQ(TunedAsyncQueue(1000).capacity(), 1024u);
+    EXPECT_EQ(TunedAsyncQueue(1024).capacity(), 1024u);
+    EXPECT_EQ(TunedAsyncQueue(1025).capacity(), 2048u);
+
+    TunedAsyncQueue queue(1000);
+    EXPECT_TRUE(queue.isEmpty());
+    EXPECT_EQ(queue.size(), 0u);
+}
+
+TEST_F(TunedAsyncQueueTest, TryPush_UntilFull) {
+    TunedAsyncQueue queue(16);
+
+    for (size_t i = 0; i < queue.capacity(); ++i) {
+        EXPECT_TRUE(queue.tryPush(createTestEntry("Test", std::to_string(i)))) << "Push failed at index " << i;
+    }
+    EXPECT_EQ(queue.size(), queue.capacity());
+
+    // A rejected entry is left intact for the caller's fallback path
+    auto extra = createTestEntry("Test", "Extra");
+    EXPECT_FALSE(queue.tryPush(extra));
+    EXPECT_EQ(extra.message, "Extra");
+    EXPECT_EQ(queue.size(), queue.capacity());
+}
+
+TEST_F(TunedAsyncQueueTest, TryPush_RacingForLastSlot_NeverWaits) {
+    // No consumer runs; producers that lose the last slot must fail, not wait for one
+    TunedAsyncQueue queue(16);
+    for (size_t i = 0; i + 1 < queue.capacity(); ++i) {
+        ASSERT_TRUE(queue.tryPush(createTestEntry("Test", std::to_string(i))));
+    }
+
+    constexpr int kThreads = 8;
+    std::atomic<int> pushed{0};
+    std::vector<std::thread> producers;
+    for (int t = 0; t < kThreads; ++t) {
+        producers.emplace_back([&queue, &pushed, t]() {
+            if (queue.tryPush(createTestEntry("Race", std::to_string(t)))) {
+                pushed.fetch_add(1);
+            }
+        });
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+
+    EXPECT_EQ(pushed.load(), 1);
+    EXPECT_EQ(queue.size(), queue.capacity());
+    EXPECT_EQ(queue.popAll().size(), queue.capacity());
+}
+
+TEST_F(TunedAsyncQueueTest, PopAll_PreservesOrderAcrossLaps) {
+    TunedAsyncQueue queue(8);
+
+    // Several laps around the ring with partial batches
+    int next_push = 0;
+    int next_pop = 0;
+    for (int round = 0; round < 10; ++round) {
+        for (int i = 0; i < 5; ++i) {
+            ASSERT_TRUE(queue.tryPush(createTestEntry("Test", std::to_string(next_push++))));
+        }
+        auto entries = queue.popAll();
+        ASSERT_EQ(entries.size(), 5u);
+        for (const auto& entry : entries) {
+            EXPECT_EQ(entry.message, std::to_string(next_pop++));
+        }
+        EXPECT_TRUE(queue.isEmpty());
+    }
+}
+
+TEST_F(TunedAsyncQueueTest, DrainAndDrainInto_RespectMaxAcrossLaps) {
+    TunedAsyncQueue queue(8);
+    std::vector<LogEntry> buffer(3);
+
+    int next_push = 0;
+    int next_pop = 0;
+    for (int round = 0; round < 6; ++round) {
+        for (int i = 0; i < 7; ++i) {
+            ASSERT_TRUE(queue.tryPush(createTestEntry("Test", std::to_string(next_push++))));
+        }
+
+        // In place, capped at 4
+        EXPECT_EQ(queue.drain([&](LogEntry& entry) { EXPECT_EQ(entry.message, std::to_string(next_pop++)); }, 4), 4u);
+
+        // The rest into the reusable buffer
+        ASSERT_EQ(queue.drainInto(buffer), 3u);
+        for (const auto& entry : buffer) {
+            EXPECT_EQ(entry.message, std::to_string(next_pop++));
+        }
+        EXPECT_EQ(queue.drainInto(buffer), 0u);
+        EXPECT_TRUE(queue.isEmpty());
+    }
+}
+
+TEST_F(TunedAsyncQueueTest, ConcurrentProducers_NothingLostOrDuplicated) {
+    TunedAsyncQueue queue(64);  // Small so producers keep hitting the full path
+    constexpr int kThreads = 8;
+    constexpr int kPerThread = 5000;
+
+    std::atomic<int> running{kThreads};
+    std::vector<std::thread> producers;
+    for (int t = 0; t < kThreads; ++t) {
+        producers.emplace_back([&queue, &running, t]() {
+            for (int i = 0; i < kPerThread; ++i) {
+                auto entry = createTestEntry(std::to_string(t), std::to_string(i));
+                while (!queue.tryPush(entry)) {
+                    std::this_thread::yield();
+                }
+            }
+            running.fetch_sub(1);
+        });
+    }
+
+    // Per-producer order must be preserved
+    std::vector<int> next(kThreads, 0);
+    int received = 0;
+    while (running.load() > 0 || !queue.isEmpty()) {
+        for (const auto& entry : queue.popAll()) {
+            int t = std::stoi(std::string(entry.tag));
+            ASSERT_EQ(std::stoi(std::string(entry.message)), next[t]) << "producer " << t;
+            ++next[t];
+            ++received;
+        }
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+
+    EXPECT_EQ(received, kThreads * kPerThread);
+    EXPECT_TRUE(queue.isEmpty());
+}
+
+TEST_F(TunedAsyncQueueTest, TryPopOldest_ConcurrentWithConsumer) {
+    TunedAsyncQueue queue(4);
+    LogEntry evicted;
+    EXPECT_FALSE(queue.tryPopOldest(evicted));
+    for (int i = 0; i < 3; ++i) {
+        ASSERT_TRUE(queue.tryPush(createTestEntry("T", std::to_string(i))));
+    }
+    ASSERT_TRUE(queue.tryPopOldest(evicted));
+    EXPECT_EQ(evicted.message, "0");
+    auto rest = queue.popAll();
+    ASSERT_EQ(rest.size(), 2u);
+    EXPECT_EQ(rest[0].message, "1");
+
+    // Evicting producers and the consumer each get every entry at most once, in order
+    TunedAsyncQueue small(64);
+    constexpr int kThreads = 4;
+    constexpr int kPerThread = 5000;
+    std::atomic<int> running{kThreads};
+    std::atomic<int> evictions{0};
+    std::vector<std::thread> producers;
+    for (int t = 0; t < kThreads; ++t) {
+        producers.emplace_back([&, t]() {
+            LogEntry oldest;
+            for (int i = 0; i < kPerThread; ++i) {
+                auto entry = createTestEntry(std::to_string(t), std::to_string(i));
+                while (!small.tryPush(entry)) {
+                    if (small.tryPopOldest(oldest)) {
+                        evictions.fetch_add(1);
+                    }
+                }
+            }
+            running.fetch_sub(1);
+        });
+    }
+
+    std::vector<int> next(kThreads, 0);
+    int received = 0;
+    while (running.load() > 0 || !small.isEmpty()) {
+        for (const auto& entry : small.popAll()) {
+            const int t = std::stoi(std::string(entry.tag));
+            const int i = std::stoi(std::string(entry.message));
+            ASSERT_GE(i, next[t]) << "producer " << t;
+            next[t] = i + 1;
+            ++received;
+        }
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+    EXPECT_EQ(received + evictions.load(), kThreads * kPerThread);
+}
@@ -0,0 +1,128 @@
+// Unit tests for writer wait strategies and WriterWakeup
+
+#include <gtest/gtest.h>
+#include "speckit/log/wait_strategy.h"
+#include "speckit/log/async_logger.h"
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <string>
+#include <thread>
+
+namespace {
+
+const WaitStrategy kAllStrategies[] = {
+    WaitStrategy::kBusySpin,
+    WaitStrategy::kSpinYield,
+    WaitStrategy::kSpinPark,
+    WaitStrategy::kTimedPark,
+};
+
+}  // namespace
+
+TEST(WriterWakeupTest, PingPong_NoLostWakeups) {
+    constexpr uint64_t kRounds = 200;
+
+    for (WaitStrategy strategy : kAllStrategies) {
+        WriterWakeup wakeup;
+        std::atomic<uint64_t> published{0};
+        std::atomic<uint64_t> consumed{0};
+
+        // Consumer waits for each publication; a lost wakeup would hang it
+        auto consumer = std::async(std::launch::async, [&]() {
+            for (uint64_t seen = 0; seen < kRounds; ++seen) {
+                wakeup.wait(strategy, [&]() { return published.load() > seen; });
+                consumed.store(seen + 1);
+            }
+        });
+
+        for (uint64_t i = 1; i <= kRounds; ++i) {
+            published.store(i);
+            wakeup.notify();
+            while (consumed.load() < i) {
+                std::this_thread::yield();
+            }
+        }
+
+        ASSERT_EQ(consumer.wait_for(std::chrono::seconds(30)), std::future_status::ready)
+            << "strategy " << static_cast<int>(strategy);
+        EXPECT_EQ(consumed.load(), kRounds);
+    }
+}
+
+TEST(WriterWakeupTest, OnlyParkStrategyParks) {
+    for (WaitStrategy strategy : kAllStrategies) {
+        WriterWakeup wakeup;
+        std::atomic<bool> ready{false};
+
+        std::thread consumer([&]() { wakeup.wait(strategy, [&]() { return ready.load(); }); });
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        ready.store(true);
+        wakeup.notify();
+        consumer.join();
+
+        if (strategy == WaitStrategy::kSpinPark) {
+            EXPECT_GE(wakeup.parks(), 1u);
+        } else {
+            EXPECT_EQ(wakeup.parks(), 0u) << "strategy " << static_cast<int>(strategy);
+        }
+    }
+}
+
+class WaitStrategyLoggerTest : public ::testing::TestWithParam<WaitStrategy> {
+protected:
+    std::filesystem::path dir_;
+
+    void SetUp() override {
+        dir_ = std::filesystem::current_path() / "wait_strategy_test";
+        std::filesystem::remove_all(dir_);
+        std::filesystem::create_directories(dir_);
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(dir_);
+    }
+};
+
+TEST_P(WaitStrategyLoggerTest, AllEntriesWritten) {
+    constexpr int kThreads = 4;
+    constexpr int kPerThread = 500;
+
+    auto logger = AsyncLogger::create((dir_ / "wait").string());
+    ASSERT_NE(logger, nullptr);
+    logger->setWaitStrategy(GetParam());
+    EXPECT_EQ(logger->getWaitStrategy(), GetParam());
+
+    std::vector<std::thread> producers;
+    for (int t = 0; t < kThreads; ++t) {
+        producers.emplace_back([&logger]() {
+            for (int i = 0; i < kPerThread; ++i) {
+                logger->log(LogLevel::kLogLevelInfo, "Wait", "entry " + std::to_string(i));
+                if (i % 100 == 0) {
+                    // Give the writer a chance to go idle between bursts
+                    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+                }
+            }
+        });
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+
+    const std::string file_name = logger->getLogFileName();
+    logger->deinitialize();
+    const auto snapshot = logger->getMetrics();
+    EXPECT_EQ(snapshot.entries_dropped, 0u);
+    EXPECT_EQ(snapshot.entries_written, static_cast<uint64_t>(kThreads * kPerThread));
+
+    std::ifstream file(file_name);
+    int lines = 0;
+    for (std::string line; std::getline(file, line);) {
+        ++lines;
+    }
+    EXPECT_EQ(lines, kThreads * kPerThread);
+}
+
+INSTANTIATE_TEST_SUITE_P(Strategies, WaitStrategyLoggerTest, ::testing::ValuesIn(kAllStrategies));